@@ -2,7 +2,7 @@
 
 #include <algorithm>
 
-void active_item_cache::remove( std::list<item>::iterator it, point location )
+void active_item_cache::remove( item_list::iterator it, point location )
 {
     const auto predicate = [&]( const item_reference & active_item ) {
         return location == active_item.location && active_item.item_iterator == it;
@@ -22,13 +22,13 @@ void active_item_cache::remove( std::list<item>::iterator it, point location )
     active_item_set.erase( &*it );
 }
 
-void active_item_cache::add( std::list<item>::iterator it, point location )
+void active_item_cache::add( item_list::iterator it, point location )
 {
     active_items[it->processing_speed()].push_back( item_reference{ location, it, &*it } );
     active_item_set.insert( &*it );
 }
 
-bool active_item_cache::has( std::list<item>::iterator it, point ) const
+bool active_item_cache::has( item_list::iterator it, point ) const
 {
     return active_item_set.count( &*it ) != 0;
 }
@@ -3,6 +3,7 @@
 
 #include "enums.h"
 #include "item.h"
+#include "item_stack.h"
 #include <list>
 #include <unordered_map>
 #include <unordered_set>
@@ -10,7 +11,7 @@
 // A struct used to uniquely identify an item within a submap or vehicle.
 struct item_reference {
     point location;
-    std::list<item>::iterator item_iterator;
+    item_list::iterator item_iterator;
     // Do not access this from outside this module, it is only used as an ID for active_item_set.
     item *item_id;
 };
@@ -23,9 +24,9 @@ class active_item_cache
         std::unordered_set<item *> active_item_set;
 
     public:
-        void remove( std::list<item>::iterator it, point location );
-        void add( std::list<item>::iterator it, point location );
-        bool has( std::list<item>::iterator it, point ) const;
+        void remove( item_list::iterator it, point location );
+        void add( item_list::iterator it, point location );
+        bool has( item_list::iterator it, point ) const;
         // Use this one if there's a chance that the item being referenced has been invalidated.
         bool has( item_reference const &itm ) const;
         bool empty() const;
@@ -31,7 +31,7 @@
 #include <sstream>
 #include <algorithm>
 
-#define dbg(x) DebugLog((DebugLevel)(x),D_GAME) << __FILE__ << ":" << __LINE__ << ": "
+#define dbg(x) DebugLogLazy((DebugLevel)(x),D_GAME) << __FILE__ << ":" << __LINE__ << ": "
 
 const skill_id skill_carpentry( "carpentry" );
 const skill_id skill_survival( "survival" );
@@ -562,7 +562,7 @@ void activity_handlers::fill_liquid_do_turn( player_activity *act_, player *p )
         vehicle *source_veh = nullptr;
         const tripoint source_pos = act.coords.at( 0 );
         map_stack source_stack = g->m.i_at( source_pos );
-        std::list<item>::iterator on_ground;
+        item_list::iterator on_ground;
         item liquid;
         const auto source_type = static_cast<liquid_source_type>( act.values.at( 0 ) );
         switch( source_type ) {
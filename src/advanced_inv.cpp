@@ -1285,7 +1285,7 @@ bool advanced_inventory::move_all_items(bool nested_call)
         }
         g->u.activity.placement = sarea.off;
 
-        std::list<item>::iterator begin, end;
+        item_list::iterator begin, end;
         if( panes[src].in_vehicle() ) {
             begin = sarea.veh->get_items( sarea.vstor ).begin();
             end = sarea.veh->get_items( sarea.vstor ).end();
@@ -1198,6 +1198,7 @@ void player::add_bionic( std::string const &b )
     }
 
     my_bionics.push_back( bionic( b, get_free_invlet( *this ) ) );
+    update_bionic_slots();
     if( b == "bio_tools" || b == "bio_ears" ) {
         activate_bionic( my_bionics.size() - 1 );
     }
@@ -1225,6 +1226,7 @@ void player::remove_bionic( std::string const &b )
         new_my_bionics.push_back( bionic( i.id, i.invlet ) );
     }
     my_bionics = new_my_bionics;
+    update_bionic_slots();
     recalc_sight_limits();
 }
 
@@ -1347,6 +1349,8 @@ void load_bionic( JsonObject &jsobj )
     } else if( new_bionic.faulty ) {
         faulty_bionics.push_back( id );
     }
+    // Known bionics get the low ids, so the lookup tables of characters stay small.
+    bionic_iid{ id };
 }
 
 void check_bionics()
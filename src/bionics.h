@@ -2,6 +2,7 @@
 #define BIONICS_H
 
 #include "json.h"
+#include "interned_id.h"
 #include <string>
 
 class player;
@@ -9,6 +10,9 @@ class player;
 struct quality;
 using quality_id = string_id<quality>;
 
+struct bionic_data;
+using bionic_iid = interned_id<bionic_data>;
+
 struct bionic_data {
     bionic_data();
 
@@ -9,7 +9,7 @@
 #include <sstream>
 #include <vector>
 
-#define dbg(x) DebugLog((DebugLevel)(x),D_MAIN) << __FILE__ << ":" << __LINE__ << ": "
+#define dbg(x) DebugLogLazy((DebugLevel)(x),D_MAIN) << __FILE__ << ":" << __LINE__ << ": "
 
 bool needs_damage_type( affected_stat as )
 {
@@ -36,13 +36,16 @@ extern "C" {
 #include "lauxlib.h"
 }
 
+#include <array>
+#include <chrono>
+#include <cstring>
 #include <type_traits>
 
 #if LUA_VERSION_NUM < 502
 #define LUA_OK 0
 #endif
 
-using item_stack_iterator = std::list<item>::iterator;
+using item_stack_iterator = item_list::iterator;
 using volume = units::volume;
 
 lua_State *lua_state = nullptr;
@@ -74,6 +77,7 @@ static void luaL_setfuncs( lua_State * const L, const luaL_Reg arrary[], int con
 #endif
 
 void lua_dofile(lua_State *L, const char *path);
+static int traceback(lua_State *L);
 
 // Helper functions for making working with the lua API more straightforward.
 // --------------------------------------------------------------------------
@@ -817,9 +821,173 @@ int call_lua(std::string tocall)
     return err;
 }
 
+// Registry reference of mod_callback from autoexec.lua, looked up on first use.
+static int mod_callback_function = LUA_NOREF;
+
 void lua_callback(const char *callback_name)
 {
-    call_lua(std::string("mod_callback(\"") + std::string(callback_name) + "\")");
+    if( lua_state == nullptr ) {
+        return;
+    }
+    lua_State * const L = lua_state;
+    if( mod_callback_function == LUA_NOREF ) {
+        lua_getglobal( L, "mod_callback" );
+        if( !lua_isfunction( L, -1 ) ) {
+            lua_pop( L, 1 );
+            return;
+        }
+        mod_callback_function = luaL_ref( L, LUA_REGISTRYINDEX );
+    }
+
+    update_globals( L );
+    lua_pushcfunction( L, &traceback );
+    lua_rawgeti( L, LUA_REGISTRYINDEX, mod_callback_function );
+    lua_pushstring( L, callback_name );
+    const int err = lua_pcall( L, 1, 0, -3 );
+    lua_report_error( L, err, callback_name );
+    // The traceback function and, on error, the error message.
+    lua_pop( L, err == LUA_OK ? 1 : 2 );
+}
+
+// Functions subscribed to game events with game.subscribe.
+// --------------------------------------------------------
+
+struct lua_hook_subscription {
+    // Registry reference of the function.
+    int function;
+    // File and line the function was defined at, to tell the mods apart in the report.
+    std::string source;
+    int calls = 0;
+    int over_budget = 0;
+    std::chrono::microseconds total{ 0 };
+    std::chrono::microseconds worst{ 0 };
+};
+
+struct lua_hook_type {
+    const char *name;
+    // Calls that take longer than this are counted as over budget in the report.
+    std::chrono::microseconds budget;
+};
+
+// Indexed by lua_hook. Hooks that run often get the smaller budgets.
+static const std::array<lua_hook_type, NUM_LUA_HOOKS> lua_hook_types = { {
+    { "on_turn", std::chrono::microseconds( 1000 ) },
+    { "on_monster_spawn", std::chrono::microseconds( 200 ) },
+    { "on_item_use", std::chrono::microseconds( 5000 ) },
+    { "on_mapgen_postprocess", std::chrono::microseconds( 5000 ) },
+} };
+
+static std::array<std::vector<lua_hook_subscription>, NUM_LUA_HOOKS> lua_hook_subscriptions;
+
+// Calls the functions subscribed to the hook. For each of them, push_args pushes the
+// arguments onto the stack, stores them in the registry (so they can be outdated after the
+// call, like the iuse arguments) and returns their registry references.
+template<typename F>
+static void lua_run_hook( const lua_hook hook, F push_args )
+{
+    std::vector<lua_hook_subscription> &subscriptions = lua_hook_subscriptions[hook];
+    if( subscriptions.empty() || lua_state == nullptr ) {
+        return;
+    }
+    lua_State * const L = lua_state;
+    const std::chrono::microseconds budget = lua_hook_types[hook].budget;
+
+    update_globals( L );
+    lua_pushcfunction( L, &traceback );
+    const int handler = lua_gettop( L );
+    // By index, the functions may subscribe further functions.
+    for( size_t i = 0; i < subscriptions.size(); i++ ) {
+        lua_rawgeti( L, LUA_REGISTRYINDEX, subscriptions[i].function );
+        const std::vector<int> args = push_args( L );
+
+        const auto start = std::chrono::steady_clock::now();
+        const int err = lua_pcall( L, static_cast<int>( args.size() ), 0, handler );
+        const auto took = std::chrono::duration_cast<std::chrono::microseconds>(
+                              std::chrono::steady_clock::now() - start );
+
+        lua_hook_subscription &sub = subscriptions[i];
+        if( lua_report_error( L, err, sub.source.c_str() ) ) {
+            lua_pop( L, 1 );
+        }
+        for( const int arg : args ) {
+            luah_remove_from_registry( L, arg );
+            luah_setmetatable( L, "outdated_metatable" );
+            lua_pop( L, 1 );
+        }
+
+        sub.calls++;
+        sub.total += took;
+        sub.worst = std::max( sub.worst, took );
+        if( took > budget && sub.over_budget++ == 0 ) {
+            DebugLog( D_WARNING, D_MAIN ) << "lua " << lua_hook_types[hook].name << " function at "
+                                          << sub.source << " took " << took.count()
+                                          << " us, more than the budget of " << budget.count() << " us";
+        }
+    }
+    lua_pop( L, 1 );
+}
+
+void lua_hook_turn()
+{
+    lua_run_hook( LUA_HOOK_TURN, []( lua_State * ) {
+        return std::vector<int>();
+    } );
+}
+
+void lua_hook_monster_spawn( monster &critter )
+{
+    lua_run_hook( LUA_HOOK_MONSTER_SPAWN, [&critter]( lua_State * const L ) {
+        return std::vector<int> { LuaReference<monster>::push_reg( L, critter ) };
+    } );
+}
+
+void lua_hook_item_use( player &p, item &it, const tripoint &pos )
+{
+    lua_run_hook( LUA_HOOK_ITEM_USE, [&]( lua_State * const L ) -> std::vector<int> {
+        std::vector<int> args;
+        args.push_back( LuaReference<player>::push_reg( L, p ) );
+        args.push_back( LuaReference<item>::push_reg( L, it ) );
+        args.push_back( LuaValue<tripoint>::push_reg( L, pos ) );
+        return args;
+    } );
+}
+
+void lua_hook_mapgen_postprocess( map &m, const oter_id &terrain_type, const tripoint &abs_sub )
+{
+    lua_run_hook( LUA_HOOK_MAPGEN_POSTPROCESS, [&]( lua_State * const L ) -> std::vector<int> {
+        std::vector<int> args;
+        args.push_back( LuaReference<map>::push_reg( L, m ) );
+        lua_pushstring( L, terrain_type.id().c_str() );
+        args.push_back( luah_store_in_registry( L, -1 ) );
+        args.push_back( LuaValue<tripoint>::push_reg( L, abs_sub ) );
+        return args;
+    } );
+}
+
+std::string lua_hook_report()
+{
+    typedef std::pair<const lua_hook_type *, const lua_hook_subscription *> report_line;
+    std::vector<report_line> lines;
+    for( size_t hook = 0; hook < NUM_LUA_HOOKS; hook++ ) {
+        for( const lua_hook_subscription &sub : lua_hook_subscriptions[hook] ) {
+            lines.emplace_back( &lua_hook_types[hook], &sub );
+        }
+    }
+    if( lines.empty() ) {
+        return "No functions are subscribed to game events.";
+    }
+    std::stable_sort( lines.begin(), lines.end(), []( const report_line &a, const report_line &b ) {
+        return a.second->total > b.second->total;
+    } );
+
+    std::string report;
+    for( const report_line &line : lines ) {
+        const lua_hook_subscription &sub = *line.second;
+        report += string_format( "%s %s: %d calls, %.3f ms total, %.3f ms worst, %d over the %.3f ms budget\n",
+                                 line.first->name, sub.source.c_str(), sub.calls, sub.total.count() / 1000.0,
+                                 sub.worst.count() / 1000.0, sub.over_budget, line.first->budget.count() / 1000.0 );
+    }
+    return report;
 }
 
 //
@@ -1117,6 +1285,37 @@ static int game_myPrint( lua_State *L )
     return 0;
 }
 
+// game.subscribe(event_name, func)
+//
+// Calls func whenever the event happens, see lua_hook for the events and their arguments.
+static int game_subscribe(lua_State *L)
+{
+    const char *name = luaL_checkstring(L, 1);
+    luaL_checktype(L, 2, LUA_TFUNCTION);
+    for( size_t hook = 0; hook < NUM_LUA_HOOKS; hook++ ) {
+        if( strcmp( name, lua_hook_types[hook].name ) != 0 ) {
+            continue;
+        }
+        lua_Debug ar;
+        lua_pushvalue(L, 2);
+        lua_getinfo(L, ">S", &ar);
+
+        lua_hook_subscription sub;
+        sub.function = luah_store_in_registry(L, 2);
+        sub.source = string_format( "%s:%d", ar.short_src, ar.linedefined );
+        lua_hook_subscriptions[hook].push_back( sub );
+        return 0;
+    }
+    return luaL_error(L, "unknown event %s", name);
+}
+
+// game.hook_report()
+static int game_hook_report(lua_State *L)
+{
+    lua_pushstring(L, lua_hook_report().c_str());
+    return 1;
+}
+
 // Registry containing all the game functions exported to lua.
 // -----------------------------------------------------------
 static const struct luaL_Reg global_funcs [] = {
@@ -1127,6 +1326,8 @@ static const struct luaL_Reg global_funcs [] = {
     {"dofile", game_dofile},
     {"get_monster_types", game_get_monster_types},
     {"get_item_groups", game_get_item_groups},
+    {"subscribe", game_subscribe},
+    {"hook_report", game_hook_report},
     {NULL, NULL}
 };
 
@@ -1138,6 +1339,11 @@ void game::init_lua()
     if( lua_state != nullptr ) {
         lua_close( lua_state );
     }
+    // The registry references died with the old state.
+    mod_callback_function = LUA_NOREF;
+    for( auto &subscriptions : lua_hook_subscriptions ) {
+        subscriptions.clear();
+    }
     lua_state = luaL_newstate();
     if( lua_state == nullptr ) {
         debugmsg( "Failed to start Lua. Lua scripting won't be available." );
@@ -1227,6 +1433,22 @@ int call_lua( std::string ) {
 void lua_callback( const char * )
 {
 }
+void lua_hook_turn()
+{
+}
+void lua_hook_monster_spawn( monster & )
+{
+}
+void lua_hook_item_use( player &, item &, const tripoint & )
+{
+}
+void lua_hook_mapgen_postprocess( map &, const oter_id &, const tripoint & )
+{
+}
+std::string lua_hook_report()
+{
+    return std::string();
+}
 void lua_loadmod( std::string, std::string )
 {
 }
@@ -6,10 +6,13 @@
 #include <string>
 #include <sstream>
 
+class item;
 class map;
 class monster;
+class player;
 struct mapgendata;
 struct oter_t;
+struct tripoint;
 
 using oter_id = int_id<oter_t>;
 
@@ -33,6 +36,34 @@ int lua_mapgen( map *m, const oter_id &terrain_type, const mapgendata &md, int t
  */
 void lua_callback( const char *callback_name );
 
+/**
+ * Events that mods can subscribe to from Lua with `game.subscribe( "on_turn", func )`.
+ * Subscribed functions are kept as registry references and called in the order they
+ * were subscribed in.
+ */
+enum lua_hook : int {
+    /** Once per turn, no arguments. */
+    LUA_HOOK_TURN = 0,
+    /** A monster was added to the game, called with the monster. */
+    LUA_HOOK_MONSTER_SPAWN,
+    /** A player or npc is about to activate or apply an item, called with the user, the item and the target. */
+    LUA_HOOK_ITEM_USE,
+    /** A map was generated, called with the map, the terrain type and the submap position. */
+    LUA_HOOK_MAPGEN_POSTPROCESS,
+    NUM_LUA_HOOKS
+};
+
+void lua_hook_turn();
+void lua_hook_monster_spawn( monster &critter );
+void lua_hook_item_use( player &p, item &it, const tripoint &pos );
+void lua_hook_mapgen_postprocess( map &m, const oter_id &terrain_type, const tripoint &abs_sub );
+
+/**
+ * Lists the subscribed functions, slowest first, with their call count, total and worst
+ * time and how often they took longer than the time budget of their hook.
+ */
+std::string lua_hook_report();
+
 /**
  * Load the main file of a lua mod.
  *
@@ -16,6 +16,7 @@
 #include "player.h"
 #include "mutation.h"
 #include "vehicle.h"
+#include "visitable_inline.h"
 
 #include <algorithm>
 
@@ -533,29 +534,50 @@ float Character::get_vision_threshold(int light_level) const {
 
 bool Character::has_bionic(const std::string & b) const
 {
-    for (auto &i : my_bionics) {
-        if (i.id == b) {
-            return true;
-        }
-    }
-    return false;
+    return has_bionic( bionic_iid::find( b ) );
+}
+
+bool Character::has_bionic( const bionic_iid &id ) const
+{
+    return id.is_valid() && size_t( id.to_i() ) < bionic_slots.size() &&
+           bionic_slots[id.to_i()] >= 0;
 }
 
 bool Character::has_active_bionic(const std::string & b) const
 {
-    for (auto &i : my_bionics) {
-        if (i.id == b) {
-            return (i.powered);
+    return has_active_bionic( bionic_iid::find( b ) );
+}
+
+bool Character::has_active_bionic( const bionic_iid &id ) const
+{
+    if( !id.is_valid() || size_t( id.to_i() ) >= bionic_slots.size() ) {
+        return false;
+    }
+    const int slot = bionic_slots[id.to_i()];
+    // The power state changes too often to track it here, it is read from the bionic.
+    return slot >= 0 && my_bionics[slot].powered;
+}
+
+void Character::update_bionic_slots()
+{
+    bionic_slots.assign( bionic_iid::count(), -1 );
+    for( size_t i = 0; i < my_bionics.size(); i++ ) {
+        const bionic_iid id( my_bionics[i].id );
+        if( size_t( id.to_i() ) >= bionic_slots.size() ) {
+            bionic_slots.resize( id.to_i() + 1, -1 );
+        }
+        // Like the linear search this replaces, the first of several copies wins.
+        if( bionic_slots[id.to_i()] < 0 ) {
+            bionic_slots[id.to_i()] = i;
         }
     }
-    return false;
 }
 
 std::vector<item_location> Character::nearby( const std::function<bool(const item *, const item *)>& func, int radius ) const
 {
     std::vector<item_location> res;
 
-    visit_items( [&]( const item *e, const item *parent ) {
+    visit_inline( [&]( const item *e, const item *parent ) {
         if( func( e, parent ) ) {
             res.emplace_back( const_cast<Character &>( *this ), const_cast<item *>( e ) );
         }
@@ -563,7 +585,7 @@ std::vector<item_location> Character::nearby( const std::function<bool(const ite
     } );
 
     for( const auto &cur : map_selector( pos(), radius ) ) {
-        cur.visit_items( [&]( const item *e, const item *parent  ) {
+        cur.visit_inline( [&]( const item *e, const item *parent  ) {
             if( func( e, parent ) ) {
                 res.emplace_back( cur, const_cast<item *>( e ) );
             }
@@ -572,7 +594,7 @@ std::vector<item_location> Character::nearby( const std::function<bool(const ite
     }
 
     for( const auto &cur : vehicle_selector( pos(), radius ) ) {
-        cur.visit_items( [&]( const item *e, const item *parent  ) {
+        cur.visit_inline( [&]( const item *e, const item *parent  ) {
             if( func( e, parent ) ) {
                 res.emplace_back( cur, const_cast<item *>( e ) );
             }
@@ -976,6 +998,7 @@ SkillLevel& Character::get_skill_level(const skill_id &ident)
         none.level( 0 );
         return none;
     }
+    skill_changes++;
     return _skills[ident];
 }
 
@@ -1619,7 +1642,7 @@ void Character::update_health(int external_modifiers)
     // And healthy_mod decays over time.
     set_healthy_mod( get_healthy_mod() * 3 / 4 );
 
-    add_msg( m_debug, "Health: %d, Health mod: %d", get_healthy(), get_healthy_mod() );
+    add_msg_debug( "Health: %d, Health mod: %d", get_healthy(), get_healthy_mod() );
 }
 
 int Character::get_dodge_base() const
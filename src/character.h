@@ -7,10 +7,13 @@
 #include "bionics.h"
 #include "skill.h"
 #include "map_selector.h"
+#include "interned_id.h"
 
 #include <map>
 
 using skill_id = string_id<Skill>;
+struct mutation_branch;
+using trait_iid = interned_id<mutation_branch>;
 enum field_id : int;
 class field;
 class field_entry;
@@ -222,6 +225,7 @@ class Character : public Creature, public visitable<Character>
         // In mutation.cpp
         /** Returns true if the player has the entered trait */
         bool has_trait(const std::string &flag) const override;
+        bool has_trait( const trait_iid &id ) const;
         /** Returns true if the player has the entered starting trait */
         bool has_base_trait(const std::string &flag) const;
         /** Returns true if player has a trait with a flag */
@@ -287,8 +291,10 @@ class Character : public Creature, public visitable<Character>
         // --------------- Bionic Stuff ---------------
         /** Returns true if the player has the entered bionic id */
         bool has_bionic(const std::string &b) const;
+        bool has_bionic( const bionic_iid &id ) const;
         /** Returns true if the player has the entered bionic id and it is powered on */
         bool has_active_bionic(const std::string &b) const;
+        bool has_active_bionic( const bionic_iid &id ) const;
 
         // --------------- Generic Item Stuff ---------------
 
@@ -433,6 +439,10 @@ class Character : public Creature, public visitable<Character>
         SkillLevel const& get_skill_level(const skill_id &ident) const;
         void set_skill_level( const skill_id &ident, int level );
         void boost_skill_level( const skill_id &ident, int delta );
+        /** Changes whenever non-const access to a skill level is handed out. */
+        unsigned long skills_revision() const {
+            return skill_changes;
+        }
 
         bool meets_skill_requirements( const std::map<skill_id, int> &req ) const;
 
@@ -561,12 +571,30 @@ class Character : public Creature, public visitable<Character>
          * Contains mutation ids of the base traits.
          */
         std::unordered_set<std::string> my_traits;
+        /**
+         * Bit i is set if @ref my_mutations contains the trait with the interned id i.
+         * Kept up to date by the functions that add and remove mutations, code that changes
+         * @ref my_mutations directly must call @ref update_trait_bits afterwards.
+         */
+        std::vector<bool> trait_bits;
+        /**
+         * For each interned bionic id the index of that bionic in @ref my_bionics, -1 if
+         * it is not installed. Code that adds or removes bionics must call
+         * @ref update_bionic_slots afterwards.
+         */
+        std::vector<int> bionic_slots;
+
+        void set_trait_bit( const std::string &mut, bool value );
+        void update_trait_bits();
+        void update_bionic_slots();
 
         void store(JsonOut &jsout) const;
         void load(JsonObject &jsin);
 
         // --------------- Values ---------------
         std::map<skill_id, SkillLevel> _skills;
+        /** See @ref skills_revision */
+        unsigned long skill_changes = 0;
 
         // Cached vision values.
         std::bitset<NUM_VISION_MODES> vision_mode_cache;
@@ -236,7 +236,7 @@ bool computer::hack_attempt(player *p, int Security)
     return successful_attempt;
 }
 
-std::string computer::save_data()
+std::string computer::save_data() const
 {
     std::ostringstream data;
     std::string savename = name; // Replace " " with "_"
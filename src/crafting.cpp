@@ -254,7 +254,11 @@ bool player::can_make( const recipe *r, int batch_size )
     }
 
     const inventory &crafting_inv = crafting_inventory();
-    return r->can_make_with_inventory( crafting_inv, batch_size );
+    if( this != &g->u ) {
+        return r->can_make_with_inventory( *this, crafting_inv, get_crafting_helpers(), batch_size );
+    }
+    return recipe_availability::get_instance().can_make( *r, crafting_inv,
+            get_crafting_helpers(), batch_size );
 }
 
 bool recipe::can_make_with_inventory( const inventory &crafting_inv, int batch ) const
@@ -266,11 +270,17 @@ bool recipe::can_make_with_inventory( const inventory &crafting_inv,
                                       const std::vector<npc *> &helpers,
                                       int batch ) const
 {
-    if( g->u.has_trait( "DEBUG_HS" ) ) {
+    return can_make_with_inventory( g->u, crafting_inv, helpers, batch );
+}
+
+bool recipe::can_make_with_inventory( const player &p, const inventory &crafting_inv,
+                                      const std::vector<npc *> &helpers, int batch ) const
+{
+    if( p.has_trait( "DEBUG_HS" ) ) {
         return true;
     }
 
-    if( !g->u.knows_recipe( this ) && -1 == g->u.has_recipe( this, crafting_inv, helpers ) ) {
+    if( !p.knows_recipe( this ) && -1 == p.has_recipe( this, crafting_inv, helpers ) ) {
         return false;
     }
     return requirements().can_make_with_inventory( crafting_inv, batch );
@@ -295,6 +305,7 @@ const inventory &player::crafting_inventory()
                                                calendar::turn, power_level );
         }
     }
+    cached_crafting_inventory.build_index();
 
     cached_moves = moves;
     cached_turn = calendar::turn.get_turn();
@@ -315,9 +326,191 @@ void batch_recipes( const inventory &crafting_inv,
     current.clear();
     available.clear();
 
-    for( int i = 1; i <= 20; i++ ) {
+    const int max_batch = recipe_availability::get_instance().max_batch_size( *rec, crafting_inv,
+                          helpers );
+    for( int i = 1; i <= recipe_availability::max_batch; i++ ) {
         current.push_back( rec );
-        available.push_back( rec->can_make_with_inventory( crafting_inv, helpers, i ) );
+        available.push_back( i <= max_batch );
+    }
+}
+
+recipe_availability &recipe_availability::get_instance()
+{
+    static recipe_availability instance;
+    return instance;
+}
+
+bool recipe_availability::can_make( const recipe &r, const inventory &crafting_inv,
+                                    const std::vector<npc *> &helpers, int batch )
+{
+    if( batch > max_batch || crafting_inv.get_index() == nullptr ) {
+        return r.can_make_with_inventory( crafting_inv, helpers, batch );
+    }
+    return batch <= max_batch_size( r, crafting_inv, helpers );
+}
+
+int recipe_availability::max_batch_size( const recipe &r, const inventory &crafting_inv,
+        const std::vector<npc *> &helpers )
+{
+    const bool indexed = crafting_inv.get_index() != nullptr;
+    if( indexed ) {
+        sync( crafting_inv, helpers );
+        const auto iter = batches.find( &r );
+        if( iter != batches.end() ) {
+            return iter->second;
+        }
+    }
+
+    evaluated++;
+    int result = 0;
+    if( r.can_make_with_inventory( crafting_inv, helpers, 1 ) ) {
+        // Larger batches need more of everything, so once a batch size can not be
+        // made no larger one can be made either.
+        result = 1;
+        int upper = max_batch;
+        while( result < upper ) {
+            const int batch = ( result + upper + 1 ) / 2;
+            if( r.requirements().can_make_with_inventory( crafting_inv, batch ) ) {
+                result = batch;
+            } else {
+                upper = batch - 1;
+            }
+        }
+    }
+    if( indexed ) {
+        batches.emplace( &r, result );
+    }
+    return result;
+}
+
+void recipe_availability::clear()
+{
+    index.reset();
+    state = player_state();
+    revisions.clear();
+    books.clear();
+    batches.clear();
+    by_type.clear();
+    by_quality.clear();
+    lookup_built = false;
+}
+
+bool recipe_availability::player_state::operator==( const player_state &rhs ) const
+{
+    return debug_hs == rhs.debug_hs && helpers == rhs.helpers && learned == rhs.learned &&
+           levels == rhs.levels;
+}
+
+static void add_skill_levels( const player &p, std::vector<int> &levels )
+{
+    for( const Skill &sk : Skill::skills ) {
+        levels.push_back( p.get_skill_level( sk.ident() ) );
+    }
+}
+
+void recipe_availability::sync( const inventory &crafting_inv, const std::vector<npc *> &helpers )
+{
+    const std::shared_ptr<const inventory_index> latest = crafting_inv.shared_index();
+    const bool debug_hs = g->u.has_trait( "DEBUG_HS" );
+    std::vector<unsigned long> current_revisions;
+    current_revisions.push_back( g->u.skills_revision() );
+    current_revisions.push_back( g->u.recipes_revision() );
+    for( const npc *np : helpers ) {
+        current_revisions.push_back( np->skills_revision() );
+        current_revisions.push_back( np->recipes_revision() );
+    }
+    if( latest == index && debug_hs == state.debug_hs && current_revisions == revisions &&
+        helpers.size() == state.helpers.size() &&
+        std::equal( helpers.begin(), helpers.end(), state.helpers.begin() ) ) {
+        return;
+    }
+    revisions = std::move( current_revisions );
+
+    player_state current;
+    current.debug_hs = debug_hs;
+    current.helpers.assign( helpers.begin(), helpers.end() );
+    current.learned = g->u.learned_recipes;
+    add_skill_levels( g->u, current.levels );
+    for( const npc *np : helpers ) {
+        add_skill_levels( *np, current.levels );
+        current.levels.push_back( np->learned_recipes.size() );
+    }
+    if( !( current == state ) ) {
+        batches.clear();
+        state = std::move( current );
+    }
+    if( !lookup_built ) {
+        build_lookup();
+    }
+
+    std::set<itype_id> current_books;
+    for( const auto stack : crafting_inv.const_slice() ) {
+        const item &it = stack->front();
+        if( it.is_book() && g->u.has_identified( it.typeId() ) ) {
+            current_books.insert( it.typeId() );
+        }
+    }
+
+    if( index == nullptr ) {
+        batches.clear();
+    } else if( !batches.empty() ) {
+        std::set<itype_id> types;
+        std::set<quality_id> quals;
+        index->diff( *latest, types, quals );
+        for( const itype_id &id : types ) {
+            const auto iter = by_type.find( id );
+            if( iter != by_type.end() ) {
+                invalidate( iter->second );
+            }
+        }
+        for( const quality_id &id : quals ) {
+            const auto iter = by_quality.find( id );
+            if( iter != by_quality.end() ) {
+                invalidate( iter->second );
+            }
+        }
+
+        std::vector<itype_id> changed_books;
+        std::set_symmetric_difference( books.begin(), books.end(), current_books.begin(),
+                                       current_books.end(), std::back_inserter( changed_books ) );
+        for( const itype_id &id : changed_books ) {
+            for( const auto &taught : item::find_type( id )->book->recipes ) {
+                batches.erase( taught.recipe );
+            }
+        }
+    }
+    index = latest;
+    books = std::move( current_books );
+}
+
+void recipe_availability::build_lookup()
+{
+    for( const auto &e : recipe_dict ) {
+        const recipe *r = &e.second;
+        const requirement_data &reqs = r->requirements();
+        for( const auto &opts : reqs.get_components() ) {
+            for( const item_comp &comp : opts ) {
+                by_type[comp.type].insert( r );
+            }
+        }
+        for( const auto &opts : reqs.get_tools() ) {
+            for( const tool_comp &tool : opts ) {
+                by_type[tool.type].insert( r );
+            }
+        }
+        for( const auto &opts : reqs.get_qualities() ) {
+            for( const quality_requirement &qual : opts ) {
+                by_quality[qual.type].insert( r );
+            }
+        }
+    }
+    lookup_built = true;
+}
+
+void recipe_availability::invalidate( const std::set<const recipe *> &recipes )
+{
+    for( const recipe *r : recipes ) {
+        batches.erase( r );
     }
 }
 
@@ -9,12 +9,15 @@
 #include <vector>
 #include <map>
 #include <list>
+#include <memory>
+#include <set>
 
 class recipe_dictionary;
 class JsonObject;
 class Skill;
 using skill_id = string_id<Skill>;
 class inventory;
+class inventory_index;
 class player;
 class npc;
 
@@ -103,6 +106,9 @@ struct recipe {
         bool can_make_with_inventory( const inventory &crafting_inv,
                                       const std::vector<npc *> &helpers,
                                       int batch = 1 ) const;
+        /** Same as above, but for @p p instead of the avatar. */
+        bool can_make_with_inventory( const player &p, const inventory &crafting_inv,
+                                      const std::vector<npc *> &helpers, int batch = 1 ) const;
         bool check_eligible_containers_for_crafting( int batch = 1 ) const;
 
         int print_items( WINDOW *w, int ypos, int xpos, nc_color col, int batch = 1 ) const;
@@ -141,6 +147,77 @@ void remove_ammo( std::list<item> &dis_items, player &p );
 bool query_dissamble( const item &dis_item );
 const recipe *select_crafting_recipe( int &batch_size );
 
+/**
+ * Remembers for each recipe the largest batch the player can craft with the crafting
+ * inventory, so the crafting menu does not check every recipe against the whole
+ * inventory each time it is opened.
+ * Results are keyed on the @ref inventory_index of the crafting inventory. When it
+ * changes, only the recipes that use one of the item types or qualities whose totals
+ * changed, or that are taught by a book that came or went, are checked again.
+ * Anything else the answer depends on (known recipes, skills, helpers, DEBUG_HS)
+ * drops all results when it changes.
+ * Inventories without an index are always checked directly. Answers are for the
+ * avatar, NPCs check their recipes directly.
+ */
+class recipe_availability
+{
+    public:
+        /** Batch sizes up to this are remembered, larger ones are checked directly. */
+        static const int max_batch = 20;
+
+        static recipe_availability &get_instance();
+
+        /** Same as recipe::can_make_with_inventory. */
+        bool can_make( const recipe &r, const inventory &crafting_inv,
+                       const std::vector<npc *> &helpers, int batch = 1 );
+        /** Largest batch size up to @ref max_batch that can be crafted, 0 if none. */
+        int max_batch_size( const recipe &r, const inventory &crafting_inv,
+                            const std::vector<npc *> &helpers );
+
+        /** Forgets everything, needed when the recipes are reloaded. */
+        void clear();
+
+        /** Number of recipes checked against an inventory so far, for testing. */
+        size_t evaluations() const {
+            return evaluated;
+        }
+
+    private:
+        /** What the answers depend on besides the crafting inventory. */
+        struct player_state {
+            bool debug_hs = false;
+            std::vector<const npc *> helpers;
+            std::map<std::string, const recipe *> learned;
+            /** Skill levels of the player and the helpers, and the helpers' recipe counts. */
+            std::vector<int> levels;
+
+            bool operator==( const player_state &rhs ) const;
+        };
+
+        void sync( const inventory &crafting_inv, const std::vector<npc *> &helpers );
+        void build_lookup();
+        void invalidate( const std::set<const recipe *> &recipes );
+
+        std::shared_ptr<const inventory_index> index;
+        player_state state;
+        /**
+         * Skill and known recipe revisions of the player and the helpers when @ref state
+         * was taken. Unless they or the index changed, @ref state is not taken again.
+         */
+        std::vector<unsigned long> revisions;
+        /** Identified books in the crafting inventory, they may teach recipes. */
+        std::set<itype_id> books;
+        std::map<const recipe *, int> batches;
+
+        /** Recipes by the item types they use as component or tool. */
+        std::map<itype_id, std::set<const recipe *>> by_type;
+        /** Recipes by the tool qualities they need. */
+        std::map<quality_id, std::set<const recipe *>> by_quality;
+        bool lookup_built = false;
+
+        size_t evaluated = 0;
+};
+
 void batch_recipes( const inventory &crafting_inv,
                     const std::vector<npc *> &helpers,
                     std::vector<const recipe *> &current,
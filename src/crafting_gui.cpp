@@ -175,7 +175,7 @@ const recipe *select_crafting_recipe( int &batch_size )
     const std::vector<npc *> helpers = g->u.get_crafting_helpers();
     std::string filterstring = "";
 
-    std::map<const recipe *, bool> availability_cache;
+    recipe_availability &availability = recipe_availability::get_instance();
     do {
         if( redraw ) {
             // When we switch tabs, redraw the header
@@ -205,11 +205,9 @@ const recipe *select_crafting_recipe( int &batch_size )
                     current = recipe_dict.search( filterstring );
                 }
 
-                // cache recipe availability on first display
+                std::map<const recipe *, bool> availability_cache;
                 for( const auto e : current ) {
-                    if( !availability_cache.count( e ) ) {
-                        availability_cache.emplace( e, e->can_make_with_inventory( crafting_inv, helpers ) );
-                    }
+                    availability_cache.emplace( e, availability.can_make( *e, crafting_inv, helpers ) );
                 }
 
                 std::stable_sort( current.begin(), current.end(), []( const recipe * a, const recipe * b ) {
@@ -311,6 +311,10 @@ class Creature
         /** Check if creature has the matching effect. bp = num_bp means to check if the Creature has any effect
          *  of the matching type, targeted or untargeted. */
         bool has_effect( const efftype_id &eff_id, body_part bp = num_bp ) const;
+        /** Changes whenever an effect is added or removed, see @ref effect_storage::revision. */
+        unsigned long effects_revision() const {
+            return effects.revision();
+        }
         /** Return the effect that matches the given arguments exactly. */
         const effect &get_effect( const efftype_id &eff_id, body_part bp = num_bp ) const;
         effect &get_effect( const efftype_id &eff_id, body_part bp = num_bp );
@@ -485,8 +489,7 @@ class Creature
         Creature *killer; // whoever killed us. this should be NULL unless we are dead
         void set_killer( Creature *killer );
 
-        // Storing body_part as an int to make things easier for hash and JSON
-        std::unordered_map<efftype_id, std::unordered_map<body_part, effect, std::hash<int>>> effects;
+        effect_storage effects;
         // Miscellaneous key/value pairs.
         std::unordered_map<std::string, std::string> values;
 
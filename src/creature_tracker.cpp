@@ -76,6 +76,7 @@ bool Creature_tracker::add( monster &critter )
 
     monsters_by_location[critter.pos()] = monsters_list.size();
     monsters_list.push_back( new monster( critter ) );
+    changes++;
     return true;
 }
 
@@ -86,6 +87,8 @@ size_t Creature_tracker::size() const
 
 bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_pos )
 {
+    // The caller moves the monster even if this fails.
+    changes++;
     const auto old_pos = critter.pos();
     if( critter.is_dead() ) {
         // mon_at ignores dead critters anyway, changing their position in the
@@ -159,6 +162,7 @@ void Creature_tracker::remove( const int idx )
 
     delete monsters_list[idx];
     monsters_list.erase( monsters_list.begin() + idx );
+    changes++;
 
     // Fix indices in monsters_by_location for any zombies that were just moved down 1 place.
     for( auto &elem : monsters_by_location ) {
@@ -175,10 +179,12 @@ void Creature_tracker::clear()
     }
     monsters_list.clear();
     monsters_by_location.clear();
+    changes++;
 }
 
 void Creature_tracker::rebuild_cache()
 {
+    changes++;
     monsters_by_location.clear();
     for( size_t i = 0; i < monsters_list.size(); i++ ) {
         monster &critter = *monsters_list[i];
@@ -208,6 +214,7 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
         ok = false;
     }
 
+    changes++;
     tripoint temp = second.pos();
     second.spawn( first.pos() );
     first.spawn( temp );
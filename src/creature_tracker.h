@@ -30,8 +30,13 @@ class Creature_tracker
         const std::vector<monster> &list() const;
         /** Swaps the positions of two monsters */
         void swap_positions( monster &first, monster &second );
+        /** Changes whenever a monster is added, moved or removed. */
+        unsigned long revision() const {
+            return changes;
+        }
 
     private:
+        unsigned long changes = 0;
         std::vector<monster *> monsters_list;
         std::unordered_map<tripoint, size_t> monsters_by_location;
         /** Remove the monsters entry in @ref monsters_by_location */
@@ -3,14 +3,23 @@
 #include "output.h"
 #include "filesystem.h"
 #include <time.h>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <cstdarg>
+#include <cstring>
 #include <iosfwd>
 #include <fstream>
+#include <map>
+#include <mutex>
 #include <streambuf>
 #include <sys/stat.h>
 #include <exception>
+#include <thread>
+#include <vector>
 
 #ifndef _MSC_VER
 #include <sys/time.h>
@@ -44,6 +53,23 @@ namespace
 
 std::set<std::string> ignored_messages;
 
+/** The thread that initialized the program, the only one that may show messages. */
+const std::thread::id main_thread_id = std::this_thread::get_id();
+
+struct deferred_debugmsg {
+    std::string filename;
+    std::string line;
+    std::string funcname;
+    std::string text;
+};
+
+/** Messages raised on other threads, see @ref flush_deferred_debugmsgs. */
+std::mutex deferred_mutex;
+std::vector<deferred_debugmsg> deferred_messages;
+
+void show_debugmsg( const char *filename, const char *line, const char *funcname,
+                    const std::string &text );
+
 }
 
 void realDebugmsg( const char *filename, const char *line, const char *funcname, const char *mes,
@@ -58,6 +84,37 @@ void realDebugmsg( const char *filename, const char *line, const char *funcname,
     const std::string text = vstring_format( mes, ap );
     va_end( ap );
 
+    if( std::this_thread::get_id() != main_thread_id ) {
+        // Neither the debug log nor the screen may be used from here
+        std::lock_guard<std::mutex> lock( deferred_mutex );
+        deferred_messages.push_back( deferred_debugmsg{ filename, line, funcname, text } );
+        return;
+    }
+    flush_deferred_debugmsgs();
+    show_debugmsg( filename, line, funcname, text );
+}
+
+void flush_deferred_debugmsgs()
+{
+    if( std::this_thread::get_id() != main_thread_id ) {
+        return;
+    }
+    std::vector<deferred_debugmsg> messages;
+    {
+        std::lock_guard<std::mutex> lock( deferred_mutex );
+        messages.swap( deferred_messages );
+    }
+    for( const deferred_debugmsg &msg : messages ) {
+        show_debugmsg( msg.filename.c_str(), msg.line.c_str(), msg.funcname.c_str(), msg.text );
+    }
+}
+
+namespace
+{
+
+void show_debugmsg( const char *filename, const char *line, const char *funcname,
+                    const std::string &text )
+{
     if( test_mode ) {
         test_dirty = true;
         std::cerr << filename << ":" << line << " [" << funcname << "] " << text << std::endl;
@@ -104,6 +161,8 @@ void realDebugmsg( const char *filename, const char *line, const char *funcname,
     refresh();
 }
 
+}
+
 // Normal functions                                                 {{{1
 // ---------------------------------------------------------------------
 
@@ -119,6 +178,99 @@ void limitDebugClass( int class_bitmask )
     debugClass = class_bitmask;
 }
 
+static bool isLogged( DebugLevel lev, DebugClass cl )
+{
+    // Error are always logged, they are important,
+    // Messages from D_MAIN come from debugmsg and are equally important.
+    return ( ( lev & debugLevel ) && ( cl & debugClass ) ) || lev & D_ERROR || cl & D_MAIN;
+}
+
+// Debug trace                                                      {{{2
+// ---------------------------------------------------------------------
+
+namespace
+{
+
+struct DebugTrace {
+    std::mutex mutex;
+    FILE *file = nullptr;
+    std::chrono::steady_clock::time_point start;
+    std::map<const char *, uint32_t> file_ids;
+
+    template<typename T>
+    void write( const T &value ) {
+        fwrite( &value, sizeof( value ), 1, file );
+    }
+
+    uint32_t file_id( const char *filename ) {
+        const auto iter = file_ids.find( filename );
+        if( iter != file_ids.end() ) {
+            return iter->second;
+        }
+        const uint32_t id = file_ids.size();
+        file_ids.emplace( filename, id );
+        const uint32_t length = strlen( filename );
+        write( 'F' );
+        write( id );
+        write( length );
+        fwrite( filename, 1, length, file );
+        return id;
+    }
+};
+
+DebugTrace debugTrace;
+// Checked without the lock, so that statements are cheap while no trace is active.
+std::atomic<bool> debugTraceActive( false );
+
+} // namespace
+
+bool startDebugTrace( const std::string &filename )
+{
+    stopDebugTrace();
+    std::lock_guard<std::mutex> lock( debugTrace.mutex );
+    debugTrace.file = fopen( filename.c_str(), "wb" );
+    if( debugTrace.file == nullptr ) {
+        return false;
+    }
+    fwrite( "CDDATRC1", 1, 8, debugTrace.file );
+    debugTrace.start = std::chrono::steady_clock::now();
+    debugTraceActive = true;
+    return true;
+}
+
+void stopDebugTrace()
+{
+    std::lock_guard<std::mutex> lock( debugTrace.mutex );
+    if( debugTrace.file == nullptr ) {
+        return;
+    }
+    debugTraceActive = false;
+    fclose( debugTrace.file );
+    debugTrace.file = nullptr;
+    debugTrace.file_ids.clear();
+}
+
+bool debugLogEnabled( DebugLevel lev, DebugClass cl, const char *file, int line )
+{
+    const bool enabled = isLogged( lev, cl );
+    if( debugTraceActive ) {
+        std::lock_guard<std::mutex> lock( debugTrace.mutex );
+        if( debugTrace.file != nullptr ) {
+            const uint64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                                        std::chrono::steady_clock::now() - debugTrace.start ).count();
+            const uint32_t id = debugTrace.file_id( file );
+            debugTrace.write( 'E' );
+            debugTrace.write( micros );
+            debugTrace.write( id );
+            debugTrace.write( uint32_t( line ) );
+            debugTrace.write( uint32_t( lev ) );
+            debugTrace.write( uint32_t( cl ) );
+            debugTrace.write( uint8_t( enabled ) );
+        }
+    }
+    return enabled;
+}
+
 // Debug only                                                       {{{1
 // ---------------------------------------------------------------------
 
@@ -252,6 +404,7 @@ void setupDebug()
 
 void deinitDebug()
 {
+    stopDebugTrace();
     debugFile.deinit();
 }
 
@@ -354,9 +507,7 @@ std::ofstream &DebugFile::currentTime()
 
 std::ostream &DebugLog( DebugLevel lev, DebugClass cl )
 {
-    // Error are always logged, they are important,
-    // Messages from D_MAIN come from debugmsg and are equally important.
-    if( ( ( lev & debugLevel ) && ( cl & debugClass ) ) || lev & D_ERROR || cl & D_MAIN ) {
+    if( isLogged( lev, cl ) ) {
         debugFile.file << std::endl;
         debugFile.currentTime() << " ";
         if( lev != debugLevel ) {
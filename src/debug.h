@@ -25,23 +25,35 @@
  * If a single source file contains mostly messages for the same debug class
  * (e.g. mapgen.cpp), create and use the macro dbg.
  *
+ *      DebugLogLazy
+ * Same as DebugLog, but used as a statement only. The values written into the
+ * stream are not even evaluated if the message would be discarded, so it is
+ * fine to use in code that runs often. Messages of levels that cannot be
+ * enabled in a RELEASE build are removed by the compiler altogether.
+ *
  *      dbg
  * Usually a single source contains only debug messages for a single debug class
  * (e.g. mapgen.cpp contains only messages for D_MAP_GEN, npcmove.cpp only D_NPC).
  * Those files contain a macro at top:
-#define dbg(x) DebugLog((DebugLevel)(x), D_NPC) << __FILE__ << ":" << __LINE__ << ": "
+#define dbg(x) DebugLogLazy((DebugLevel)(x), D_NPC) << __FILE__ << ":" << __LINE__ << ": "
  * It allows to call the debug system and just supply the debug level, the debug
  * class is automatically inserted as it is the same for the whole file. Also this
  * adds the file name and the line of the statement to the debug message.
  * This can be replicated in any source file, just copy the above macro and change
  * D_NPC to the debug class to use. Don't add this macro to a header file
  * as the debug class is source file specific.
- * As dbg calls DebugLog, it returns the stream, its usage is the same.
+ * As dbg calls DebugLogLazy, its usage is the same.
+ *
+ *      startDebugTrace
+ * For profiling sessions: records every DebugLogLazy (and so dbg) statement that
+ * is reached, logged or not, as a small binary record with a time stamp. See
+ * startDebugTrace for the format.
  */
 
 // Includes                                                         {{{1
 // ---------------------------------------------------------------------
 #include <iostream>
+#include <string>
 #include <vector>
 
 #define STRING2(x) #x
@@ -65,6 +77,12 @@
 void realDebugmsg( const char *filename, const char *line, const char *funcname, const char *mes,
                    ... );
 
+/**
+ * debugmsg on any thread but the main one only queues the message. This shows the
+ * queued messages, it does nothing unless called from the main thread.
+ */
+void flush_deferred_debugmsgs();
+
 // Enumerations                                                     {{{1
 // ---------------------------------------------------------------------
 
@@ -123,12 +141,49 @@ void limitDebugLevel( int );
  */
 void limitDebugClass( int );
 
+/**
+ * Opens @p filename and records every DebugLogLazy statement that is reached into it,
+ * until stopDebugTrace is called. Returns false if the file could not be opened.
+ * The file starts with the 8 bytes "CDDATRC1", followed by records, all numbers
+ * are in native byte order:
+ * - 'F', uint32 file id, uint32 length, the characters of a source file name.
+ *   Written once for each file id before its first use.
+ * - 'E', uint64 microseconds since the trace was started, uint32 file id,
+ *   uint32 line, uint32 DebugLevel, uint32 DebugClass, uint8 1 if the message was logged.
+ */
+bool startDebugTrace( const std::string &filename );
+void stopDebugTrace();
+
 // Debug Only                                                       {{{1
 // ---------------------------------------------------------------------
 
 // See documentation at the top.
 std::ostream &DebugLog( DebugLevel, DebugClass );
 
+/**
+ * Whether DebugLog would write a message of this level and class. Also adds a record
+ * to the debug trace if one is active, @p file and @p line identify the caller.
+ */
+bool debugLogEnabled( DebugLevel, DebugClass, const char *file, int line );
+
+#if !defined(RELEASE) || defined(DEBUG) || defined(DEBUG_INFO)
+#define DEBUG_COMPILED_INFO D_INFO
+#else
+#define DEBUG_COMPILED_INFO 0
+#endif
+#if !defined(RELEASE) || defined(DEBUG) || defined(DEBUG_PEDANTIC_INFO)
+#define DEBUG_COMPILED_PEDANTIC_INFO D_PEDANTIC_INFO
+#else
+#define DEBUG_COMPILED_PEDANTIC_INFO 0
+#endif
+/** Debug levels that DebugLogLazy keeps in the binary. */
+#define DEBUG_COMPILED_LEVELS (D_WARNING | D_ERROR | DEBUG_COMPILED_INFO | DEBUG_COMPILED_PEDANTIC_INFO)
+
+// See documentation at the top.
+#define DebugLogLazy(lev, cl) \
+    if( !( (lev) & DEBUG_COMPILED_LEVELS ) || !debugLogEnabled( (lev), (cl), __FILE__, __LINE__ ) ) {} else \
+        DebugLog( (lev), (cl) )
+
 // OStream operators                                                {{{1
 // ---------------------------------------------------------------------
 
@@ -41,7 +41,7 @@
 #include <cstring>
 #include "debug.h"
 
-#define dbg(x) DebugLog((DebugLevel)(x),D_GAME) << __FILE__ << ":" << __LINE__ << ": "
+#define dbg(x) DebugLogLazy((DebugLevel)(x),D_GAME) << __FILE__ << ":" << __LINE__ << ": "
 #define maplim 132
 #define pinbounds(p) ( p.x >= 0 && p.x < maplim && p.y >= 0 && p.y < maplim)
 
@@ -1682,10 +1682,11 @@ int editmap::mapgen_preview( real_coords &tc, uimenu &gmenu )
 
     // Coordinates of the overmap terrain that should be generated.
     const point omt_pos = ms_to_omt_copy( tc.abs_pos );
-    oter_id &omt_ref = overmap_buffer.ter( omt_pos.x, omt_pos.y, target.z );
+    const tripoint omt( omt_pos.x, omt_pos.y, target.z );
     // Copy to store the original value, to restore it upon canceling
-    const oter_id orig_oters = omt_ref;
-    omt_ref = oter_id( gmenu.ret );
+    const oter_id orig_oters = overmap_buffer.ter( omt );
+    oter_id omt_ref = oter_id( gmenu.ret );
+    overmap_buffer.ter_set( omt, omt_ref );
     tinymap tmpmap;
     // TODO: add a do-not-save-generated-submaps parameter
     // TODO: keep track of generated submaps to delete them properly and to avoid memory leaks
@@ -1722,6 +1723,7 @@ int editmap::mapgen_preview( real_coords &tc, uimenu &gmenu )
         if( gmenu.selected != lastsel ) {
             lastsel = gmenu.selected;
             omt_ref = oter_id( gmenu.selected );
+            overmap_buffer.ter_set( omt, omt_ref );
             cleartmpmap( tmpmap );
             tmpmap.generate( omt_pos.x * 2, omt_pos.y * 2, target.z, calendar::turn );
             showpreview = true;
@@ -1796,9 +1798,10 @@ int editmap::mapgen_preview( real_coords &tc, uimenu &gmenu )
                                 spawns_todo++;
                             }
 
-                            for( int sx = 0; sx < 12; sx++ ) {  // copy fields
+                            for( int sx = 0; sx < 12; sx++ ) {  // copy fields and radiation
                                 for( int sy = 0; sy < 12; sy++ ) {
-                                    destsm->fld[sx][sy] = srcsm->fld[sx][sy];
+                                    destsm->get_field( sx, sy ) = srcsm->get_field( sx, sy );
+                                    destsm->set_radiation( sx, sy, srcsm->get_radiation( sx, sy ) );
                                 }
                             }
                             destsm->field_count = srcsm->field_count; // and count
@@ -1806,14 +1809,9 @@ int editmap::mapgen_preview( real_coords &tc, uimenu &gmenu )
                             std::memcpy( destsm->ter, srcsm->ter, sizeof( srcsm->ter ) ); // terrain
                             std::memcpy( destsm->frn, srcsm->frn, sizeof( srcsm->frn ) ); // furniture
                             std::memcpy( destsm->trp, srcsm->trp, sizeof( srcsm->trp ) ); // traps
-                            std::memcpy( destsm->rad, srcsm->rad, sizeof( srcsm->rad ) ); // radiation
                             std::memcpy( destsm->lum, srcsm->lum, sizeof( srcsm->lum ) ); // emissive items
-                            for( int x = 0; x < SEEX; ++x ) {
-                                for( int y = 0; y < SEEY; ++y ) {
-                                    destsm->itm[x][y].swap( srcsm->itm[x][y] );
-                                    destsm->cosmetics[x][y].swap( srcsm->cosmetics[x][y] );
-                                }
-                            }
+                            std::swap( destsm->itm, srcsm->itm );
+                            destsm->cosmetics.swap( srcsm->cosmetics );
 
                             // various misc variables
                             destsm->active_items = srcsm->active_items;
@@ -1862,7 +1860,7 @@ int editmap::mapgen_preview( real_coords &tc, uimenu &gmenu )
     update_view( true );
     if( gpmenu.ret != 2 &&  // we didn't apply, so restore the original om_ter
         gpmenu.ret != 3 ) { // chose to change oter_id but not apply mapgen
-        omt_ref = orig_oters;
+        overmap_buffer.ter_set( omt, orig_oters );
     }
     gmenu.border_color = c_magenta;
     gmenu.hilight_color = h_white;
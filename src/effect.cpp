@@ -5,6 +5,9 @@
 #include "player.h"
 #include "translations.h"
 #include "messages.h"
+#include "interned_id.h"
+#include "thread_pool.h"
+#include <algorithm>
 #include <map>
 #include <sstream>
 
@@ -33,6 +36,24 @@ bool string_id<effect_type>::is_valid() const
 template<>
 const efftype_id string_id<effect_type>::NULL_ID( "null" );
 
+/** Dense ids of effect types, for @ref effect_storage. They are interned and never change,
+ * so they can be cached in the id itself even across reloading the effect types.
+ * Inside @ref parallel_for other threads may read the same (static) id, so it is only
+ * looked up there. All loaded effect types are interned at load time and the interner
+ * is frozen by @ref finalize_effect_types, so that lookup does not lock. An effect type
+ * that was never loaded gets an invalid id there, which no creature can have. */
+template<>
+int_id<effect_type> string_id<effect_type>::id() const
+{
+    if( get_cid().to_i() < 0 ) {
+        if( in_parallel_for() ) {
+            return int_id<effect_type>( interned_id<effect_type>::find( str() ).to_i() );
+        }
+        set_cid( int_id<effect_type>( interned_id<effect_type>( str() ).to_i() ) );
+    }
+    return get_cid();
+}
+
 const efftype_id effect_weed_high( "weed_high" );
 
 void weed_msg(player *p) {
@@ -625,14 +646,14 @@ void effect::decay(std::vector<efftype_id> &rem_ids, std::vector<body_part> &rem
     // Decay duration if not permanent
     if (!is_permanent()) {
         duration -= 1;
-        add_msg( m_debug, "ID: %s, Duration %d", get_id().c_str(), duration );
+        add_msg_debug( "ID: %s, Duration %d", get_id().c_str(), duration );
     }
     // Store current intensity for comparison later
     int tmp_int = intensity;
 
     // Fix bad intensities
     if (intensity < 1) {
-        add_msg( m_debug, "Bad intensity, ID: %s", get_id().c_str() );
+        add_msg_debug( "Bad intensity, ID: %s", get_id().c_str() );
         intensity = 1;
     } else if (intensity > 1) {
         // Decay intensity if necessary
@@ -1190,6 +1211,8 @@ void load_effect_type(JsonObject &jo)
     new_etype.load_mod_data(jo, "base_mods");
     new_etype.load_mod_data(jo, "scaling_mods");
 
+    // Interned now, so that lookups from parallel_for find it.
+    new_etype.id.id();
     effect_types[new_etype.id] = new_etype;
 
 }
@@ -1197,6 +1220,12 @@ void load_effect_type(JsonObject &jo)
 void reset_effect_types()
 {
     effect_types.clear();
+    interned_id<effect_type>::thaw();
+}
+
+void finalize_effect_types()
+{
+    interned_id<effect_type>::freeze();
 }
 
 void effect_type::register_ma_buff_effect( const effect_type &eff )
@@ -1205,6 +1234,8 @@ void effect_type::register_ma_buff_effect( const effect_type &eff )
         debugmsg( "effect id %s of a martial art buff is already used as id for an effect" );
         return;
     }
+    // See load_effect_type
+    eff.id.id();
     effect_types.insert( std::make_pair( eff.id, eff ) );
 }
 
@@ -1230,3 +1261,104 @@ void effect::deserialize(JsonIn &jsin)
     intensity = jo.get_int("intensity");
     start_turn = jo.get_int("start_turn", 0);
 }
+
+effect_storage::effect_storage( const effect_storage &other )
+{
+    *this = other;
+}
+
+effect_storage &effect_storage::operator=( const effect_storage &other )
+{
+    if( this == &other ) {
+        return *this;
+    }
+    entries.clear();
+    entries.reserve( other.entries.size() );
+    for( const auto &e : other.entries ) {
+        entries.push_back( entry{ e.type, e.bp, std::unique_ptr<effect>( new effect( *e.eff ) ) } );
+    }
+    types = other.types;
+    changes++;
+    return *this;
+}
+
+size_t effect_storage::lower_bound( int type, body_part bp ) const
+{
+    return std::lower_bound( entries.begin(), entries.end(), std::make_pair( type, bp ),
+    []( const entry & e, const std::pair<int, body_part> &key ) {
+        return std::make_pair( e.type, e.bp ) < key;
+    } ) - entries.begin();
+}
+
+size_t effect_storage::upper_bound( int type, body_part bp ) const
+{
+    return std::upper_bound( entries.begin(), entries.end(), std::make_pair( type, bp ),
+    []( const std::pair<int, body_part> &key, const entry & e ) {
+        return key < std::make_pair( e.type, e.bp );
+    } ) - entries.begin();
+}
+
+void effect_storage::update_type( int type )
+{
+    if( static_cast<size_t>( type ) >= types.size() ) {
+        types.resize( type + 1, false );
+    }
+    const size_t i = lower_bound( type, body_part( 0 ) );
+    types[type] = i < entries.size() && entries[i].type == type;
+}
+
+effect *effect_storage::find( const efftype_id &id, body_part bp )
+{
+    return const_cast<effect *>( const_cast<const effect_storage *>( this )->find( id, bp ) );
+}
+
+const effect *effect_storage::find( const efftype_id &id, body_part bp ) const
+{
+    if( !has( id ) ) {
+        return nullptr;
+    }
+    const int type = id.id().to_i();
+    const size_t i = lower_bound( type, bp );
+    if( i < entries.size() && entries[i].type == type && entries[i].bp == bp ) {
+        return entries[i].eff.get();
+    }
+    return nullptr;
+}
+
+effect &effect_storage::set( const efftype_id &id, body_part bp, const effect &eff )
+{
+    const int type = id.id().to_i();
+    const size_t i = lower_bound( type, bp );
+    if( i < entries.size() && entries[i].type == type && entries[i].bp == bp ) {
+        *entries[i].eff = eff;
+        return *entries[i].eff;
+    }
+    entries.insert( entries.begin() + i, entry{ type, bp, std::unique_ptr<effect>( new effect( eff ) ) } );
+    update_type( type );
+    changes++;
+    return *entries[i].eff;
+}
+
+bool effect_storage::erase( const efftype_id &id, body_part bp )
+{
+    if( !has( id ) ) {
+        return false;
+    }
+    const int type = id.id().to_i();
+    auto first = entries.begin() + lower_bound( type, bp == num_bp ? body_part( 0 ) : bp );
+    auto last = entries.begin() + upper_bound( type, bp );
+    if( first == last ) {
+        return false;
+    }
+    entries.erase( first, last );
+    update_type( type );
+    changes++;
+    return true;
+}
+
+void effect_storage::clear()
+{
+    entries.clear();
+    types.clear();
+    changes++;
+}
@@ -5,8 +5,11 @@
 #include "json.h"
 #include "enums.h"
 #include "string_id.h"
+#include "int_id.h"
+#include <memory>
 #include <unordered_map>
 #include <tuple>
+#include <vector>
 
 class effect_type;
 class Creature;
@@ -14,6 +17,10 @@ class player;
 enum game_message_type : int;
 using efftype_id = string_id<effect_type>;
 
+/** Dense id of the effect type, used by @ref effect_storage. */
+template<>
+int_id<effect_type> string_id<effect_type>::id() const;
+
 /** Handles the large variety of weed messages. */
 void weed_msg(player *p);
 
@@ -262,7 +269,104 @@ class effect : public JsonSerializer, public JsonDeserializer
 
 };
 
+/**
+ * The effects on a creature, at most one for each effect type and body part (num_bp for
+ * untargeted effects). They are kept sorted by type and body part in one small vector,
+ * and a bit for each effect type answers "any effect of this type?" without a search,
+ * which is what most queries are.
+ * Each effect is allocated on its own, so references to it stay valid while other
+ * effects are added and removed, as they did when this was a map.
+ */
+class effect_storage
+{
+    public:
+        effect_storage() = default;
+        effect_storage( const effect_storage &other );
+        effect_storage( effect_storage && ) = default;
+        effect_storage &operator=( const effect_storage &other );
+        effect_storage &operator=( effect_storage && ) = default;
+
+        bool empty() const {
+            return entries.empty();
+        }
+        size_t size() const {
+            return entries.size();
+        }
+        /** Changes whenever an effect is added or removed. */
+        unsigned long revision() const {
+            return changes;
+        }
+
+        /** Whether there is an effect of type @p id on any body part (or untargeted). */
+        bool has( const efftype_id &id ) const {
+            const size_t type = id.id().to_i();
+            return type < types.size() && types[type];
+        }
+        /** The effect of type @p id on exactly @p bp, or nullptr. */
+        effect *find( const efftype_id &id, body_part bp );
+        const effect *find( const efftype_id &id, body_part bp ) const;
+        /** Stores @p eff as the effect of type @p id on @p bp, replacing any previous one. */
+        effect &set( const efftype_id &id, body_part bp, const effect &eff );
+        /**
+         * Removes the effect of type @p id on @p bp, or all effects of that type if @p bp
+         * is num_bp. Returns whether anything was removed.
+         */
+        bool erase( const efftype_id &id, body_part bp = num_bp );
+        void clear();
+
+        /**
+         * Calls @p func with each effect, in order of type and body part. @p func may add
+         * and remove other effects, those added after the current one are visited as well.
+         */
+        template<typename Func>
+        void for_each( Func func ) {
+            for( size_t i = 0; i < entries.size(); ) {
+                const int type = entries[i].type;
+                const body_part bp = entries[i].bp;
+                const unsigned long prev_changes = changes;
+                func( *entries[i].eff );
+                // Continue after the visited effect, which may have moved.
+                i = prev_changes == changes ? i + 1 : upper_bound( type, bp );
+            }
+        }
+        template<typename Func>
+        void for_each( Func func ) const {
+            for( const auto &e : entries ) {
+                func( static_cast<const effect &>( *e.eff ) );
+            }
+        }
+        /** Calls @p func with each body part that has an effect of type @p id. */
+        template<typename Func>
+        void for_each_bp( const efftype_id &id, Func func ) const {
+            const int type = id.id().to_i();
+            for( size_t i = lower_bound( type, body_part( 0 ) );
+                 i < entries.size() && entries[i].type == type; i++ ) {
+                func( entries[i].bp );
+            }
+        }
+
+    private:
+        struct entry {
+            int type;
+            body_part bp;
+            std::unique_ptr<effect> eff;
+        };
+        std::vector<entry> entries;
+        /** Indexed by effect type id, set if there is any effect of that type. */
+        std::vector<bool> types;
+        /** Counts additions and removals, so @ref for_each notices them. */
+        unsigned long changes = 0;
+
+        /** Index of the first entry not ordered before ( type, bp ). */
+        size_t lower_bound( int type, body_part bp ) const;
+        /** Index of the first entry ordered after ( type, bp ). */
+        size_t upper_bound( int type, body_part bp ) const;
+        void update_type( int type );
+};
+
 void load_effect_type( JsonObject &jo );
 void reset_effect_types();
+/** Called once all effect types (including martial art buffs) are loaded. */
+void finalize_effect_types();
 
 #endif
@@ -206,7 +206,7 @@ void game::do_blast( const tripoint &p, const float power,
             continue;
         }
 
-        add_msg( m_debug, "Blast hits %s with force %.1f",
+        add_msg_debug( "Blast hits %s with force %.1f",
                  critter->disp_name().c_str(), force );
 
         player *pl = dynamic_cast<player *>( critter );
@@ -216,7 +216,7 @@ void game::do_blast( const tripoint &p, const float power,
             const int actual_dmg = rng( dmg * 2, dmg * 3 );
             critter->apply_damage( nullptr, bp_torso, actual_dmg );
             critter->check_dead_state();
-            add_msg( m_debug, "Blast hits %s for %d damage", critter->disp_name().c_str(), actual_dmg );
+            add_msg_debug( "Blast hits %s for %d damage", critter->disp_name().c_str(), actual_dmg );
             continue;
         }
 
@@ -249,7 +249,7 @@ void game::do_blast( const tripoint &p, const float power,
             const auto result = pl->deal_damage( nullptr, blp.bp, dmg_instance );
             const int res_dmg = result.total_damage();
 
-            add_msg( m_debug, "%s for %d raw, %d actual",
+            add_msg_debug( "%s for %d raw, %d actual",
                      hit_part_name.c_str(), part_dam, res_dmg );
             if( res_dmg > 0 ) {
                 pl->add_msg_if_player( m_bad, _( "Your %s is hit for %d damage!" ),
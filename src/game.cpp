@@ -87,6 +87,8 @@
 #include "item_factory.h"
 #include "scent_map.h"
 #include "safemode_ui.h"
+#include "turn_timer.h"
+#include "thread_pool.h"
 
 #include <map>
 #include <set>
@@ -115,7 +117,7 @@
 #   include <tchar.h>
 #endif
 
-#define dbg(x) DebugLog((DebugLevel)(x),D_GAME) << __FILE__ << ":" << __LINE__ << ": "
+#define dbg(x) DebugLogLazy((DebugLevel)(x),D_GAME) << __FILE__ << ":" << __LINE__ << ": "
 
 const int core_version = 3;
 
@@ -164,6 +166,11 @@ const efftype_id effect_tied( "tied" );
 const efftype_id effect_visuals( "visuals" );
 const efftype_id effect_winded( "winded" );
 
+static const trait_iid trait_PRED2( "PRED2" );
+static const trait_iid trait_PRED3( "PRED3" );
+static const trait_iid trait_PRED4( "PRED4" );
+static const bionic_iid bio_memory( "bio_memory" );
+
 void advanced_inv(); // player_activity.cpp
 void intro();
 
@@ -222,6 +229,7 @@ game::game() :
     u( *u_ptr ),
     scent( *scent_ptr ),
     critter_tracker( new Creature_tracker() ),
+    threat_map( new npc_threat_map() ),
     weather( WEATHER_CLEAR ),
     lightning_active( false ),
     weather_precise( new w_point() ),
@@ -786,6 +794,7 @@ bool game::start_game( std::string worldname )
     }
 
     seed = rand();
+    rng_set_world_seed( seed );
     new_game = true;
     start_calendar();
     nextweather = calendar::turn;
@@ -922,7 +931,7 @@ void game::load_npcs()
         }
 
         const tripoint p = temp->global_sm_location();
-        add_msg( m_debug, "game::load_npcs: Spawning static NPC, %d:%d:%d (%d:%d:%d)",
+        add_msg_debug( "game::load_npcs: Spawning static NPC, %d:%d:%d (%d:%d:%d)",
                  get_levx(), get_levy(), get_levz(), p.x, p.y, p.z );
         temp->place_on_map();
         if( !m.inbounds( temp->pos() ) ) {
@@ -1396,20 +1405,25 @@ bool game::do_turn()
     if( is_game_over() ) {
         return cleanup_at_end();
     }
+    turn_timer phases;
     // Actual stuff
     if( new_game ) {
         new_game = false;
     } else {
-        gamemode->per_turn();
+        if( gamemode ) {
+            gamemode->per_turn();
+        }
         calendar::turn.increment();
     }
     process_events();
     mission::process_all();
+    phases.lap( "events" );
     if( calendar::turn.hours() == 0 && calendar::turn.minutes() == 0 &&
         calendar::turn.seconds() == 0 ) { // Midnight!
         overmap_buffer.process_mongroups();
         lua_callback( "on_day_passed" );
     }
+    lua_hook_turn();
 
     // Move hordes every 5 min
     if( calendar::once_every( MINUTES( 5 ) ) ) {
@@ -1418,6 +1432,7 @@ bool game::do_turn()
         // make them spawn in invisible areas only.
         m.spawn_monsters( false );
     }
+    phases.lap( "hordes" );
 
     u.update_body();
 
@@ -1430,6 +1445,7 @@ bool game::do_turn()
 
     update_weather();
     reset_light_level();
+    phases.lap( "weather" );
 
     // The following happens when we stay still; 10/40 minutes overdue for spawn
     if( ( !u.has_trait( "INCONSPICUOUS" ) && calendar::turn > nextspawn + 100 ) ||
@@ -1476,6 +1492,7 @@ bool game::do_turn()
             handle_key_blocking_activity();
         }
     }
+    phases.lap( "player_action" );
 
     if( driving_view_offset.x != 0 || driving_view_offset.y != 0 ) {
         // Still have a view offset, but might not be driving anymore,
@@ -1497,12 +1514,15 @@ bool game::do_turn()
         overmap_buffer.set_scent( u.global_omt_location(),  u.scent );
     }
     scent.update( u.pos(), m );
+    phases.lap( "scent" );
 
     // We need floor cache before checking falling 'n stuff
     m.build_floor_caches();
 
     m.process_falling();
+    phases.lap( "falling" );
     m.vehmove();
+    phases.lap( "vehmove" );
 
     // Process power and fuel consumption for all vehicles, including off-map ones.
     // m.vehmove used to do this, but now it only give them moves instead.
@@ -1519,17 +1539,23 @@ bool game::do_turn()
             veh->idle( in_bubble_z && m.inbounds( in_reality.x, in_reality.y ) );
         }
     }
+    phases.lap( "vehicle_power" );
     m.process_fields();
+    phases.lap( "fields" );
     m.process_active_items();
+    phases.lap( "active_items" );
     m.creature_in_field( u );
 
     // Apply sounds from previous turn to monster and NPC AI.
     sounds::process_sounds();
+    phases.lap( "sounds" );
     // Update vision caches for monsters. If this turns out to be expensive,
     // consider a stripped down cache just for monsters.
     m.build_map_cache( get_levz(), true );
+    phases.lap( "map_cache" );
     monmove();
     update_stair_monsters();
+    phases.lap( "monmove" );
     u.process_turn();
     if( u.moves < 0 ) {
         draw();
@@ -1561,6 +1587,7 @@ bool game::do_turn()
     sfx::remove_hearing_loss();
     sfx::do_danger_music();
     sfx::do_fatigue();
+    phases.lap( "player_upkeep" );
 
     return false;
 }
@@ -1585,9 +1612,9 @@ void game::rustCheck()
         }
 
         if( aSkill.is_combat_skill() &&
-            ( ( u.has_trait( "PRED2" ) && one_in( 4 ) ) ||
-              ( u.has_trait( "PRED3" ) && one_in( 2 ) ) ||
-              ( u.has_trait( "PRED4" ) && x_in_y( 2, 3 ) ) ) ) {
+            ( ( u.has_trait( trait_PRED2 ) && one_in( 4 ) ) ||
+              ( u.has_trait( trait_PRED3 ) && one_in( 2 ) ) ||
+              ( u.has_trait( trait_PRED4 ) && x_in_y( 2, 3 ) ) ) ) {
             // Their brain is optimized to remember this
             if( one_in( 15600 ) ) {
                 // They've already passed the roll to avoid rust at
@@ -1605,7 +1632,7 @@ void game::rustCheck()
             continue;
         }
 
-        bool charged_bio_mem = u.has_active_bionic( "bio_memory" ) && u.power_level > 25;
+        bool charged_bio_mem = u.has_active_bionic( bio_memory ) && u.power_level > 25;
         int oldSkillLevel = u.get_skill_level( aSkill.ident() );
 
         if( u.get_skill_level( aSkill.ident() ).rust( charged_bio_mem ) ) {
@@ -6300,7 +6327,7 @@ void game::cleanup_dead()
     }
 }
 
-void game::monmove()
+void game::monmove( const bool first_plans )
 {
     cleanup_dead();
 
@@ -6309,23 +6336,166 @@ void game::monmove()
 
     mfactions monster_factions;
     const auto &playerfaction = mfaction_str_id( "player" );
-    for( size_t i = 0; i < num_zombies(); i++ ) {
+    const auto update_factions = [&]() {
         // The first time through, and any time the map has been shifted,
         // recalculate monster factions.
-        if( cached_lev != m.get_abs_sub() ) {
-            // monster::plan() needs to know about all monsters on the same team as the monster.
-            monster_factions.clear();
-            for( int i = 0, numz = num_zombies(); i < numz; i++ ) {
-                monster &critter = zombie( i );
-                if( critter.friendly == 0 ) {
-                    // Only 1 faction per mon at the moment.
-                    monster_factions[ critter.faction ].insert( i );
-                } else {
-                    monster_factions[ playerfaction ].insert( i );
+        if( cached_lev == m.get_abs_sub() ) {
+            return;
+        }
+        // monster::plan() needs to know about all monsters on the same team as the monster.
+        monster_factions.clear();
+        for( int i = 0, numz = num_zombies(); i < numz; i++ ) {
+            monster &critter = zombie( i );
+            if( critter.friendly == 0 ) {
+                // Only 1 faction per mon at the moment.
+                monster_factions[ critter.faction ].insert( i );
+            } else {
+                monster_factions[ playerfaction ].insert( i );
+            }
+        }
+        cached_lev = m.get_abs_sub();
+    };
+    update_factions();
+
+    // Looking for targets is most of the work of big hordes, so each monster picks its first
+    // target up front, spread over all cores, from the state at the start of the turn. The
+    // plans are carried out below one monster at a time in the usual order. A monster only
+    // uses its first plan if nothing plan_target looks at has changed before its turn (see
+    // first_plan_holds), otherwise it plans again, so the outcome is the same as planning
+    // on each turn.
+
+    /** What plan_target looks at of a monster, as the planning monster or as a candidate target. */
+    struct plan_input {
+        tripoint pos;
+        int anger = 0;
+        int morale = 0;
+        int friendly = 0;
+        int wandf = 0;
+        bool underwater = false;
+        bool dead = false;
+        unsigned long effects = 0;
+
+        plan_input() = default;
+        plan_input( const monster &critter ) : pos( critter.pos() ), anger( critter.anger ),
+            morale( critter.morale ), friendly( critter.friendly ), wandf( critter.wandf ),
+            underwater( critter.underwater ), dead( critter.is_dead() ),
+            effects( critter.effects_revision() ) {
+        }
+        bool operator==( const plan_input &other ) const {
+            return pos == other.pos && anger == other.anger && morale == other.morale &&
+                   friendly == other.friendly && wandf == other.wandf &&
+                   underwater == other.underwater && dead == other.dead && effects == other.effects;
+        }
+    };
+    /** What plan_target looks at of the player and the NPCs. */
+    struct person_input {
+        tripoint pos;
+        unsigned long effects;
+        const itype *weapon;
+        int attitude;
+        bool dead;
+
+        bool operator==( const person_input &other ) const {
+            return pos == other.pos && effects == other.effects && weapon == other.weapon &&
+                   attitude == other.attitude && dead == other.dead;
+        }
+    };
+    const auto people_inputs = [this]() {
+        std::vector<person_input> res;
+        res.push_back( person_input{ u.pos(), u.effects_revision(), u.weapon.type, 0,
+                                     u.is_dead_state() } );
+        for( const npc *guy : active_npc ) {
+            res.push_back( person_input{ guy->pos(), guy->effects_revision(), guy->weapon.type,
+                                         guy->attitude, guy->is_dead_state() } );
+        }
+        return res;
+    };
+
+    struct first_plan {
+        monster_plan plan;
+        bool valid = false;
+    };
+    std::vector<first_plan> plans( first_plans ? num_zombies() : 0 );
+    std::vector<plan_input> inputs;
+    std::vector<person_input> people;
+    if( first_plans ) {
+        inputs.reserve( num_zombies() );
+        for( size_t i = 0; i < num_zombies(); i++ ) {
+            inputs.emplace_back( zombie( i ) );
+        }
+        people = people_inputs();
+        // These are filled in on first use, which must not happen on several threads at once.
+        for( int z = 0; z <= OVERMAP_HEIGHT; z++ ) {
+            natural_light_level( z );
+        }
+        parallel_for( plans.size(), [&]( size_t i ) {
+            const monster &critter = zombie( i );
+            if( critter.is_dead() || critter.has_effect( effect_controlled ) ) {
+                return;
+            }
+            plans[i].plan = critter.plan_target( monster_factions );
+            plans[i].valid = true;
+        } );
+    }
+    const tripoint planned_lev = cached_lev;
+
+    // Once found changed, a monster counts as changed for the rest of the turn.
+    std::vector<bool> changed( inputs.size(), false );
+    bool people_changed = false;
+    const auto unchanged = [&]( size_t i ) {
+        if( i >= inputs.size() ) {
+            // Spawned during the turn
+            return false;
+        }
+        if( !changed[i] && !( plan_input( zombie( i ) ) == inputs[i] ) ) {
+            changed[i] = true;
+        }
+        return !changed[i];
+    };
+    // Whether plan_target would still find the same for monster i: neither the monster nor
+    // any creature it could rate has changed. The map caches it reads are only rebuilt
+    // between turns.
+    const auto first_plan_holds = [&]( size_t i ) {
+        if( i >= plans.size() || !plans[i].valid || cached_lev != planned_lev || !unchanged( i ) ) {
+            return false;
+        }
+        const monster_plan &plan = plans[i].plan;
+        if( plan.target != nullptr && plan.target->is_dead_state() ) {
+            return false;
+        }
+        people_changed = people_changed || !( people_inputs() == people );
+        if( people_changed ) {
+            return false;
+        }
+        const monster &critter = zombie( i );
+        if( critter.friendly != 0 ) {
+            // Rates all unfriendly monsters, which any monster may have become
+            for( size_t j = 0; j < num_zombies(); j++ ) {
+                if( !unchanged( j ) ) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        const bool rates_own_faction = critter.has_flag( MF_SWARMS ) ||
+                                       critter.has_flag( MF_GROUP_MORALE );
+        for( const auto &fac : monster_factions ) {
+            const auto faction_att = critter.faction.obj().attitude( fac.first );
+            if( ( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) &&
+                !( rates_own_faction && fac.first == critter.faction ) ) {
+                continue;
+            }
+            for( const int j : fac.second ) {
+                if( !unchanged( j ) ) {
+                    return false;
                 }
             }
-            cached_lev = m.get_abs_sub();
         }
+        return true;
+    };
+
+    for( size_t i = 0; i < num_zombies(); i++ ) {
+        update_factions();
 
         monster &critter = critter_tracker->find( i );
         while( !critter.is_dead() && !critter.can_move_to( critter.pos() ) ) {
@@ -6334,7 +6504,7 @@ void game::monmove()
                            << " can't move to its location! (" << critter.posx()
                            << ":" << critter.posy() << ":" << critter.posz() << "), "
                            << m.tername( critter.posx(), critter.posy() ).c_str();
-            add_msg( m_debug, "%s can't move to its location! (%d,%d,%d), %s", critter.name().c_str(),
+            add_msg_debug( "%s can't move to its location! (%d,%d,%d), %s", critter.name().c_str(),
                      critter.posx(), critter.posy(), critter.posz(), m.tername( critter.pos() ).c_str() );
             bool okay = false;
             int xdir = rng( 1, 2 ) * 2 - 3, ydir = rng( 1, 2 ) * 2 - 3; // -1 or 1
@@ -6367,7 +6537,14 @@ void game::monmove()
             // Controlled critters don't make their own plans
             if( !critter.has_effect( effect_controlled ) ) {
                 // Formulate a path to follow
-                critter.plan( monster_factions );
+                if( first_plan_holds( i ) ) {
+                    critter.apply_plan( plans[i].plan );
+                } else {
+                    critter.plan( monster_factions );
+                }
+                if( i < plans.size() ) {
+                    plans[i].valid = false;
+                }
             }
             critter.move(); // Move one square, possibly hit u
             critter.process_triggers();
@@ -6406,6 +6583,7 @@ void game::monmove()
     }
 
     // Now, do active NPCs.
+    threat_map->build();
     for( auto np : active_npc ) {
         if( np->is_dead() ) {
             continue;
@@ -6443,6 +6621,7 @@ void game::monmove()
             np->update_body();
         }
     }
+    threat_map->clear();
     cleanup_dead();
 }
 
@@ -7051,7 +7230,12 @@ bool game::add_zombie( monster &critter, bool pin_upgrade )
     }
 
     critter.last_updated = calendar::turn;
-    return critter_tracker->add( critter );
+    if( !critter_tracker->add( critter ) ) {
+        return false;
+    }
+    // The tracker keeps a copy, hand that one to Lua.
+    lua_hook_monster_spawn( zombie( num_zombies() - 1 ) );
+    return true;
 }
 
 size_t game::num_zombies() const
@@ -9174,7 +9358,7 @@ tripoint game::look_around( WINDOW *w_info, const tripoint &start_point,
                 new_levz = -OVERMAP_DEPTH;
             }
 
-            add_msg( m_debug, "levx: %d, levy: %d, levz :%d", get_levx(), get_levy(), new_levz );
+            add_msg_debug( "levx: %d, levy: %d, levz :%d", get_levx(), get_levy(), new_levz );
             u.view_offset.z = new_levz - u.posz();
             lp.z = new_levz;
             refresh_all();
@@ -10344,7 +10528,7 @@ bool game::consume_liquid( item &liquid, const int radius )
     return original_charges != liquid.charges;
 }
 
-bool game::handle_liquid_from_ground( std::list<item>::iterator on_ground, const tripoint &pos,
+bool game::handle_liquid_from_ground( item_list::iterator on_ground, const tripoint &pos,
                                       const int radius )
 {
     // TODO: not all code paths on handle_liquid consume move points, fix that.
@@ -13638,6 +13822,10 @@ void game::update_map( int &x, int &y )
     // as "current z-level"
     u.setpos( tripoint( x, y, get_levz() ) );
 
+    // Have the surrounding overmaps ready before the player walks onto them.
+    const tripoint omt = u.global_omt_location();
+    overmap_buffer.pregenerate( omt_to_om_copy( point( omt.x, omt.y ) ) );
+
     // Update what parts of the world map we can see
     update_overmap_seen();
 }
@@ -14148,7 +14336,7 @@ void game::nuke( const tripoint &p )
         }
     }
     tmpmap.save();
-    overmap_buffer.ter( x, y, 0 ) = oter_id( "crater" );
+    overmap_buffer.ter_set( tripoint( x, y, 0 ), oter_id( "crater" ) );
     // Kill any npcs on that omap location.
     std::vector<npc *> npcs = overmap_buffer.get_npcs_near_omt( x, y, 0, 0 );
     for( auto &npc : npcs ) {
@@ -7,6 +7,7 @@
 #include "posix_time.h"
 #include "int_id.h"
 #include "item_location.h"
+#include "item_stack.h"
 #include "cursesdef.h"
 
 #include <vector>
@@ -99,6 +100,7 @@ class npc;
 class monster;
 class vehicle;
 class Creature_tracker;
+class npc_threat_map;
 class calendar;
 class scenario;
 class DynamicDataLoader;
@@ -222,6 +224,8 @@ class game
         scent_map &scent;
 
         std::unique_ptr<Creature_tracker> critter_tracker;
+        /** Built by @ref monmove for the NPCs, empty at any other time. */
+        std::unique_ptr<npc_threat_map> threat_map;
         /**
          * Add an entry to @ref events. For further information see event.h
          * @param type Type of event.
@@ -591,7 +595,7 @@ class game
          * The iterator is invalidated in that case. Otherwise the item remains but may have
          * fewer charges.
          */
-        bool handle_liquid_from_ground( std::list<item>::iterator on_ground, const tripoint &pos, int radius = 0 );
+        bool handle_liquid_from_ground( item_list::iterator on_ground, const tripoint &pos, int radius = 0 );
 
         /**
          * Handle liquid from inside a container item. The function also handles consuming move points.
@@ -845,7 +849,14 @@ private:
 
         // Routine loop functions, approximately in order of execution
         void cleanup_dead();     // Delete any dead NPCs/monsters
-        void monmove();          // Monster movement
+public:
+        /**
+         * Monster movement. With @p first_plans, the first target of each monster is planned
+         * up front on all cores, otherwise each monster plans on its turn. The results are the
+         * same, the monsters only use a plan made up front if nothing it depends on changed.
+         */
+        void monmove( bool first_plans = true );
+private:
         void rustCheck();        // Degrades practice levels
         void process_events();   // Processes and enacts long-term events
         void process_activity(); // Processes and enacts the player's activity
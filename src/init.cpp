@@ -357,6 +357,9 @@ void DynamicDataLoader::unload_data()
     gates::reset();
     reset_overlay_ordering();
     npc_class::reset_npc_classes();
+    // Reloaded data may intern new trait and bionic ids
+    trait_iid::thaw();
+    bionic_iid::thaw();
 
     // TODO:
     //    NameGenerator::generator().clear_names();
@@ -379,8 +382,12 @@ void DynamicDataLoader::finalize_loaded_data()
     monfactions::finalize();
     recipe_dictionary::finalize();
     finialize_martial_arts();
+    finalize_effect_types();
     finalize_constructions();
     npc_class::finalize_all();
+    // All trait and bionic ids are known now, lookups can skip the interner lock
+    trait_iid::freeze();
+    bionic_iid::freeze();
     check_consistency();
 }
 
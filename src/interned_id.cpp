@@ -0,0 +1,85 @@
+#include "interned_id.h"
+
+int string_interner::intern( const std::string &str )
+{
+    if( frozen.load( std::memory_order_acquire ) ) {
+        const auto iter = ids.find( str );
+        if( iter != ids.end() ) {
+            return iter->second;
+        }
+    }
+    std::lock_guard<std::mutex> lock( mutex );
+    const auto iter = ids.find( str );
+    if( iter != ids.end() ) {
+        return iter->second;
+    }
+    if( !frozen.load( std::memory_order_relaxed ) ) {
+        const int id = strings.size();
+        strings.push_back( str );
+        ids.emplace( str, id );
+        return id;
+    }
+    // Other threads may be reading ids and strings without the lock.
+    const auto late_iter = late_ids.find( str );
+    if( late_iter != late_ids.end() ) {
+        return late_iter->second;
+    }
+    const int id = strings.size() + late_strings.size();
+    late_strings.push_back( str );
+    late_ids.emplace( str, id );
+    return id;
+}
+
+int string_interner::find( const std::string &str ) const
+{
+    if( frozen.load( std::memory_order_acquire ) ) {
+        const auto iter = ids.find( str );
+        if( iter != ids.end() ) {
+            return iter->second;
+        }
+    }
+    std::lock_guard<std::mutex> lock( mutex );
+    const auto iter = ids.find( str );
+    if( iter != ids.end() ) {
+        return iter->second;
+    }
+    const auto late_iter = late_ids.find( str );
+    return late_iter == late_ids.end() ? -1 : late_iter->second;
+}
+
+const std::string &string_interner::str( int id ) const
+{
+    if( frozen.load( std::memory_order_acquire ) && size_t( id ) < strings.size() ) {
+        return strings[id];
+    }
+    std::lock_guard<std::mutex> lock( mutex );
+    if( size_t( id ) < strings.size() ) {
+        return strings[id];
+    }
+    return late_strings[id - strings.size()];
+}
+
+size_t string_interner::size() const
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    return strings.size() + late_strings.size();
+}
+
+void string_interner::freeze()
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    frozen.store( true, std::memory_order_release );
+}
+
+void string_interner::thaw()
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    frozen.store( false, std::memory_order_release );
+    // Ids were handed out in order, so appending them keeps strings indexed by id.
+    for( std::string &str : late_strings ) {
+        ids.emplace( str, int( strings.size() ) );
+        strings.push_back( std::move( str ) );
+    }
+    late_strings.clear();
+    late_ids.clear();
+}
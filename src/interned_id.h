@@ -0,0 +1,112 @@
+#ifndef INTERNED_ID_H
+#define INTERNED_ID_H
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * Hands out dense integer ids for strings, in the order they are first seen.
+ * Ids are never released, so they can be used as indices into vectors and bitsets.
+ * Interning and looking up are thread safe. Once @ref freeze has been called the strings
+ * interned so far are looked up without taking the lock. Strings interned while frozen
+ * are kept apart, under the lock, until @ref thaw.
+ */
+class string_interner
+{
+    public:
+        string_interner() : frozen( false ) {}
+
+        /** Id of @p str, a new one if it has not been interned before. */
+        int intern( const std::string &str );
+        /** Id of @p str, or -1 if it has never been interned. */
+        int find( const std::string &str ) const;
+        /** The string interned as @p id, which must have been handed out by this interner. */
+        const std::string &str( int id ) const;
+        /** Number of ids handed out, all ids are below this. */
+        size_t size() const;
+
+        /** Lets lookups skip the lock, called once all game data is loaded. */
+        void freeze();
+        /** Makes lookups take the lock again, called before game data is reloaded. */
+        void thaw();
+
+    private:
+        mutable std::mutex mutex;
+        std::atomic<bool> frozen;
+        /** Not changed while frozen, so they can be read without the lock then. */
+        std::unordered_map<std::string, int> ids;
+        /** Indexed by id, a deque so references stay valid while it grows. */
+        std::deque<std::string> strings;
+        /** Strings interned while frozen, ids continue after @ref strings. */
+        std::unordered_map<std::string, int> late_ids;
+        std::deque<std::string> late_strings;
+};
+
+/**
+ * A string id interned into a dense integer, with one id space for each type T.
+ * Constructing one from a string interns the string, so keep them around (e.g. as
+ * static constants) instead of constructing them on each use. @ref find looks up an id
+ * without interning.
+ */
+template<typename T>
+class interned_id
+{
+    public:
+        typedef interned_id<T> This;
+
+        /** Constructs an invalid id, which never matches anything. */
+        interned_id() : _id( -1 ) {}
+        explicit interned_id( const std::string &str ) : _id( interner().intern( str ) ) {}
+
+        /** Id of @p str if it has been interned before, an invalid id otherwise. */
+        static This find( const std::string &str ) {
+            This res;
+            res._id = interner().find( str );
+            return res;
+        }
+        /** Number of ids of this type handed out, all valid ids are below this. */
+        static size_t count() {
+            return interner().size();
+        }
+        /** See @ref string_interner::freeze */
+        static void freeze() {
+            interner().freeze();
+        }
+        /** See @ref string_interner::thaw */
+        static void thaw() {
+            interner().thaw();
+        }
+
+        bool is_valid() const {
+            return _id >= 0;
+        }
+        int to_i() const {
+            return _id;
+        }
+        const std::string &str() const {
+            return interner().str( _id );
+        }
+
+        bool operator==( const This &rhs ) const {
+            return _id == rhs._id;
+        }
+        bool operator!=( const This &rhs ) const {
+            return _id != rhs._id;
+        }
+        bool operator<( const This &rhs ) const {
+            return _id < rhs._id;
+        }
+
+    private:
+        int _id;
+
+        static string_interner &interner() {
+            static string_interner instance;
+            return instance;
+        }
+};
+
+#endif
@@ -11,6 +11,7 @@
 #include "vehicle.h"
 #include "mapdata.h"
 #include "map_iterator.h"
+#include "visitable_inline.h"
 #include <algorithm>
 
 const invlet_wrapper inv_chars("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ!\"#&()*+./:;=@[\\]^_{|}");
@@ -34,6 +35,7 @@ inventory::inventory()
 
 invslice inventory::slice()
 {
+    index.reset();
     invslice stacks;
     for( auto &elem : items ) {
         stacks.push_back( &elem );
@@ -146,6 +148,7 @@ void inventory::sort()
 
 void inventory::clear()
 {
+    index.reset();
     items.clear();
 }
 
@@ -161,6 +164,7 @@ void inventory::add_stack(const std::list<item> newits)
  */
 void inventory::clone_stack (const std::list<item> &rhs)
 {
+    index.reset();
     std::list<item> newstack;
     for( const auto &rh : rhs ) {
         newstack.push_back( rh );
@@ -242,6 +246,7 @@ char inventory::find_usable_cached_invlet(const std::string &item_type)
 
 item &inventory::add_item(item newit, bool keep_invlet, bool assign_invlet)
 {
+    index.reset();
     bool reuse_cached_letter = false;
 
     // Avoid letters that have been manually assigned to other things.
@@ -369,7 +374,7 @@ void inventory::restack(player *p)
     }
 }
 
-static long count_charges_in_list(const itype *type, const map_stack &items)
+static long count_charges_in_list(const itype *type, const item_list &items)
 {
     for( const auto &candidate : items ) {
         if( candidate.type == type ) {
@@ -381,14 +386,17 @@ static long count_charges_in_list(const itype *type, const map_stack &items)
 
 void inventory::form_from_map( const tripoint &origin, int range, bool assign_invlet )
 {
+    index.reset();
     items.clear();
+    // Only reads the items on the map, through the accessor that doesn't allocate them
+    const map &here = g->m;
     for( const tripoint &p : g->m.points_in_radius( origin, range ) ) {
         if (g->m.has_furn( p ) && g->m.accessible_furniture( origin, p, range )) {
             const furn_t &f = g->m.furn( p ).obj();
             const itype *type = f.crafting_pseudo_item_type();
             if (type != NULL) {
                 const itype *ammo = f.crafting_ammo_item_type();
-                item furn_item( type, calendar::turn, ammo ? count_charges_in_list( ammo, g->m.i_at( p ) ) : 0 );
+                item furn_item( type, calendar::turn, ammo ? count_charges_in_list( ammo, here.i_at( p ) ) : 0 );
                 furn_item.item_tags.insert("PSEUDO");
                 add_item(furn_item);
             }
@@ -396,7 +404,7 @@ void inventory::form_from_map( const tripoint &origin, int range, bool assign_in
         if( !g->m.accessible_items( origin, p, range ) ) {
             continue;
         }
-        for (auto &i : g->m.i_at( p )) {
+        for( const auto &i : here.i_at( p ) ) {
             if (!i.made_of(LIQUID)) {
                 add_item(i, false, assign_invlet);
             }
@@ -424,7 +432,7 @@ void inventory::form_from_map( const tripoint &origin, int range, bool assign_in
         // crafting
         if (g->m.furn( p ).obj().examine == &iexamine::toilet) {
             // get water charges at location
-            auto toilet = g->m.i_at( p );
+            const auto &toilet = here.i_at( p );
             auto water = toilet.end();
             for( auto candidate = toilet.begin(); candidate != toilet.end(); ++candidate ) {
                 if( candidate->typeId() == "water" ) {
@@ -439,8 +447,8 @@ void inventory::form_from_map( const tripoint &origin, int range, bool assign_in
 
         // keg-kludge
         if (g->m.furn( p ).obj().examine == &iexamine::keg) {
-            auto liq_contained = g->m.i_at( p );
-            for( auto &i : liq_contained ) {
+            const auto &liq_contained = here.i_at( p );
+            for( const auto &i : liq_contained ) {
                 if( i.made_of(LIQUID) ) {
                     add_item(i);
                 }
@@ -556,6 +564,7 @@ void inventory::form_from_map( const tripoint &origin, int range, bool assign_in
 template<typename Locator>
 std::list<item> inventory::reduce_stack_internal(const Locator &locator, int quantity)
 {
+    index.reset();
     int pos = 0;
     std::list<item> ret;
     for (invstack::iterator iter = items.begin(); iter != items.end(); ++iter) {
@@ -599,6 +608,7 @@ item inventory::remove_item(const item *it)
 template<typename Locator>
 item inventory::remove_item_internal(const Locator &locator)
 {
+    index.reset();
     int pos = 0;
     for (invstack::iterator iter = items.begin(); iter != items.end(); ++iter) {
         if (item_matches_locator(iter->front(), locator, pos)) {
@@ -629,6 +639,7 @@ item inventory::remove_item(int position)
 
 std::list<item> inventory::remove_randomly_by_volume( const units::volume &volume )
 {
+    index.reset();
     std::list<item> result;
     units::volume volume_dropped = 0;
     while( volume_dropped < volume ) {
@@ -660,6 +671,7 @@ std::list<item> inventory::remove_randomly_by_volume( const units::volume &volum
 
 void inventory::dump(std::vector<item *> &dest)
 {
+    index.reset();
     for( auto &elem : items ) {
         for( auto &elem_stack_iter : elem ) {
             dest.push_back( &( elem_stack_iter ) );
@@ -681,6 +693,7 @@ const item &inventory::find_item(int position) const
 
 item &inventory::find_item(int position)
 {
+    index.reset();
     return const_cast<item&>( const_cast<const inventory*>(this)->find_item( position ) );
 }
 
@@ -712,6 +725,7 @@ int inventory::position_by_item( const item *it ) const
 
 item &inventory::item_by_type(itype_id type)
 {
+    index.reset();
     for( auto &elem : items ) {
         if( elem.front().typeId() == type ) {
             return elem.front();
@@ -733,6 +747,7 @@ int inventory::position_by_type(itype_id type)
 }
 item &inventory::item_or_container(itype_id type)
 {
+    index.reset();
     for( auto &elem : items ) {
         for( auto &elem_stack_iter : elem ) {
             if( elem_stack_iter.typeId() == type ) {
@@ -750,6 +765,7 @@ item &inventory::item_or_container(itype_id type)
 
 std::vector<std::pair<item *, int> > inventory::all_items_by_type(itype_id type)
 {
+    index.reset();
     std::vector<std::pair<item *, int> > ret;
     int i = 0;
     for( auto &elem : items ) {
@@ -765,6 +781,7 @@ std::vector<std::pair<item *, int> > inventory::all_items_by_type(itype_id type)
 
 std::list<item> inventory::use_amount(itype_id it, int _quantity)
 {
+    index.reset();
     long quantity = _quantity; // Don't wanny change the function signature right now
     sort();
     std::list<item> ret;
@@ -789,19 +806,152 @@ std::list<item> inventory::use_amount(itype_id it, int _quantity)
 
 bool inventory::has_tools(itype_id it, int quantity) const
 {
+    if( index && quantity > 0 ) {
+        return index->has_amount( it, quantity, true );
+    }
     return has_amount(it, quantity, true);
 }
 
 bool inventory::has_components(itype_id it, int quantity) const
 {
+    if( index && quantity > 0 ) {
+        return index->has_amount( it, quantity, false );
+    }
     return has_amount(it, quantity, false);
 }
 
 bool inventory::has_charges(itype_id it, long quantity) const
 {
+    if( index ) {
+        return index->charges_of( it ) >= quantity;
+    }
     return (charges_of(it) >= quantity);
 }
 
+void inventory::build_index()
+{
+    index = std::make_shared<inventory_index>( *this );
+}
+
+/**
+ * Adds the best level of each quality that @p it and everything inside of it provides
+ * to @p best, same as item::get_quality.
+ */
+static void collect_qualities( const item &it, std::map<quality_id, int> &best )
+{
+    for( const auto &quality : it.type->qualities ) {
+        const auto iter = best.find( quality.first );
+        if( iter == best.end() ) {
+            best.emplace( quality.first, quality.second );
+        } else {
+            iter->second = std::max( iter->second, quality.second );
+        }
+    }
+    for( const auto &content : it.contents ) {
+        collect_qualities( content, best );
+    }
+}
+
+inventory_index::inventory_index( const inventory &inv )
+{
+    // Mirrors amount_of_internal and has_quality_internal in visitable.cpp.
+    std::map<quality_id, int> best;
+    inv.visit_inline( [this, &best]( const item *e ) {
+        if( e->allow_crafting_component() ) {
+            amounts[e->typeId()]++;
+            if( !e->has_flag( "PSEUDO" ) ) {
+                real_amounts[e->typeId()]++;
+            }
+        }
+        best.clear();
+        collect_qualities( *e, best );
+        const int count = e->count_by_charges() ? e->charges : 1;
+        for( const auto &quality : best ) {
+            qualities[quality.first][quality.second] += count;
+        }
+        return VisitResponse::NEXT;
+    } );
+    // Mirrors charges_of_internal in visitable.cpp.
+    inv.visit_inline( [this]( const item *e ) {
+        if( e->is_tool() ) {
+            const long ammo = e->ammo_remaining();
+            charges[e->typeId()] += ammo;
+            const std::string &subtype = e->type->tool->subtype;
+            if( !subtype.empty() && subtype != e->typeId() ) {
+                charges[subtype] += ammo;
+            }
+            return VisitResponse::SKIP;
+        } else if( e->count_by_charges() ) {
+            charges[e->typeId()] += e->charges;
+            return VisitResponse::SKIP;
+        }
+        return VisitResponse::NEXT;
+    } );
+}
+
+bool inventory_index::has_amount( const itype_id &id, int quantity, bool pseudo ) const
+{
+    const auto &counts = pseudo ? amounts : real_amounts;
+    const auto iter = counts.find( id );
+    return iter != counts.end() && iter->second >= quantity;
+}
+
+long inventory_index::charges_of( const itype_id &id ) const
+{
+    const auto iter = charges.find( id );
+    return iter == charges.end() ? 0 : std::min( iter->second, long( INT_MAX ) );
+}
+
+bool inventory_index::has_quality( const quality_id &qual, int level, int qty ) const
+{
+    if( qty <= 0 ) {
+        return true;
+    }
+    const auto iter = qualities.find( qual );
+    if( iter == qualities.end() ) {
+        return false;
+    }
+    int found = 0;
+    for( auto lvl = iter->second.lower_bound( level ); lvl != iter->second.end(); ++lvl ) {
+        found += lvl->second;
+        if( found >= qty ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool inventory_index::operator==( const inventory_index &rhs ) const
+{
+    return amounts == rhs.amounts && real_amounts == rhs.real_amounts && charges == rhs.charges &&
+           qualities == rhs.qualities;
+}
+
+template<typename K, typename M>
+static void diff_keys( const M &lhs, const M &rhs, std::set<K> &out )
+{
+    for( const auto &e : lhs ) {
+        const auto iter = rhs.find( e.first );
+        if( iter == rhs.end() || !( iter->second == e.second ) ) {
+            out.insert( e.first );
+        }
+    }
+    for( const auto &e : rhs ) {
+        if( lhs.find( e.first ) == lhs.end() ) {
+            out.insert( e.first );
+        }
+    }
+}
+
+void inventory_index::diff( const inventory_index &rhs, std::set<itype_id> &types,
+                            std::set<quality_id> &quals ) const
+{
+    diff_keys<itype_id>( amounts, rhs.amounts, types );
+    diff_keys<itype_id>( real_amounts, rhs.real_amounts, types );
+    diff_keys<itype_id>( charges, rhs.charges, types );
+    diff_keys<quality_id>( qualities, rhs.qualities, quals );
+}
+
 int inventory::leak_level(std::string flag) const
 {
     int ret = 0;
@@ -848,6 +998,7 @@ bool inventory::has_enough_painkiller(int pain) const
 
 item *inventory::most_appropriate_painkiller(int pain)
 {
+    index.reset();
     int difference = 9999;
     item *ret = &nullitem;
     for( auto &elem : items ) {
@@ -875,6 +1026,7 @@ item *inventory::most_appropriate_painkiller(int pain)
 
 item *inventory::best_for_melee( player &p, double &best )
 {
+    index.reset();
     item *ret = &nullitem;
     for( auto &elem : items ) {
         auto score = p.melee_value( elem.front() );
@@ -889,6 +1041,7 @@ item *inventory::best_for_melee( player &p, double &best )
 
 item *inventory::most_loaded_gun()
 {
+    index.reset();
     item *ret = &nullitem;
     int max = 0;
     for( auto &elem : items ) {
@@ -952,6 +1105,7 @@ units::volume inventory::volume() const
 
 std::vector<item *> inventory::active_items()
 {
+    index.reset();
     std::vector<item *> ret;
     for( auto &elem : items ) {
         for( auto &elem_stack_iter : elem ) {
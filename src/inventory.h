@@ -6,7 +6,11 @@
 #include "enums.h"
 
 #include <list>
+#include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <functional>
@@ -47,10 +51,54 @@ public:
 
 const extern invlet_wrapper inv_chars;
 
+class inventory;
+
+/**
+ * Totals of an inventory by item type and by tool quality, gathered in a single pass
+ * over all items and their contents. Answers the same questions as the scanning
+ * functions of @ref visitable with lookups, see @ref inventory::build_index.
+ */
+class inventory_index
+{
+    public:
+        explicit inventory_index( const inventory &inv );
+
+        /** Same as visitable::has_amount, @p quantity must be positive. */
+        bool has_amount( const itype_id &id, int quantity, bool pseudo ) const;
+        /** Same as visitable::charges_of without a limit. */
+        long charges_of( const itype_id &id ) const;
+        /** Same as visitable::has_quality. */
+        bool has_quality( const quality_id &qual, int level, int qty ) const;
+
+        bool operator==( const inventory_index &rhs ) const;
+        bool operator!=( const inventory_index &rhs ) const {
+            return !operator==( rhs );
+        }
+
+        /**
+         * Adds the item types and qualities whose totals differ between this index and
+         * @p rhs to @p types and @p quals. Types and qualities missing from one of the
+         * indices count as different if the other one has them.
+         */
+        void diff( const inventory_index &rhs, std::set<itype_id> &types,
+                   std::set<quality_id> &quals ) const;
+
+    private:
+        /** Items that allow being used as crafting component, by type. */
+        std::unordered_map<itype_id, int> amounts;
+        /** Same as @ref amounts, without the PSEUDO items. */
+        std::unordered_map<itype_id, int> real_amounts;
+        /** Charges by type, tools also count towards their subtype. */
+        std::unordered_map<itype_id, long> charges;
+        /** For each quality, the number of items (or charges) by the level they provide. */
+        std::map<quality_id, std::map<int, int>> qualities;
+};
+
 class inventory : public visitable<inventory>
 {
     public:
         friend visitable<inventory>;
+        friend struct item_visitor;
 
         invslice slice();
         const_invslice const_slice() const;
@@ -139,6 +187,24 @@ class inventory : public visitable<inventory>
         bool has_components (itype_id it, int quantity) const;
         bool has_charges(itype_id it, long quantity) const;
 
+        /**
+         * Gathers the totals used by has_tools, has_components, has_charges and
+         * has_quality, which then become lookups. Meant for inventories that are
+         * checked often but rarely change, like the crafting inventory.
+         * Adding or removing items and handing out non-const access to them, including
+         * non-const visitors, drops the index again. Changing the items through a
+         * reference obtained before building it does not.
+         */
+        void build_index();
+        /** The index built by @ref build_index, if it is still valid. */
+        const inventory_index *get_index() const {
+            return index.get();
+        }
+        /** Same as @ref get_index, but keeps the index alive after the inventory drops it. */
+        std::shared_ptr<const inventory_index> shared_index() const {
+            return index;
+        }
+
         int leak_level(std::string flag) const; // level of leaked bad stuff from items
 
         // NPC/AI functions
@@ -186,6 +252,8 @@ class inventory : public visitable<inventory>
 
         invstack items;
         bool sorted;
+        /** Immutable, so copies of the inventory can share it. */
+        std::shared_ptr<const inventory_index> index;
 };
 
 #endif
@@ -530,8 +530,8 @@ void selection_column::on_change( const inventory_entry &entry )
 }
 
 // @todo Move it into some 'item_stack' class.
-std::vector<std::list<item *>> restack_items( const std::list<item>::const_iterator &from,
-                                              const std::list<item>::const_iterator &to )
+std::vector<std::list<item *>> restack_items( const item_list::const_iterator &from,
+                                              const item_list::const_iterator &to )
 {
     std::vector<std::list<item *>> res;
 
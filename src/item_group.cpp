@@ -8,6 +8,7 @@
 #include <map>
 #include <algorithm>
 #include <cassert>
+#include <iterator>
 
 static const std::string null_item_id("null");
 
@@ -81,9 +82,9 @@ Item_spawn_data::ItemList Single_item_creator::create(int birthday, RecursionLis
     }
     for( ; cnt > 0; cnt--) {
         if (type == S_ITEM) {
-            const auto itm = create_single( birthday, rec );
+            auto itm = create_single( birthday, rec );
             if( !itm.is_null() ) {
-                result.push_back( itm );
+                result.push_back( std::move( itm ) );
             }
         } else {
             if (std::find(rec.begin(), rec.end(), id) != rec.end()) {
@@ -103,7 +104,8 @@ Item_spawn_data::ItemList Single_item_creator::create(int birthday, RecursionLis
                     modifier->modify( elem );
                 }
             }
-            result.insert(result.end(), tmplist.begin(), tmplist.end());
+            result.insert( result.end(), std::make_move_iterator( tmplist.begin() ),
+                           std::make_move_iterator( tmplist.end() ) );
         }
     }
     return result;
@@ -322,7 +324,8 @@ Item_spawn_data::ItemList Item_group::create(int birthday, RecursionList &rec) c
                 continue;
             }
             ItemList tmp = ( elem )->create( birthday, rec );
-            result.insert(result.end(), tmp.begin(), tmp.end());
+            result.insert( result.end(), std::make_move_iterator( tmp.begin() ),
+                           std::make_move_iterator( tmp.end() ) );
         }
     } else if (type == G_DISTRIBUTION) {
         int p = rng(0, sum_prob - 1);
@@ -332,7 +335,8 @@ Item_spawn_data::ItemList Item_group::create(int birthday, RecursionList &rec) c
                 continue;
             }
             ItemList tmp = ( elem )->create( birthday, rec );
-            result.insert(result.end(), tmp.begin(), tmp.end());
+            result.insert( result.end(), std::make_move_iterator( tmp.begin() ),
+                           std::make_move_iterator( tmp.end() ) );
             break;
         }
     }
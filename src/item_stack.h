@@ -1,10 +1,19 @@
 #ifndef ITEM_STACK_H
 #define ITEM_STACK_H
 
+#include "pool_allocator.h"
+
 #include <list>
 
 class item;
 
+/**
+ * The list type holding the items on a map square or in a vehicle part.
+ * Its nodes come from a shared slab pool, so item churn on the map reuses
+ * the same memory instead of fragmenting the general heap.
+ */
+typedef std::list<item, pool_allocator<item>> item_list;
+
 // A wrapper class to bundle up the references needed for a caller to safely manipulate
 // items at a particular map x/y location.
 // Note this does not expose the container itself,
@@ -18,9 +27,9 @@ class item_stack
     public:
         virtual size_t size() const = 0;
         virtual bool empty() const = 0;
-        virtual std::list<item>::iterator erase( std::list<item>::iterator it ) = 0;
+        virtual item_list::iterator erase( item_list::iterator it ) = 0;
         virtual void push_back( const item &newitem ) = 0;
-        virtual void insert_at( std::list<item>::iterator, const item &newitem ) = 0;
+        virtual void insert_at( item_list::iterator, const item &newitem ) = 0;
         virtual item &front() = 0;
         virtual item &operator[]( size_t index ) = 0;
 };
@@ -2660,7 +2660,7 @@ player &get_patient( player &healer, const tripoint &pos )
     const int npc_index = g->npc_at( pos );
     if( npc_index == -1 ) {
         // Default to heal self on failure not to break old functionality
-        add_msg( m_debug, "No heal target at position %d,%d,%d", pos.x, pos.y, pos.z );
+        add_msg_debug( "No heal target at position %d,%d,%d", pos.x, pos.y, pos.z );
         return healer;
     }
 
@@ -27,8 +27,8 @@ constexpr double PI     = 3.14159265358979323846;
 constexpr double HALFPI = 1.57079632679489661923;
 constexpr double SQRT_2 = 1.41421356237309504880;
 
-void map::add_light_from_items( const tripoint &p, std::list<item>::iterator begin,
-                                std::list<item>::iterator end )
+void map::add_light_from_items( const tripoint &p, item_list::iterator begin,
+                                item_list::iterator end )
 {
     for( auto itm_it = begin; itm_it != end; ++itm_it ) {
         float ilum = 0.0; // brightness
@@ -62,7 +62,7 @@ void map::build_transparency_cache( const int zlev )
     // Traverse the submaps in order
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
-            auto const cur_submap = get_submap_at_grid( smx, smy, zlev );
+            const submap *const cur_submap = get_submap_at_grid( smx, smy, zlev );
 
             for( int sx = 0; sx < SEEX; ++sx ) {
                 for( int sy = 0; sy < SEEY; ++sy ) {
@@ -81,7 +81,7 @@ void map::build_transparency_cache( const int zlev )
                         value *= weather_data(g->weather).sight_penalty;
                     }
 
-                    for( auto const &fld : cur_submap->fld[sx][sy] ) {
+                    for( auto const &fld : cur_submap->get_field( sx, sy ) ) {
                         const field_entry &cur = fld.second;
                         const field_id type = cur.getFieldType();
                         const int density = cur.getFieldDensity();
@@ -184,7 +184,7 @@ void map::generate_lightmap( const int zlev )
     // Traverse the submaps in order
     for (int smx = 0; smx < my_MAPSIZE; ++smx) {
         for (int smy = 0; smy < my_MAPSIZE; ++smy) {
-            auto const cur_submap = get_submap_at_grid( smx, smy, zlev );
+            const submap *const cur_submap = get_submap_at_grid( smx, smy, zlev );
 
             for (int sx = 0; sx < SEEX; ++sx) {
                 for (int sy = 0; sy < SEEY; ++sy) {
@@ -220,7 +220,7 @@ void map::generate_lightmap( const int zlev )
                         add_light_source( p, 240 );
                     }
 
-                    for( auto &fld : cur_submap->fld[sx][sy] ) {
+                    for( auto const &fld : cur_submap->get_field( sx, sy ) ) {
                         const field_entry *cur = &fld.second;
                         // TODO: [lightmap] Attach light brightness to fields
                         switch(cur->getFieldType()) {
@@ -296,8 +296,7 @@ void map::generate_lightmap( const int zlev )
     }
 
     // Apply any vehicle light sources
-    VehicleList vehs = get_vehicles();
-    for( auto &vv : vehs ) {
+    for( auto &vv : get_vehicles() ) {
         vehicle *v = vv.v;
 
         auto lights = v->lights( true );
@@ -3,7 +3,9 @@
 #include "catalua.h"
 #include "catacharset.h"
 #include "input.h"
+#include "output.h"
 
+#include <chrono>
 #include <map>
 
 lua_console::lua_console() : cWin( newwin( lines, width, 0, 0 ) ),
@@ -97,10 +99,14 @@ void lua_console::run()
         std::string input = get_input();
 
 #ifdef LUA
+        const auto start = std::chrono::steady_clock::now();
         call_lua( input );
+        const auto took = std::chrono::duration_cast<std::chrono::microseconds>(
+                              std::chrono::steady_clock::now() - start );
 
         read_stream( lua_output_stream, c_white );
         read_stream( lua_error_stream, c_red );
+        text_stack.push_back( {string_format( "(%.3f ms)", took.count() / 1000.0 ), c_dkgray} );
 #else
         text_stack.push_back( {"This build does not support lua.", c_red} );
 #endif // LUA
@@ -65,6 +65,7 @@ int main(int argc, char *argv[])
     std::string dump;
     dump_mode dmode = dump_mode::TSV;
     std::vector<std::string> opts;
+    std::string debug_trace;
 
     // Set default file paths
 #ifdef PREFIX
@@ -108,6 +109,16 @@ int main(int argc, char *argv[])
                     return 0;
                 }
             },
+            {
+                "--debug-trace", "<file>",
+                "Records every reached debug log statement into a binary trace file",
+                section_default,
+                [&debug_trace](int num_args, const char **params) -> int {
+                    if (num_args < 1) return -1;
+                    debug_trace = params[0];
+                    return 1;
+                }
+            },
             {
                 "--check-mods", "[mods...]",
                 "Checks the json files belonging to cdda mods",
@@ -389,6 +400,9 @@ int main(int argc, char *argv[])
     }
 
     setupDebug();
+    if( !debug_trace.empty() && !startDebugTrace( debug_trace ) ) {
+        DebugLog( D_WARNING, D_MAIN ) << "Could not open debug trace file " << debug_trace;
+    }
 
     if (setlocale(LC_ALL, "") == NULL) {
         DebugLog(D_WARNING, D_MAIN) << "Error while setlocale(LC_ALL, '').";
@@ -61,9 +61,9 @@ extern bool is_valid_in_w_terrain(int,int);
 #define SGN(a) (((a)<0) ? -1 : 1)
 #define INBOUNDS(x, y) \
  (x >= 0 && x < SEEX * my_MAPSIZE && y >= 0 && y < SEEY * my_MAPSIZE)
-#define dbg(x) DebugLog((DebugLevel)(x),D_MAP) << __FILE__ << ":" << __LINE__ << ": "
+#define dbg(x) DebugLogLazy((DebugLevel)(x),D_MAP) << __FILE__ << ":" << __LINE__ << ": "
 
-static std::list<item>  nulitems;          // Returned when &i_at() is asked for an OOB value
+static item_list nulitems;          // Returned when &i_at() is asked for an OOB value
 static field            nulfield;          // Returned when &field_at() is asked for an OOB value
 static int              null_temperature;  // Because radiation does it too
 static level_cache      nullcache;         // Dummy cache for z-levels outside bounds
@@ -83,7 +83,7 @@ bool map_stack::empty() const
     return mystack->empty();
 }
 
-std::list<item>::iterator map_stack::erase( std::list<item>::iterator it )
+item_list::iterator map_stack::erase( item_list::iterator it )
 {
     return myorigin->i_rem(location, it);
 }
@@ -93,48 +93,48 @@ void map_stack::push_back( const item &newitem )
     myorigin->add_item_or_charges( location, newitem );
 }
 
-void map_stack::insert_at( std::list<item>::iterator index,
+void map_stack::insert_at( item_list::iterator index,
                            const item &newitem )
 {
     myorigin->add_item_at( location, index, newitem );
 }
 
-std::list<item>::iterator map_stack::begin()
+item_list::iterator map_stack::begin()
 {
     return mystack->begin();
 }
 
-std::list<item>::iterator map_stack::end()
+item_list::iterator map_stack::end()
 {
     return mystack->end();
 }
 
-std::list<item>::const_iterator map_stack::begin() const
+item_list::const_iterator map_stack::begin() const
 {
     return mystack->cbegin();
 }
 
-std::list<item>::const_iterator map_stack::end() const
+item_list::const_iterator map_stack::end() const
 {
     return mystack->cend();
 }
 
-std::list<item>::reverse_iterator map_stack::rbegin()
+item_list::reverse_iterator map_stack::rbegin()
 {
     return mystack->rbegin();
 }
 
-std::list<item>::reverse_iterator map_stack::rend()
+item_list::reverse_iterator map_stack::rend()
 {
     return mystack->rend();
 }
 
-std::list<item>::const_reverse_iterator map_stack::rbegin() const
+item_list::const_reverse_iterator map_stack::rbegin() const
 {
     return mystack->crbegin();
 }
 
-std::list<item>::const_reverse_iterator map_stack::rend() const
+item_list::const_reverse_iterator map_stack::rend() const
 {
     return mystack->crend();
 }
@@ -215,14 +215,35 @@ maptile map::maptile_at_internal( const tripoint &p )
 
 // Vehicle functions
 
-VehicleList map::get_vehicles() {
-    if( !zlevels ) {
-        return get_vehicles( tripoint( 0, 0, abs_sub.z ),
-                             tripoint( SEEX * my_MAPSIZE, SEEY * my_MAPSIZE, abs_sub.z ) );
+const VehicleList &map::get_vehicles() {
+    if( !cached_vehicles_dirty ) {
+        return cached_vehicles;
     }
 
-    return get_vehicles( tripoint( 0, 0, -OVERMAP_DEPTH ),
-                         tripoint( SEEX * my_MAPSIZE, SEEY * my_MAPSIZE, OVERMAP_HEIGHT ) );
+    const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
+    const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
+    cached_vehicles.clear();
+    for( int cx = 0; cx < my_MAPSIZE; ++cx ) {
+        for( int cy = 0; cy < my_MAPSIZE; ++cy ) {
+            for( int cz = minz; cz <= maxz; ++cz ) {
+                submap *current_submap = get_submap_at_grid( cx, cy, cz );
+                for( auto &elem : current_submap->vehicles ) {
+                    // Ensure the veh's z-position is correct
+                    elem->smz = cz;
+                    wrapped_vehicle w;
+                    w.v = elem;
+                    w.x = w.v->posx + cx * SEEX;
+                    w.y = w.v->posy + cy * SEEY;
+                    w.z = cz;
+                    w.i = cx;
+                    w.j = cy;
+                    cached_vehicles.push_back( w );
+                }
+            }
+        }
+    }
+    cached_vehicles_dirty = false;
+    return cached_vehicles;
 }
 
 void map::reset_vehicle_cache( const int zlev )
@@ -308,11 +329,13 @@ void map::clear_vehicle_list( const int zlev )
 {
     auto &ch = get_cache( zlev );
     ch.vehicle_list.clear();
+    set_vehicle_list_dirty();
 }
 
 void map::update_vehicle_list( submap *const to, const int zlev )
 {
     // Update vehicle data
+    set_vehicle_list_dirty();
     auto &ch = get_cache( zlev );
     for( auto & elem : to->vehicles ) {
         ch.vehicle_list.insert( elem );
@@ -345,6 +368,8 @@ std::unique_ptr<vehicle> map::detach_vehicle( vehicle *veh )
                 overmap_buffer.remove_vehicle( veh );
             }
             dirty_vehicle_list.erase(veh);
+            unschedule_vehicle( veh );
+            set_vehicle_list_dirty();
             return std::unique_ptr<vehicle>( veh );
         }
     }
@@ -368,14 +393,14 @@ void map::vehmove()
 {
     // give vehicles movement points
     {
-        VehicleList vehs = get_vehicles();
-        for( auto &vehs_v : vehs ) {
+        for( auto &vehs_v : get_vehicles() ) {
             vehicle *veh = vehs_v.v;
             veh->gain_moves();
             veh->slow_leak();
         }
     }
 
+    build_vehicle_schedule();
     // 15 equals 3 >50mph vehicles, or up to 15 slow (1 square move) ones
     // But 15 is too low for V12 deathbikes, let's put 100 here
     for( int count = 0; count < 100; count++ ) {
@@ -383,6 +408,11 @@ void map::vehmove()
             break;
         }
     }
+    // Don't keep pointers to vehicles that may get destroyed before the next turn.
+    vehicle_schedule = decltype( vehicle_schedule )();
+    scheduled_vehicles.clear();
+    scheduled_of_turn.clear();
+    vehicle_schedule_valid = false;
     // Process item removal on the vehicles that were modified this turn.
     // Use a copy because part_removal_cleanup can modify the container.
     auto temp = dirty_vehicle_list;
@@ -392,36 +422,108 @@ void map::vehmove()
     dirty_vehicle_list.clear();
 }
 
+void map::build_vehicle_schedule()
+{
+    vehicle_schedule = decltype( vehicle_schedule )();
+    scheduled_vehicles.clear();
+    scheduled_of_turn.clear();
+    for( auto &vehs_v : get_vehicles() ) {
+        scheduled_vehicles.push_back( vehs_v.v );
+        scheduled_of_turn.push_back( 0 );
+        requeue_vehicle( scheduled_vehicles.size() - 1 );
+    }
+    vehicle_schedule_valid = true;
+}
+
+void map::requeue_vehicle( const size_t index )
+{
+    const float of_turn = scheduled_vehicles[index]->of_turn;
+    scheduled_of_turn[index] = of_turn;
+    if( of_turn > 0 ) {
+        vehicle_schedule.push( vehicle_schedule_entry{ of_turn, index } );
+    }
+}
+
+void map::reschedule_vehicle( const vehicle &veh )
+{
+    if( !vehicle_schedule_valid ) {
+        return;
+    }
+    const auto iter = std::find( scheduled_vehicles.begin(), scheduled_vehicles.end(), &veh );
+    if( iter != scheduled_vehicles.end() ) {
+        requeue_vehicle( std::distance( scheduled_vehicles.begin(), iter ) );
+    }
+}
+
+void map::unschedule_vehicle( const vehicle *veh )
+{
+    if( !vehicle_schedule_valid ) {
+        return;
+    }
+    // Its queue entries are skipped once the vehicle is gone.
+    std::replace( scheduled_vehicles.begin(), scheduled_vehicles.end(), const_cast<vehicle *>( veh ),
+                  static_cast<vehicle *>( nullptr ) );
+}
+
+bool map::vehicle_in_bubble( const vehicle *veh )
+{
+    const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
+    const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
+    for( int z = minz; z <= maxz; z++ ) {
+        if( get_cache( z ).vehicle_list.count( const_cast<vehicle *>( veh ) ) > 0 ) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool map::vehproceed()
 {
-    VehicleList vehs = get_vehicles();
-    vehicle* cur_veh = nullptr;
-    float max_of_turn = 0;
-    tripoint pt;
+    if( !vehicle_schedule_valid ) {
+        build_vehicle_schedule();
+    }
+    size_t cur_index = scheduled_vehicles.size();
     // First horizontal movement
-    for( auto &vehs_v : vehs ) {
-        if( vehs_v.v->of_turn > max_of_turn ) {
-            cur_veh = vehs_v.v;
-            max_of_turn = cur_veh->of_turn;
+    while( !vehicle_schedule.empty() && cur_index == scheduled_vehicles.size() ) {
+        const vehicle_schedule_entry next = vehicle_schedule.top();
+        vehicle_schedule.pop();
+        if( next.of_turn != scheduled_of_turn[next.index] ) {
+            // Superseded by a later entry for the same vehicle.
+            continue;
+        }
+        vehicle *veh = scheduled_vehicles[next.index];
+        if( veh == nullptr || !vehicle_in_bubble( veh ) ) {
+            scheduled_vehicles[next.index] = nullptr;
+            continue;
         }
+        if( veh->of_turn != next.of_turn ) {
+            requeue_vehicle( next.index );
+            continue;
+        }
+        cur_index = next.index;
     }
 
     // Then vertical-only movement
-    if( cur_veh == nullptr ) {
-        for( auto &vehs_v : vehs ) {
-            vehicle &cveh = *vehs_v.v;
-            if( cveh.falling ) {
-                cur_veh = vehs_v.v;
-                break;
-            }
+    for( size_t i = 0; i < scheduled_vehicles.size() && cur_index == scheduled_vehicles.size(); i++ ) {
+        vehicle *veh = scheduled_vehicles[i];
+        if( veh != nullptr && vehicle_in_bubble( veh ) && veh->falling ) {
+            cur_index = i;
         }
     }
 
-    if( cur_veh == nullptr ) {
+    if( cur_index == scheduled_vehicles.size() ) {
         return false;
     }
 
-    return vehact( *cur_veh );
+    vehicle *cur_veh = scheduled_vehicles[cur_index];
+    const bool moved = vehact( *cur_veh );
+    // vehact may have destroyed the vehicle.
+    if( vehicle_in_bubble( cur_veh ) ) {
+        requeue_vehicle( cur_index );
+    } else {
+        scheduled_vehicles[cur_index] = nullptr;
+    }
+    return moved;
 }
 
 bool map::vehact( vehicle &veh )
@@ -1049,6 +1151,7 @@ float map::vehicle_vehicle_collision( vehicle &veh, vehicle &veh2,
 
         veh.of_turn = avg_of_turn * .9;
         veh2.of_turn = avg_of_turn * 1.1;
+        reschedule_vehicle( veh2 );
 
         //Energy after collision
         float E_a = 0.5 * m1 * final1.norm() * final1.norm() +
@@ -1128,27 +1231,11 @@ VehicleList map::get_vehicles( const tripoint &start, const tripoint &end )
     const int chunk_ex = std::min( my_MAPSIZE - 1, (end.x / SEEX) + 1 );
     const int chunk_sy = std::max( 0, (start.y / SEEY) - 1 );
     const int chunk_ey = std::min( my_MAPSIZE - 1, (end.y / SEEY) + 1 );
-    const int chunk_sz = start.z;
-    const int chunk_ez = end.z;
     VehicleList vehs;
-
-    for( int cx = chunk_sx; cx <= chunk_ex; ++cx ) {
-        for( int cy = chunk_sy; cy <= chunk_ey; ++cy ) {
-            for( int cz = chunk_sz; cz <= chunk_ez; ++cz ) {
-                submap *current_submap = get_submap_at_grid( cx, cy, cz );
-                for( auto &elem : current_submap->vehicles ) {
-                    // Ensure the veh's z-position is correct
-                    elem->smz = cz;
-                    wrapped_vehicle w;
-                    w.v = elem;
-                    w.x = w.v->posx + cx * SEEX;
-                    w.y = w.v->posy + cy * SEEY;
-                    w.z = cz;
-                    w.i = cx;
-                    w.j = cy;
-                    vehs.push_back( w );
-                }
-            }
+    for( const auto &w : get_vehicles() ) {
+        if( w.i >= chunk_sx && w.i <= chunk_ex && w.j >= chunk_sy && w.j <= chunk_ey &&
+            w.z >= start.z && w.z <= end.z ) {
+            vehs.push_back( w );
         }
     }
 
@@ -1308,7 +1395,7 @@ vehicle *map::displace_vehicle( tripoint &p, const tripoint &dp )
     const tripoint dst = p2;
 
     if( !inbounds( src ) ) {
-        add_msg( m_debug, "map::displace_vehicle: coords out of bounds %d,%d,%d->%d,%d,%d",
+        add_msg_debug( "map::displace_vehicle: coords out of bounds %d,%d,%d->%d,%d,%d",
                         src.x, src.y, src.z, dst.x, dst.y, dst.z );
         return nullptr;
     }
@@ -1339,7 +1426,7 @@ vehicle *map::displace_vehicle( tripoint &p, const tripoint &dp )
         }
     }
     if( our_i < 0 ) {
-        add_msg( m_debug, "displace_vehicle our_i=%d", our_i );
+        add_msg_debug( "displace_vehicle our_i=%d", our_i );
         return nullptr;
     }
     // move the vehicle
@@ -1411,6 +1498,7 @@ vehicle *map::displace_vehicle( tripoint &p, const tripoint &dp )
     }
     veh->pivot_anchor[0] = veh->pivot_anchor[1];
     veh->pivot_rotation[0] = veh->pivot_rotation[1];
+    veh->refresh_precalc_parts();
 
     veh->posx = dst_offset_x;
     veh->posy = dst_offset_y;
@@ -1422,6 +1510,15 @@ vehicle *map::displace_vehicle( tripoint &p, const tripoint &dp )
         dst_submap->vehicles.push_back( veh );
         src_submap->vehicles.erase( src_submap->vehicles.begin() + our_i );
         dst_submap->is_uniform = false;
+        set_vehicle_list_dirty();
+    } else if( !cached_vehicles_dirty ) {
+        // Still on the same submap, so its place in the list doesn't change.
+        for( auto &w : cached_vehicles ) {
+            if( w.v == veh ) {
+                w.x = veh->posx + w.i * SEEX;
+                w.y = veh->posy + w.j * SEEY;
+            }
+        }
     }
 
     p = p2;
@@ -2327,7 +2424,7 @@ void map::process_falling()
     }
 
     if( !support_cache_dirty.empty() ) {
-        add_msg( m_debug, "Checking %d tiles for falling objects",
+        add_msg_debug( "Checking %d tiles for falling objects",
                  support_cache_dirty.size() );
         // We want the cache to stay constant, but falling can change it
         std::set<tripoint> last_cache = std::move( support_cache_dirty );
@@ -2862,7 +2959,7 @@ void map::decay_fields_and_scent( const int amount )
                     const int x = sx + smx * SEEX;
                     const int y = sy + smy * SEEY;
 
-                    field &fields = cur_submap->fld[sx][sy];
+                    field &fields = cur_submap->get_field( sx, sy );
                     if( !outside_cache[x][y] ) {
                         to_proc -= fields.fieldCount();
                         continue;
@@ -3577,7 +3674,7 @@ void map::bash_items( const tripoint &p, bash_params &params )
         }
     }
     // Now plunk in the contents of the smashed items.
-    spawn_items( p, smashed_contents );
+    spawn_items( p, std::move( smashed_contents ) );
 
     // Add a glass sound even when something else also breaks
     if( smashed_glass && !params.silent ) {
@@ -4234,10 +4331,10 @@ map_stack map::i_at( const int x, const int y )
     int lx, ly;
     submap *const current_submap = get_submap_at( x, y, lx, ly );
 
-    return map_stack{ &current_submap->itm[lx][ly], tripoint( x, y, abs_sub.z ), this };
+    return map_stack{ &current_submap->get_items( lx, ly ), tripoint( x, y, abs_sub.z ), this };
 }
 
-std::list<item>::iterator map::i_rem( const point location, std::list<item>::iterator it )
+item_list::iterator map::i_rem( const point location, item_list::iterator it )
 {
     return i_rem( tripoint( location, abs_sub.z ), it );
 }
@@ -4263,9 +4360,9 @@ void map::spawn_an_item(const int x, const int y, item new_item,
     spawn_an_item( tripoint( x, y, abs_sub.z ), new_item, charges, damlevel );
 }
 
-void map::spawn_items(const int x, const int y, const std::vector<item> &new_items)
+void map::spawn_items(const int x, const int y, std::vector<item> new_items)
 {
-    spawn_items( tripoint( x, y, abs_sub.z ), new_items );
+    spawn_items( tripoint( x, y, abs_sub.z ), std::move( new_items ) );
 }
 
 void map::spawn_item(const int x, const int y, const std::string &type_id,
@@ -4313,10 +4410,23 @@ map_stack map::i_at( const tripoint &p )
     int lx, ly;
     submap *const current_submap = get_submap_at( p, lx, ly );
 
-    return map_stack{ &current_submap->itm[lx][ly], p, this };
+    return map_stack{ &current_submap->get_items( lx, ly ), p, this };
 }
 
-std::list<item>::iterator map::i_rem( const tripoint &p, std::list<item>::iterator it )
+const item_list &map::i_at( const tripoint &p ) const
+{
+    if( !inbounds( p ) ) {
+        static const item_list no_items;
+        return no_items;
+    }
+
+    int lx, ly;
+    const submap *const current_submap = get_submap_at( p, lx, ly );
+
+    return current_submap->get_items( lx, ly );
+}
+
+item_list::iterator map::i_rem( const tripoint &p, item_list::iterator it )
 {
     int lx, ly;
     submap *const current_submap = get_submap_at( p, lx, ly );
@@ -4327,7 +4437,7 @@ std::list<item>::iterator map::i_rem( const tripoint &p, std::list<item>::iterat
 
     current_submap->update_lum_rem(*it, lx, ly);
 
-    return current_submap->itm[lx][ly].erase( it );
+    return current_submap->get_items( lx, ly ).erase( it );
 }
 
 int map::i_rem(const tripoint &p, const int index)
@@ -4365,16 +4475,20 @@ void map::i_clear(const tripoint &p)
 {
     int lx, ly;
     submap *const current_submap = get_submap_at( p, lx, ly );
+    if( !current_submap->itm.is_allocated() ) {
+        // Nothing has ever been placed on this submap
+        return;
+    }
+    auto &items = current_submap->get_items( lx, ly );
 
-    for( auto item_it = current_submap->itm[lx][ly].begin();
-         item_it != current_submap->itm[lx][ly].end(); ++item_it ) {
+    for( auto item_it = items.begin(); item_it != items.end(); ++item_it ) {
         if( current_submap->active_items.has( item_it, point( lx, ly ) ) ) {
             current_submap->active_items.remove( item_it, point( lx, ly ) );
         }
     }
 
     current_submap->lum[lx][ly] = 0;
-    current_submap->itm[lx][ly].clear();
+    items.clear();
 }
 
 item &map::spawn_an_item(const tripoint &p, item new_item,
@@ -4395,22 +4509,71 @@ item &map::spawn_an_item(const tripoint &p, item new_item,
     return add_item_or_charges(p, new_item);
 }
 
-std::vector<item*> map::spawn_items(const tripoint &p, const std::vector<item> &new_items)
+std::vector<item*> map::spawn_items(const tripoint &p, std::vector<item> new_items)
 {
     std::vector<item*> ret;
     if (!inbounds(p) || has_flag("DESTROY_ITEM", p)) {
         return ret;
     }
     const bool swimmable = has_flag("SWIMMABLE", p);
-    for( auto new_item : new_items ) {
+    // What add_item_or_charges and add_item_at check for each item, the square
+    // doesn't change in between except for the items added here.
+    const bool noitem = has_flag( "NOITEM", p );
+    const bool on_fire = get_field( p, fd_fire ) != nullptr;
+    units::volume free = free_volume( p );
+    int lx, ly;
+    submap *const current_submap = get_submap_at( p, lx, ly );
+    item_list &stack = current_submap->get_items( lx, ly );
+    ret.reserve( new_items.size() );
+    for( auto &new_item : new_items ) {
 
         if (new_item.made_of(LIQUID) && swimmable) {
             continue;
         }
-        item &it = add_item_or_charges(p, new_item);
-        if( !it.is_null() ) {
-            ret.push_back( &it );
+        if( new_item.has_flag( "NO_DROP" ) ||
+            ( new_item.is_gunmod() && new_item.has_flag( "IRREMOVABLE" ) ) ) {
+            continue;
         }
+        if( noitem || new_item.volume() > free || stack.size() >= MAX_ITEM_IN_SQUARE ) {
+            // Doesn't fit (or only by merging charges), let it look around.
+            item &it = add_item_or_charges( p, std::move( new_item ) );
+            if( !it.is_null() ) {
+                ret.push_back( &it );
+            }
+            free = free_volume( p );
+            continue;
+        }
+
+        if( new_item.charges != -1 && new_item.count_by_charges() ) {
+            const auto merged = std::find_if( stack.begin(), stack.end(), [&]( item & i ) {
+                const units::volume old_volume = i.volume();
+                if( !i.merge_charges( new_item ) ) {
+                    return false;
+                }
+                free -= i.volume() - old_volume;
+                return true;
+            } );
+            if( merged != stack.end() ) {
+                ret.push_back( &*merged );
+                continue;
+            }
+        }
+
+        support_dirty( p );
+        if( new_item.needs_processing() && new_item.is_food() ) {
+            new_item.process( nullptr, p, false );
+        }
+        if( on_fire && new_item.has_flag( "ACT_IN_FIRE" ) ) {
+            new_item.active = true;
+        }
+        current_submap->is_uniform = false;
+        current_submap->update_lum_add( new_item, lx, ly );
+        const auto new_pos = stack.insert( stack.end(), std::move( new_item ) );
+        if( new_pos->needs_processing() ) {
+            current_submap->active_items.add( new_pos, point( lx, ly ) );
+        }
+        free -= new_pos->volume();
+        ret.push_back( &*new_pos );
     }
 
     return ret;
@@ -4515,7 +4678,7 @@ item &map::add_item_or_charges(const tripoint &p, item new_item, int overflow_ra
 
         if( i_at( p_it ).size() < MAX_ITEM_IN_SQUARE ) {
             support_dirty( p_it );
-            return add_item( p_it, new_item );
+            return add_item( p_it, std::move( new_item ) );
         }
     }
 
@@ -4538,11 +4701,11 @@ item &map::add_item(const tripoint &p, item new_item)
     if( new_item.needs_processing() && new_item.is_food() ) {
         new_item.process( nullptr, p, false );
     }
-    return add_item_at(p, current_submap->itm[lx][ly].end(), new_item);
+    return add_item_at(p, current_submap->get_items( lx, ly ).end(), std::move( new_item ) );
 }
 
 item &map::add_item_at( const tripoint &p,
-                        std::list<item>::iterator index, item new_item )
+                        item_list::iterator index, item new_item )
 {
     if( new_item.made_of(LIQUID) && has_flag( "SWIMMABLE", p ) ) {
         return nulitem;
@@ -4561,8 +4724,8 @@ item &map::add_item_at( const tripoint &p,
     current_submap->is_uniform = false;
 
     current_submap->update_lum_add(new_item, lx, ly);
-    const auto new_pos = current_submap->itm[lx][ly].insert( index, new_item );
-    if( new_item.needs_processing() ) {
+    const auto new_pos = current_submap->get_items( lx, ly ).insert( index, std::move( new_item ) );
+    if( new_pos->needs_processing() ) {
         current_submap->active_items.add( new_pos, point(lx, ly) );
     }
 
@@ -4654,7 +4817,7 @@ static bool process_item( item_stack &items, Iterator &n, const tripoint &locati
     return true;
 }
 
-static bool process_map_items( item_stack &items, std::list<item>::iterator &n,
+static bool process_map_items( item_stack &items, item_list::iterator &n,
                                const tripoint &location, std::string )
 {
     return process_item( items, n, location, false );
@@ -4852,9 +5015,9 @@ bool map::has_items( const tripoint &p ) const
     }
 
     int lx, ly;
-    submap * const current_submap = get_submap_at( p, lx, ly );
+    const submap *const current_submap = get_submap_at( p, lx, ly );
 
-    return !current_submap->itm[lx][ly].empty();
+    return !current_submap->get_items( lx, ly ).empty();
 }
 
 template <typename Stack>
@@ -5186,7 +5349,7 @@ std::list<std::pair<tripoint, item *> > map::get_rc_items( int x, int y, int z )
     return rc_pairs;
 }
 
-static bool trigger_radio_item( item_stack &items, std::list<item>::iterator &n,
+static bool trigger_radio_item( item_stack &items, item_list::iterator &n,
                                 const tripoint &pos,
                                 std::string signal )
 {
@@ -5378,9 +5541,9 @@ const field &map::field_at( const tripoint &p ) const
     }
 
     int lx, ly;
-    submap *const current_submap = get_submap_at( p, lx, ly );
+    const submap *const current_submap = get_submap_at( p, lx, ly );
 
-    return current_submap->fld[lx][ly];
+    return current_submap->get_field( lx, ly );
 }
 
 /*
@@ -5396,7 +5559,7 @@ field &map::field_at( const tripoint &p )
     int lx, ly;
     submap *const current_submap = get_submap_at( p, lx, ly );
 
-    return current_submap->fld[lx][ly];
+    return current_submap->get_field( lx, ly );
 }
 
 int map::adjust_field_age( const tripoint &p, const field_id t, const int offset ) {
@@ -5463,8 +5626,11 @@ field_entry *map::get_field( const tripoint &p, const field_id t ) {
 
     int lx, ly;
     submap *const current_submap = get_submap_at( p, lx, ly );
+    if( !current_submap->fld.is_allocated() ) {
+        return nullptr;
+    }
 
-    return current_submap->fld[lx][ly].findField( t );
+    return current_submap->get_field( lx, ly ).findField( t );
 }
 
 bool map::add_field(const tripoint &p, const field_id t, int density, const int age)
@@ -5487,7 +5653,7 @@ bool map::add_field(const tripoint &p, const field_id t, int density, const int
     submap *const current_submap = get_submap_at( p, lx, ly );
     current_submap->is_uniform = false;
 
-    if( current_submap->fld[lx][ly].addField( t, density, age ) ) {
+    if( current_submap->get_field( lx, ly ).addField( t, density, age ) ) {
         //Only adding it to the count if it doesn't exist.
         current_submap->field_count++;
     }
@@ -5515,8 +5681,11 @@ void map::remove_field( const tripoint &p, const field_id field_to_remove )
 
     int lx, ly;
     submap * const current_submap = get_submap_at( p, lx, ly );
+    if( !current_submap->fld.is_allocated() ) {
+        return;
+    }
 
-    if( current_submap->fld[lx][ly].removeField( field_to_remove ) ) {
+    if( current_submap->get_field( lx, ly ).removeField( field_to_remove ) ) {
         // Only adjust the count if the field actually existed.
         current_submap->field_count--;
         const auto &fdata = fieldlist[ field_to_remove ];
@@ -6532,6 +6701,22 @@ void map::shift( const int sx, const int sy )
         reset_vehicle_cache( gridz );
     }
 
+    // Nothing refers to the submaps that left the map anymore, the blank ones can be compacted
+    for( int gridz = zmin; gridz <= zmax; gridz++ ) {
+        const tripoint omt_min = sm_to_omt_copy( tripoint( absx, absy, gridz ) );
+        const tripoint omt_max = sm_to_omt_copy( tripoint( absx + my_MAPSIZE - 1,
+                                 absy + my_MAPSIZE - 1, gridz ) );
+        for( int omx = omt_min.x; omx <= omt_max.x; omx++ ) {
+            for( int omy = omt_min.y; omy <= omt_max.y; omy++ ) {
+                const bool in_map = omx * 2 + 1 >= absx + sx && omx * 2 < absx + sx + my_MAPSIZE &&
+                                    omy * 2 + 1 >= absy + sy && omy * 2 < absy + sy + my_MAPSIZE;
+                if( !in_map ) {
+                    MAPBUFFER.compact_uniform( tripoint( omx, omy, gridz ) );
+                }
+            }
+        }
+    }
+
     g->setremoteveh( remoteveh );
 
     if( !support_cache_dirty.empty() ) {
@@ -7032,8 +7217,8 @@ void map::actualize( const int gridx, const int gridy, const int gridz )
 
             const auto &furn = this->furn( pnt ).obj();
             // plants contain a seed item which must not be removed under any circumstances
-            if( !furn.has_flag( "PLANT" ) ) {
-                remove_rotten_items( tmpsub->itm[x][y], pnt );
+            if( tmpsub->itm.is_allocated() && !furn.has_flag( "PLANT" ) ) {
+                remove_rotten_items( tmpsub->get_items( x, y ), pnt );
             }
 
             const auto trap_here = tmpsub->get_trap( x, y );
@@ -7242,7 +7427,7 @@ void map::spawn_monsters_submap_group( const tripoint &gp, mongroup &group, bool
                     point( rng( 0, SEEX ), rng( 0, SEEY ) );
                 const int turns = rl_dist( p, rand_dest ) + group.interest;
                 tmp.wander_to( rand_dest, turns );
-                add_msg( m_debug, "%s targetting %d,%d,%d", tmp.disp_name().c_str(),
+                add_msg_debug( "%s targetting %d,%d,%d", tmp.disp_name().c_str(),
                          tmp.wander_pos.x, tmp.wander_pos.y, tmp.wander_pos.z );
             }
 
@@ -7555,11 +7740,11 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
         build_floor_cache( z );
     }
 
-    tripoint start( 0, 0, minz );
-    tripoint end( my_MAPSIZE * SEEX, my_MAPSIZE * SEEY, maxz );
-    VehicleList vehs = get_vehicles( start, end );
     // Cache all the vehicle stuff in one loop
-    for( auto &v : vehs ) {
+    for( auto &v : get_vehicles() ) {
+        if( v.z < minz || v.z > maxz ) {
+            continue;
+        }
         auto &ch = get_cache( v.z );
         auto &outside_cache = ch.outside_cache;
         auto &transparency_cache = ch.transparency_cache;
@@ -7705,6 +7890,7 @@ void map::setsubmap( const size_t grididx, submap * const smap )
         return;
     }
     grid[grididx] = smap;
+    set_vehicle_list_dirty();
 }
 
 submap *map::get_submap_at( const int x, const int y, const int z ) const
@@ -7834,6 +8020,68 @@ void map::draw_fill_background( ter_id type )
     }
 }
 
+void map::draw_ter_column( const int x, const int y, const ter_id *ids, const size_t count )
+{
+    const tripoint p( x, y, abs_sub.z );
+    if( count == 0 || !inbounds( p ) ) {
+        return;
+    }
+    int lx, ly;
+    submap *const sm = get_submap_at( p, lx, ly );
+    if( ly + count > SEEY ) {
+        debugmsg( "terrain column at %d,%d crosses a submap border", x, y );
+        return;
+    }
+
+    set_transparency_cache_dirty( p.z );
+    set_outside_cache_dirty( p.z );
+    set_pathfinding_cache_dirty( p.z );
+
+    sm->is_uniform = false;
+    std::copy_n( ids, count, &sm->ter[lx][ly] );
+
+    for( size_t i = 0; i < count; i++ ) {
+        const ter_t &t = ids[i].obj();
+        const tripoint pos( x, y + int( i ), p.z );
+        if( t.trap != tr_null && t.trap != tr_ledge ) {
+            traplocs[t.trap].push_back( pos );
+        }
+        if( t.has_flag( TFLAG_NO_FLOOR ) ) {
+            set_floor_cache_dirty( p.z );
+            support_cache_dirty.insert( pos );
+        }
+        support_dirty( tripoint( pos.x, pos.y, pos.z + 1 ) );
+    }
+}
+
+void map::draw_furn_column( const int x, const int y, const furn_id *ids, const size_t count )
+{
+    const tripoint p( x, y, abs_sub.z );
+    if( count == 0 || !inbounds( p ) ) {
+        return;
+    }
+    int lx, ly;
+    submap *const sm = get_submap_at( p, lx, ly );
+    if( ly + count > SEEY ) {
+        debugmsg( "furniture column at %d,%d crosses a submap border", x, y );
+        return;
+    }
+
+    set_transparency_cache_dirty( p.z );
+    set_outside_cache_dirty( p.z );
+    set_floor_cache_dirty( p.z );
+    set_pathfinding_cache_dirty( p.z );
+
+    sm->is_uniform = false;
+    std::copy_n( ids, count, &sm->frn[lx][ly] );
+
+    for( size_t i = 0; i < count; i++ ) {
+        const tripoint pos( x, y + int( i ), p.z );
+        support_dirty( pos );
+        support_dirty( tripoint( pos.x, pos.y, pos.z + 1 ) );
+    }
+}
+
 void map::draw_fill_background( ter_id( *f )() )
 {
     draw_square_ter( f, 0, 0, SEEX * my_MAPSIZE - 1, SEEY * my_MAPSIZE - 1 );
@@ -8054,8 +8302,7 @@ void map::scent_blockers( std::array<std::array<bool, SEEX * MAPSIZE>, SEEY * MA
         return coord.x >= minx && coord.x <= maxx && coord.y >= miny && coord.y <= maxy;
     };
 
-    auto vehs = get_vehicles();
-    for( auto &wrapped_veh : vehs ) {
+    for( auto &wrapped_veh : get_vehicles() ) {
         vehicle &veh = *(wrapped_veh.v);
         auto obstacles = veh.all_parts_with_feature( VPFLAG_OBSTACLE, true );
         for( const int p : obstacles ) {
@@ -8105,7 +8352,7 @@ tripoint_range map::points_in_radius( const tripoint &center, size_t radius, siz
 level_cache &map::access_cache( int zlev )
 {
     if( zlev >= -OVERMAP_DEPTH && zlev <= OVERMAP_HEIGHT ) {
-        return *caches[zlev + OVERMAP_DEPTH];
+        return get_cache( zlev );
     }
 
     debugmsg( "access_cache called with invalid z-level: %d", zlev );
@@ -8115,7 +8362,7 @@ level_cache &map::access_cache( int zlev )
 const level_cache &map::access_cache( int zlev ) const
 {
     if( zlev >= -OVERMAP_DEPTH && zlev <= OVERMAP_HEIGHT ) {
-        return *caches[zlev + OVERMAP_DEPTH];
+        return get_cache( zlev );
     }
 
     debugmsg( "access_cache called with invalid z-level: %d", zlev );
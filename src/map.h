@@ -5,7 +5,10 @@
 #include <string>
 #include <set>
 #include <map>
+#include <unordered_map>
 #include <memory>
+#include <array>
+#include <queue>
 
 #include "game_constants.h"
 #include "cursesdef.h"
@@ -86,25 +89,25 @@ struct pathfinding_cache;
 
 class map_stack : public item_stack {
 private:
-    std::list<item> *mystack;
+    item_list *mystack;
     tripoint location;
     map *myorigin;
 public:
-    map_stack( std::list<item> *newstack, tripoint newloc, map *neworigin ) :
+    map_stack( item_list *newstack, tripoint newloc, map *neworigin ) :
     mystack(newstack), location(newloc), myorigin(neworigin) {};
     size_t size() const override;
     bool empty() const override;
-    std::list<item>::iterator erase( std::list<item>::iterator it ) override;
+    item_list::iterator erase( item_list::iterator it ) override;
     void push_back( const item &newitem ) override;
-    void insert_at( std::list<item>::iterator index, const item &newitem ) override;
-    std::list<item>::iterator begin();
-    std::list<item>::iterator end();
-    std::list<item>::const_iterator begin() const;
-    std::list<item>::const_iterator end() const;
-    std::list<item>::reverse_iterator rbegin();
-    std::list<item>::reverse_iterator rend();
-    std::list<item>::const_reverse_iterator rbegin() const;
-    std::list<item>::const_reverse_iterator rend() const;
+    void insert_at( item_list::iterator index, const item &newitem ) override;
+    item_list::iterator begin();
+    item_list::iterator end();
+    item_list::const_iterator begin() const;
+    item_list::const_iterator end() const;
+    item_list::reverse_iterator rbegin();
+    item_list::reverse_iterator rend();
+    item_list::const_reverse_iterator rbegin() const;
+    item_list::const_reverse_iterator rend() const;
     item &front() override;
     item &operator[]( size_t index ) override;
 };
@@ -160,7 +163,7 @@ struct level_cache {
 
     bool veh_in_active_range;
     bool veh_exists_at[SEEX * MAPSIZE][SEEY * MAPSIZE];
-    std::map< tripoint, std::pair<vehicle*,int> > veh_cached_parts;
+    std::unordered_map< tripoint, std::pair<vehicle*,int> > veh_cached_parts;
     std::set<vehicle*> vehicle_list;
 };
 
@@ -453,7 +456,12 @@ public:
 
  int coord_to_angle(const int x, const int y, const int tgtx, const int tgty) const;
 // Vehicles: Common to 2D and 3D
-    VehicleList get_vehicles();
+    /**
+     * All vehicles in the reality bubble, ordered by the submap they are on. The list is
+     * kept between calls and only rebuilt after vehicles were added, removed or moved to
+     * another submap, so don't hold on to it across such changes.
+     */
+    const VehicleList &get_vehicles();
     void add_vehicle_to_cache( vehicle * );
     void update_vehicle_cache( vehicle *, int old_zlevel );
     void reset_vehicle_cache( int zlev );
@@ -468,10 +476,13 @@ public:
     void vehmove();
     // Selects a vehicle to move, returns false if no moving vehicles
     bool vehproceed();
+    // Tells the vehicle schedule that the vehicles of_turn was changed outside of its own move
+    void reschedule_vehicle( const vehicle &veh );
     // Actually moves a vehicle
     bool vehact( vehicle &veh );
 
 // 3D vehicles
+    /** The vehicles of @ref get_vehicles that are on submaps in or next to the given area. */
     VehicleList get_vehicles( const tripoint &start, const tripoint &end );
     /**
     * Checks if tile is occupied by vehicle and by which part.
@@ -684,6 +695,14 @@ void draw_line_furn(furn_id type, int x1, int y1, int x2, int y2);
 void draw_fill_background(ter_id type);
 void draw_fill_background(ter_id (*f)());
 void draw_fill_background(const id_or_id<ter_t> & f);
+/**
+ * Copies count terrain (or furniture) ids into the column of tiles starting at (x, y) and
+ * going south. The column must not leave the submap it starts in. Unlike @ref ter_set this
+ * does not compare against the previous content, the caches of the whole z-level are marked
+ * dirty instead (like @ref draw_fill_background does).
+ */
+void draw_ter_column( int x, int y, const ter_id *ids, size_t count );
+void draw_furn_column( int x, int y, const furn_id *ids, size_t count );
 
 void draw_square_ter(ter_id type, int x1, int y1, int x2, int y2);
 void draw_square_furn(furn_id type, int x1, int y1, int x2, int y2);
@@ -779,7 +798,7 @@ void add_corpse( const tripoint &p );
 // Items: 2D
     map_stack i_at(int x, int y);
     void i_clear(const int x, const int y);
-    std::list<item>::iterator i_rem( const point location, std::list<item>::iterator it );
+    item_list::iterator i_rem( const point location, item_list::iterator it );
     int i_rem(const int x, const int y, const int index);
     void i_rem(const int x, const int y, item* it);
     void spawn_item(const int x, const int y, const std::string &itype_id,
@@ -795,16 +814,19 @@ void add_corpse( const tripoint &p );
     std::vector<item *> place_items( items_location loc, const int chance, const int x1, const int y1,
                                      const int x2, const int y2, bool ongrass, const int turn,
                                      int magazine = 0, int ammo = 0 );
-    void spawn_items(const int x, const int y, const std::vector<item> &new_items);
+    void spawn_items(const int x, const int y, std::vector<item> new_items);
     void create_anomaly(const int cx, const int cy, artifact_natural_property prop);
 // Items: 3D
     // Accessor that returns a wrapped reference to an item stack for safe modification.
     map_stack i_at( const tripoint &p );
+    // Read only accessor, it does not allocate the item layer of a submap that has no items,
+    // all such squares share one empty list.
+    const item_list &i_at( const tripoint &p ) const;
     item water_from( const tripoint &p );
     void i_clear( const tripoint &p );
     // i_rem() methods that return values act like container::erase(),
     // returning an iterator to the next item after removal.
-    std::list<item>::iterator i_rem( const tripoint &p, std::list<item>::iterator it );
+    item_list::iterator i_rem( const tripoint &p, item_list::iterator it );
     int i_rem( const tripoint &p, const int index );
     void i_rem( const tripoint &p, const item* it );
     void spawn_artifact( const tripoint &p );
@@ -816,7 +838,7 @@ void add_corpse( const tripoint &p );
     units::volume free_volume( const tripoint &p );
     units::volume stored_volume( const tripoint &p );
     item &add_item_or_charges( const tripoint &p, item new_item, int overflow_radius = 2 );
-    item &add_item_at( const tripoint &p, std::list<item>::iterator index, item new_item );
+    item &add_item_at( const tripoint &p, item_list::iterator index, item new_item );
     item &add_item( const tripoint &p, item new_item );
     item &spawn_an_item( const tripoint &p, item new_item,
                         const long charges, const int damlevel);
@@ -868,8 +890,14 @@ void add_corpse( const tripoint &p );
     */
     std::vector<item*> put_items_from_loc( items_location loc, const tripoint &p, const int turn = 0 );
 
-    // Similar to spawn_an_item, but spawns a list of items, or nothing if the list is empty.
-    std::vector<item*> spawn_items( const tripoint &p, const std::vector<item> &new_items );
+    /**
+     * Similar to spawn_an_item, but spawns a list of items, or nothing if the list is empty.
+     * Places the items like @ref add_item_or_charges would one by one, but looks up the
+     * square's flags, fields, free volume and item stack only once for the whole list.
+     * The submap's lighting and active items are still updated for each item. Items are
+     * moved onto the map, pass an rvalue to avoid copying them.
+     */
+    std::vector<item*> spawn_items( const tripoint &p, std::vector<item> new_items );
     void create_anomaly( const tripoint &p, artifact_natural_property prop );
 
  /**
@@ -1045,6 +1073,11 @@ public:
     void process_falling();
 
 // mapgen.cpp functions
+ /**
+  * Runs mapgen for the overmap terrain at the given submap coordinates (which must be
+  * even) and stores the 2x2 resulting submaps in the map buffer. The map keeps
+  * referring to them afterwards.
+  */
  void generate(const int x, const int y, const int z, const int turn);
  void post_process(unsigned zones);
  void place_spawns(const mongroup_id& group, const int chance,
@@ -1351,8 +1384,8 @@ private:
  void apply_light_arc( const tripoint &p, int angle, float luminance, int wideangle = 30 );
  void apply_light_ray(bool lit[MAPSIZE*SEEX][MAPSIZE*SEEY],
                       const tripoint &s, const tripoint &e, float luminance);
- void add_light_from_items( const tripoint &p, std::list<item>::iterator begin,
-                            std::list<item>::iterator end );
+ void add_light_from_items( const tripoint &p, item_list::iterator begin,
+                            item_list::iterator end );
  void calc_ray_end(int angle, int range, const tripoint &p, tripoint &out ) const;
  vehicle *add_vehicle_to_map( std::unique_ptr<vehicle> veh, bool merge_wrecks);
 
@@ -1407,6 +1440,43 @@ private:
      * Use @ref getsubmap or @ref setsubmap to access it.
      */
     std::vector<submap*> grid;
+    /**
+     * Movement order of the vehicles for the rest of the current turn. It is built
+     * once per turn (see @ref vehmove) and consumed by @ref vehproceed, which moves
+     * the vehicle with the most of_turn left.
+     * Entries refer to @ref scheduled_vehicles by index. An entry is outdated once
+     * @ref scheduled_of_turn of its vehicle differs from the one it was queued with.
+     */
+    struct vehicle_schedule_entry {
+        float of_turn;
+        size_t index;
+        bool operator<( const vehicle_schedule_entry &other ) const {
+            // On ties the vehicle that comes first in get_vehicles() moves first.
+            return of_turn < other.of_turn || ( of_turn == other.of_turn && index > other.index );
+        }
+    };
+    std::priority_queue<vehicle_schedule_entry> vehicle_schedule;
+    std::vector<vehicle *> scheduled_vehicles;
+    std::vector<float> scheduled_of_turn;
+    bool vehicle_schedule_valid = false;
+    void build_vehicle_schedule();
+    /** Queues the vehicle at this index of @ref scheduled_vehicles with its current of_turn. */
+    void requeue_vehicle( size_t index );
+    /**
+     * Takes the vehicle off the schedule, called when it is detached from the map so
+     * that the schedule never holds a pointer to a destroyed vehicle (or to a new one
+     * that got the same address).
+     */
+    void unschedule_vehicle( const vehicle *veh );
+    /** Whether the vehicle is still in the reality bubble, it may have been shifted out. */
+    bool vehicle_in_bubble( const vehicle *veh );
+    /** What @ref get_vehicles returns, unless @ref cached_vehicles_dirty is set. */
+    VehicleList cached_vehicles;
+    bool cached_vehicles_dirty = true;
+    /** Has @ref get_vehicles rebuild its list on the next call. */
+    void set_vehicle_list_dirty() {
+        cached_vehicles_dirty = true;
+    }
     /**
      * This vector contains an entry for each trap type, it has therefor the same size
      * as the @ref traplist vector. Each entry contains a list of all point on the map that
@@ -1415,14 +1485,16 @@ private:
      */
     std::vector< std::vector<tripoint> > traplocs;
     /**
-     * Holds caches for visibility, light, transparency and vehicles
+     * Holds caches for visibility, light, transparency and vehicles.
+     * All z-levels are allocated in the constructor, so const methods can be called
+     * from several threads at once.
      */
     std::array< std::unique_ptr<level_cache>, OVERMAP_LAYERS > caches;
 
     mutable std::array< std::unique_ptr<pathfinding_cache>, OVERMAP_LAYERS > pathfinding_caches;
 
     // Note: no bounds check
-    level_cache &get_cache( int zlev ) {
+    level_cache &get_cache( int zlev ) const {
         return *caches[zlev + OVERMAP_DEPTH];
     }
 
@@ -1432,7 +1504,7 @@ private:
 
   public:
     const level_cache &get_cache_ref( int zlev ) const {
-        return *caches[zlev + OVERMAP_DEPTH];
+        return get_cache( zlev );
     }
 
     const pathfinding_cache &get_pathfinding_cache_ref( int zlev ) const;
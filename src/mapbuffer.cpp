@@ -15,9 +15,10 @@
 #include "vehicle.h"
 #include "submap.h"
 
+#include <array>
 #include <sstream>
 
-#define dbg(x) DebugLog((DebugLevel)(x),D_MAP) << __FILE__ << ":" << __LINE__ << ": "
+#define dbg(x) DebugLogLazy((DebugLevel)(x),D_MAP) << __FILE__ << ":" << __LINE__ << ": "
 
 mapbuffer MAPBUFFER;
 
@@ -36,11 +37,12 @@ void mapbuffer::reset()
         delete elem.second;
     }
     submaps.clear();
+    uniform_submaps.clear();
 }
 
 bool mapbuffer::add_submap(const tripoint &p, submap *sm)
 {
-    if (submaps.count(p) != 0) {
+    if( submaps.count( p ) != 0 || uniform_submaps.count( p ) != 0 ) {
         return false;
     }
 
@@ -88,6 +90,17 @@ submap *mapbuffer::lookup_submap( const tripoint &p )
 
     auto iter = submaps.find( p );
     if( iter == submaps.end() ) {
+        const auto uniform = uniform_submaps.find( p );
+        if( uniform != uniform_submaps.end() ) {
+            submap *sm = new submap();
+            sm->is_uniform = true;
+            std::uninitialized_fill_n( &sm->ter[0][0], SEEX * SEEY, uniform->second.ter );
+            sm->turn_last_touched = uniform->second.turn_last_touched;
+            sm->temperature = uniform->second.temperature;
+            uniform_submaps.erase( uniform );
+            submaps[p] = sm;
+            return sm;
+        }
         try {
             return unserialize_submaps( p );
         } catch (const std::exception &err) {
@@ -99,6 +112,28 @@ submap *mapbuffer::lookup_submap( const tripoint &p )
     return iter->second;
 }
 
+bool mapbuffer::compact_uniform( const tripoint &om_addr )
+{
+    const tripoint base = omt_to_sm_copy( om_addr );
+    std::array<submap_map_t::iterator, 4> quad;
+    for( size_t i = 0; i < quad.size(); i++ ) {
+        quad[i] = submaps.find( tripoint( base.x + int( i % 2 ), base.y + int( i / 2 ), base.z ) );
+        // Only quads that are not saved anyway, the restored submaps are uniform again and
+        // would not be saved either, leaving an outdated quad file.
+        if( quad[i] == submaps.end() || !quad[i]->second->is_uniform ||
+            !quad[i]->second->is_blank_uniform() ) {
+            return false;
+        }
+    }
+    for( auto &iter : quad ) {
+        const submap &sm = *iter->second;
+        uniform_submaps[iter->first] = uniform_submap{ sm.ter[0][0], sm.turn_last_touched, sm.temperature };
+        delete iter->second;
+        submaps.erase( iter );
+    }
+    return true;
+}
+
 void mapbuffer::save( bool delete_after_save )
 {
     std::stringstream map_directory;
@@ -110,6 +145,15 @@ void mapbuffer::save( bool delete_after_save )
 
     const tripoint map_origin = sm_to_omt_copy( g->m.get_abs_sub() );
     const bool map_has_zlevels = g != nullptr && g->m.has_zlevels();
+    // delete_on_save deletes everything, otherwise delete submaps
+    // outside the current map.
+    const auto should_delete = [&]( const tripoint &om_addr ) {
+        const bool zlev_del = !map_has_zlevels && om_addr.z != g->get_levz();
+        return delete_after_save || zlev_del ||
+               om_addr.x < map_origin.x || om_addr.y < map_origin.y ||
+               om_addr.x > map_origin.x + (MAPSIZE / 2) ||
+               om_addr.y > map_origin.y + (MAPSIZE / 2);
+    };
 
     // A set of already-saved submaps, in global overmap coordinates.
     std::set<tripoint> saved_submaps;
@@ -130,31 +174,65 @@ void mapbuffer::save( bool delete_after_save )
         }
         saved_submaps.insert( om_addr );
 
-        // A segment is a chunk of 32x32 submap quads.
-        // We're breaking them into subdirectories so there aren't too many files per directory.
-        // Might want to make a set for this one too so it's only checked once per save().
-        std::stringstream dirname;
-        tripoint segment_addr = omt_to_seg_copy( om_addr );
-        dirname << map_directory.str() << "/" << segment_addr.x << "." <<
-                     segment_addr.y << "." << segment_addr.z;
-
-        std::stringstream quad_path;
-        quad_path << dirname.str() << "/" << om_addr.x << "." <<
-                  om_addr.y << "." << om_addr.z << ".map";
-
-        // delete_on_save deletes everything, otherwise delete submaps
-        // outside the current map.
-        const bool zlev_del = !map_has_zlevels && om_addr.z != g->get_levz();
-        save_quad( dirname.str(), quad_path.str(), om_addr, submaps_to_delete,
-                   delete_after_save || zlev_del ||
-                   om_addr.x < map_origin.x || om_addr.y < map_origin.y ||
-                   om_addr.x > map_origin.x + (MAPSIZE / 2) ||
-                   om_addr.y > map_origin.y + (MAPSIZE / 2) );
+        const std::string dirname = quad_dirname( map_directory.str(), om_addr );
+        save_quad( dirname, quad_filename( dirname, om_addr ), om_addr, submaps_to_delete,
+                   should_delete( om_addr ) );
         num_saved_submaps += 4;
     }
     for( auto &elem : submaps_to_delete ) {
         remove_submap( elem );
     }
+    // Compacted submaps are never saved, they get regenerated just like uniform submaps
+    for( auto iter = uniform_submaps.begin(); iter != uniform_submaps.end(); ) {
+        if( should_delete( sm_to_omt_copy( iter->first ) ) ) {
+            iter = uniform_submaps.erase( iter );
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void mapbuffer::save_quad( const tripoint &om_addr, bool delete_after_save )
+{
+    std::stringstream map_directory;
+    map_directory << world_generator->active_world->world_path << "/maps";
+    assure_dir_exist( map_directory.str().c_str() );
+
+    const std::string dirname = quad_dirname( map_directory.str(), om_addr );
+    std::list<tripoint> submaps_to_delete;
+    save_quad( dirname, quad_filename( dirname, om_addr ), om_addr, submaps_to_delete,
+               delete_after_save );
+    for( auto &elem : submaps_to_delete ) {
+        remove_submap( elem );
+    }
+    if( delete_after_save ) {
+        const tripoint base = omt_to_sm_copy( om_addr );
+        for( int x = 0; x <= 1; x++ ) {
+            for( int y = 0; y <= 1; y++ ) {
+                uniform_submaps.erase( base + tripoint( x, y, 0 ) );
+            }
+        }
+    }
+}
+
+std::string mapbuffer::quad_dirname( const std::string &map_directory, const tripoint &om_addr )
+{
+    // A segment is a chunk of 32x32 submap quads.
+    // We're breaking them into subdirectories so there aren't too many files per directory.
+    // Might want to make a set for this one too so it's only checked once per save().
+    std::stringstream dirname;
+    tripoint segment_addr = omt_to_seg_copy( om_addr );
+    dirname << map_directory << "/" << segment_addr.x << "." <<
+            segment_addr.y << "." << segment_addr.z;
+    return dirname.str();
+}
+
+std::string mapbuffer::quad_filename( const std::string &dirname, const tripoint &om_addr )
+{
+    std::stringstream quad_path;
+    quad_path << dirname << "/" << om_addr.x << "." <<
+              om_addr.y << "." << om_addr.z << ".map";
+    return quad_path.str();
 }
 
 void mapbuffer::save_quad( const std::string &dirname, const std::string &filename,
@@ -203,7 +281,7 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
             continue;
         }
 
-        submap *sm = submaps[submap_addr];
+        const submap *sm = submaps[submap_addr];
         if( sm == nullptr ) {
             continue;
         }
@@ -277,12 +355,12 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         jsout.start_array();
         for(int j = 0; j < SEEY; j++) {
             for(int i = 0; i < SEEX; i++) {
-                if( sm->itm[i][j].empty() ) {
+                if( sm->get_items( i, j ).empty() ) {
                     continue;
                 }
                 jsout.write( i );
                 jsout.write( j );
-                jsout.write( sm->itm[i][j] );
+                jsout.write( sm->get_items( i, j ) );
             }
         }
         jsout.end_array();
@@ -309,11 +387,11 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         for(int j = 0; j < SEEY; j++) {
             for(int i = 0; i < SEEX; i++) {
                 // Save fields
-                if (sm->fld[i][j].fieldCount() > 0) {
+                if (sm->get_field( i, j ).fieldCount() > 0) {
                     jsout.write( i );
                     jsout.write( j );
                     jsout.start_array();
-                    for( auto &fld : sm->fld[i][j] ) {
+                    for( auto &fld : sm->get_field( i, j ) ) {
                         const field_entry &cur = fld.second;
                             // We don't seem to have a string identifier for fields anywhere.
                             jsout.write( cur.getFieldType() );
@@ -328,15 +406,13 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
 
         jsout.member("cosmetics");
         jsout.start_array();
-        for (int j = 0; j < SEEY; j++) {
-            for (int i = 0; i < SEEX; i++) {
-                if (sm->cosmetics[i][j].size() > 0) {
-                    jsout.start_array();
-                    jsout.write(i);
-                    jsout.write(j);
-                    jsout.write(sm->cosmetics[i][j]);
-                    jsout.end_array();
-                }
+        for( const auto &cosm : sm->cosmetics ) {
+            if( !cosm.second.empty() ) {
+                jsout.start_array();
+                jsout.write( cosm.first.x );
+                jsout.write( cosm.first.y );
+                jsout.write( cosm.second );
+                jsout.end_array();
             }
         }
         jsout.end_array();
@@ -451,13 +527,13 @@ void mapbuffer::deserialize( JsonIn &jsin )
                             if ( tid == "t_rubble" ) {
                                 sm->ter[i][j] = ter_id( "t_dirt" );
                                 sm->frn[i][j] = furn_id( "f_rubble" );
-                                sm->itm[i][j].push_back( rock );
-                                sm->itm[i][j].push_back( rock );
+                                sm->get_items( i, j ).push_back( rock );
+                                sm->get_items( i, j ).push_back( rock );
                             } else if ( tid == "t_wreckage" ){
                                 sm->ter[i][j] = ter_id( "t_dirt" );
                                 sm->frn[i][j] = furn_id( "f_wreckage" );
-                                sm->itm[i][j].push_back( chunk );
-                                sm->itm[i][j].push_back( chunk );
+                                sm->get_items( i, j ).push_back( chunk );
+                                sm->get_items( i, j ).push_back( chunk );
                             } else if ( tid == "t_ash" ){
                                 sm->ter[i][j] = ter_id(  "t_dirt" );
                                 sm->frn[i][j] = furn_id( "f_ash" );
@@ -519,14 +595,14 @@ void mapbuffer::deserialize( JsonIn &jsin )
 
                         tmp.visit_items( [ &sm, i, j ]( item *it ) {
                             for( auto& e: it->magazine_convert() ) {
-                                sm->itm[i][j].push_back( e );
+                                sm->get_items( i, j ).push_back( e );
                             }
                             return VisitResponse::NEXT;
                         } );
 
-                        sm->itm[i][j].push_back( tmp );
+                        sm->get_items( i, j ).push_back( tmp );
                         if( tmp.needs_processing() ) {
-                            sm->active_items.add( std::prev(sm->itm[i][j].end()), point( i, j ) );
+                            sm->active_items.add( std::prev(sm->get_items( i, j ).end()), point( i, j ) );
                         }
                     }
                 }
@@ -551,10 +627,10 @@ void mapbuffer::deserialize( JsonIn &jsin )
                         int type = jsin.get_int();
                         int density = jsin.get_int();
                         int age = jsin.get_int();
-                        if (sm->fld[i][j].findField(field_id(type)) == NULL) {
+                        if (sm->get_field( i, j ).findField(field_id(type)) == NULL) {
                             sm->field_count++;
                         }
-                        sm->fld[i][j].addField(field_id(type), density, age);
+                        sm->get_field( i, j ).addField(field_id(type), density, age);
                     }
                 }
             } else if( submap_member_name == "graffiti" ) {
@@ -572,7 +648,7 @@ void mapbuffer::deserialize( JsonIn &jsin )
                     jsin.start_array();
                     int i = jsin.get_int();
                     int j = jsin.get_int();
-                    jsin.read(sm->cosmetics[i][j]);
+                    jsin.read( sm->get_cosmetics( i, j ) );
                     jsin.end_array();
                 }
             } else if( submap_member_name == "spawns" ) {
@@ -6,9 +6,12 @@
 #include <memory>
 #include <string>
 #include "enums.h"
+#include "int_id.h"
 struct point;
 struct tripoint;
 struct submap;
+struct ter_t;
+using ter_id = int_id<ter_t>;
 
 /**
  * Store, buffer, save and load the entire world map.
@@ -26,6 +29,12 @@ class mapbuffer
          * from the mapbuffer (and deleted).
          **/
         void save( bool delete_after_save = false );
+        /**
+         * Stores the 2x2 submaps of the overmap terrain om_addr into their savefile, like
+         * @ref save does for each of them. With delete_after_save they are also removed
+         * from the mapbuffer.
+         */
+        void save_quad( const tripoint &om_addr, bool delete_after_save );
 
         /** Delete all buffered submaps. **/
         void reset();
@@ -57,6 +66,15 @@ class mapbuffer
         submap *lookup_submap( int x, int y, int z );
         submap *lookup_submap( const tripoint &p );
 
+        /**
+         * Replaces the 2x2 submaps of the overmap terrain om_addr by a compact record if
+         * all of them are uniform and blank (see @ref submap::is_blank_uniform). @ref lookup_submap
+         * turns the record back into real submaps when they are needed again.
+         * The submaps are deleted, so no map may refer to them anymore.
+         * @return Whether the submaps have been compacted.
+         */
+        bool compact_uniform( const tripoint &om_addr );
+
     private:
         typedef std::map<tripoint, submap *> submap_map_t;
 
@@ -77,7 +95,17 @@ class mapbuffer
         void save_quad( const std::string &dirname, const std::string &filename,
                         const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
                         bool delete_after_save );
+        static std::string quad_dirname( const std::string &map_directory, const tripoint &om_addr );
+        static std::string quad_filename( const std::string &dirname, const tripoint &om_addr );
         submap_map_t submaps;
+
+        /** What is needed to rebuild a blank submap, see @ref compact_uniform. */
+        struct uniform_submap {
+            ter_id ter;
+            int turn_last_touched;
+            int temperature;
+        };
+        std::map<tripoint, uniform_submap> uniform_submaps;
 };
 
 extern mapbuffer MAPBUFFER;
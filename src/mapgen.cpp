@@ -39,7 +39,7 @@
 #include "catalua.h"
 #include "text_snippets.h"
 
-#define dbg(x) DebugLog((DebugLevel)(x),D_MAP_GEN) << __FILE__ << ":" << __LINE__ << ": "
+#define dbg(x) DebugLogLazy((DebugLevel)(x),D_MAP_GEN) << __FILE__ << ":" << __LINE__ << ": "
 
 #define MON_RADIUS 3
 
@@ -137,7 +137,7 @@ void map::generate(const int x, const int y, const int z, const int turn)
     int overy = y;
     sm_to_omt(overx, overy);
     const regional_settings *rsettings = &overmap_buffer.get_settings(overx, overy, z);
-    oter_id terrain_type = overmap_buffer.ter(overx, overy, z);
+    const oter_id terrain_type = overmap_buffer.ter(overx, overy, z);
     oter_id t_above = overmap_buffer.ter( overx    , overy    , z + 1 );
     oter_id t_north = overmap_buffer.ter( overx    , overy - 1, z );
     oter_id t_neast = overmap_buffer.ter( overx + 1, overy - 1, z );
@@ -150,13 +150,7 @@ void map::generate(const int x, const int y, const int z, const int turn)
 
     // This attempts to scale density of zombies inversely with distance from the nearest city.
     // In other words, make city centers dense and perimiters sparse.
-    float density = 0.0;
-    for (int i = overx - MON_RADIUS; i <= overx + MON_RADIUS; i++) {
-        for (int j = overy - MON_RADIUS; j <= overy + MON_RADIUS; j++) {
-            density += overmap_buffer.ter(i, j, z)->mondensity;
-        }
-    }
-    density = density / 100;
+    const float density = overmap_buffer.mondensity_sum( tripoint( overx, overy, z ), MON_RADIUS ) / 100.0f;
 
     draw_map(terrain_type, t_north, t_east, t_south, t_west, t_neast, t_seast, t_swest, t_nwest,
              t_above, turn, density, z, rsettings);
@@ -200,6 +194,7 @@ void map::generate(const int x, const int y, const int z, const int turn)
     }
 
     post_process(zones);
+    lua_hook_mapgen_postprocess( *this, terrain_type, abs_sub );
 
     // Okay, we know who are neighbors are.  Let's draw!
     // And finally save used submaps and delete the rest.
@@ -653,9 +648,11 @@ class jmapgen_sign : public jmapgen_piece {
 public:
     std::string signage;
     std::string snippet;
+    furn_id sign_furniture;
     jmapgen_sign( JsonObject &jsi ) : jmapgen_piece()
     , signage( jsi.get_string( "signage", "" ) )
     , snippet( jsi.get_string( "snippet", "" ) )
+    , sign_furniture( furn_str_id( "f_sign" ).id() )
     {
         if (signage.empty() && snippet.empty()) {
             jsi.throw_error("jmapgen_sign: needs either signage or snippet");
@@ -666,7 +663,7 @@ public:
         const int rx = x.get();
         const int ry = y.get();
         m.furn_set( rx, ry, f_null );
-        m.furn_set( rx, ry, furn_str_id( "f_sign" ) );
+        m.furn_set( rx, ry, sign_furniture );
 
         tripoint abs_sub = m.get_abs_sub();
 
@@ -792,19 +789,22 @@ public:
     jmapgen_int amount;
     std::string liquid;
     jmapgen_int chance;
+    const itype *liquid_type;
     jmapgen_liquid_item( JsonObject &jsi ) : jmapgen_piece()
     , amount( jsi, "amount", 0, 0)
     , liquid( jsi.get_string( "liquid" ) )
     , chance( jsi, "chance", 1, 1 )
+    , liquid_type( nullptr )
     {
         if( !item::type_is_defined( itype_id(liquid) ) ) {
             jsi.throw_error( "no such item type", "liquid" );
         }
+        liquid_type = item::find_type( liquid );
     }
     void apply( map &m, const jmapgen_int &x, const jmapgen_int &y, const float /*mon_density*/ ) const override
     {
         if ( one_in(chance.get()) ){
-            item newliquid( liquid, calendar::turn );
+            item newliquid( liquid_type, calendar::turn );
             if ( amount.valmax > 0 ){
                 newliquid.charges = amount.get();
             }
@@ -886,7 +886,8 @@ class jmapgen_loot : public jmapgen_piece {
                         e.ammo_set( default_ammo( e.ammo_type() ) );
                     }
                 }
-                m.spawn_items( tripoint( rng( x.val, x.valmax ), rng( y.val, y.valmax ), m.get_abs_sub().z ), spawn );
+                m.spawn_items( tripoint( rng( x.val, x.valmax ), rng( y.val, y.valmax ), m.get_abs_sub().z ),
+                               std::move( spawn ) );
             }
         }
 
@@ -1420,6 +1421,7 @@ bool mapgen_function_json::setup() {
             }
             qualifies = true;
             do_format = true;
+            compile_format();
        }
 
        // No fill_ter? No format? GTFO.
@@ -1571,28 +1573,58 @@ bool jmapgen_setmap::apply( map *m ) {
     return true;
 }
 
-void mapgen_function_json::formatted_set_incredibly_simple( map * const m ) const
+namespace
 {
-    for( size_t y = 0; y < mapgensize; y++ ) {
-        for( size_t x = 0; x < mapgensize; x++ ) {
-            const size_t index = calc_index( x, y );
-            const ter_furn_id &tdata = format[index];
-            if( tdata.furn != f_null ) {
-                if( tdata.ter != t_null ) {
-                    m->set( x, y, tdata.ter, tdata.furn );
-                } else if( fill_ter != t_null ) {
-                    m->set( x, y, fill_ter, tdata.furn );
-                } else {
-                    m->furn_set( x, y, tdata.furn );
-                }
-            } else if( tdata.ter != t_null ) {
-                m->ter_set( x, y, tdata.ter );
-            } else if( fill_ter != t_null ) {
-                m->ter_set( x, y, fill_ter );
+/**
+ * Splits every column of a mapgensize x mapgensize layer into runs of tiles that are
+ * wanted and do not cross a submap border. The ids of the runs are appended to ids.
+ */
+template<typename IdType, typename Func>
+void compile_layer( const size_t mapgensize, const IdType &null_id, std::vector<IdType> &ids,
+                    std::vector<jmapgen_layer_run> &runs, Func get )
+{
+    for( size_t x = 0; x < mapgensize; x++ ) {
+        for( size_t y = 0; y < mapgensize; ) {
+            IdType id = get( x, y );
+            if( id == null_id ) {
+                y++;
+                continue;
             }
+            jmapgen_layer_run run{ int( x ), int( y ), 0, ids.size() };
+            do {
+                ids.push_back( id );
+                run.count++;
+                y++;
+            } while( y < mapgensize && y % SEEY != 0 && ( id = get( x, y ) ) != null_id );
+            runs.push_back( run );
         }
     }
 }
+} // namespace
+
+void mapgen_function_json::compile_format()
+{
+    compile_layer<ter_id>( mapgensize, t_null, compiled_ter, ter_runs, [this]( size_t x, size_t y ) {
+        const ter_id ter = format[calc_index( x, y )].ter;
+        // fill_ter has already been drawn by the time the format is applied
+        return ter == fill_ter ? t_null : ter;
+    } );
+    compile_layer<furn_id>( mapgensize, f_null, compiled_furn, furn_runs, [this]( size_t x, size_t y ) {
+        return format[calc_index( x, y )].furn;
+    } );
+    format.clear();
+    format.shrink_to_fit();
+}
+
+void mapgen_function_json::apply_format( map &m ) const
+{
+    for( const jmapgen_layer_run &run : ter_runs ) {
+        m.draw_ter_column( run.x, run.y, &compiled_ter[run.offset], run.count );
+    }
+    for( const jmapgen_layer_run &run : furn_runs ) {
+        m.draw_furn_column( run.x, run.y, &compiled_furn[run.offset], run.count );
+    }
+}
 
 /*
  * Apply mapgen as per a derived-from-json recipe; in theory fast, but not very versatile
@@ -1602,7 +1634,7 @@ void mapgen_function_json::generate( map *m, const oter_id &terrain_type, const
         m->draw_fill_background( fill_ter );
     }
     if ( do_format ) {
-        formatted_set_incredibly_simple( m );
+        apply_format( *m );
     }
     for( auto &elem : setmap_points ) {
         elem.apply( m );
@@ -10540,7 +10572,9 @@ std::vector<item *> map::place_items( items_location loc, int chance, int x1, in
         debugmsg("map::place_items() called with an invalid chance (%d)", chance);
         return res;
     }
-    if (!item_group::group_is_defined(loc)) {
+    // Looked up once instead of for each spawn.
+    const Item_spawn_data *const group = item_controller->get_group( loc );
+    if( group == nullptr ) {
         const point omt = sm_to_omt_copy( get_abs_sub().x, get_abs_sub().y );
         const oter_id &oid = overmap_buffer.ter( omt.x, omt.y, get_abs_sub().z );
         debugmsg("place_items: invalid item group '%s', om_terrain = '%s' (%s)",
@@ -10569,7 +10603,7 @@ std::vector<item *> map::place_items( items_location loc, int chance, int x1, in
                 tries++;
             } while ( is_valid_terrain(px,py) && tries < 20 );
             if (tries < 20) {
-                auto put = put_items_from_loc( loc, tripoint( px, py, abs_sub.z ), turn );
+                auto put = spawn_items( tripoint( px, py, abs_sub.z ), group->create( turn ) );
                 res.insert( res.end(), put.begin(), put.end() );
             }
         }
@@ -10592,8 +10626,8 @@ std::vector<item *> map::place_items( items_location loc, int chance, int x1, in
 
 std::vector<item*> map::put_items_from_loc(items_location loc, const tripoint &p, int turn)
 {
-    const auto items = item_group::items_from(loc, turn);
-    return spawn_items( p, items );
+    auto items = item_group::items_from(loc, turn);
+    return spawn_items( p, std::move( items ) );
 }
 
 void map::add_spawn(const mtype_id& type, int count, int x, int y, bool friendly,
@@ -10680,6 +10714,7 @@ vehicle *map::add_vehicle(const vproto_id &type, const tripoint &p, const int di
         submap *place_on_submap = get_submap_at_grid( placed_vehicle->smx, placed_vehicle->smy, placed_vehicle->smz );
         place_on_submap->vehicles.push_back(placed_vehicle);
         place_on_submap->is_uniform = false;
+        set_vehicle_list_dirty();
 
         auto &ch = get_cache( placed_vehicle->smz );
         ch.vehicle_list.insert(placed_vehicle);
@@ -10908,9 +10943,17 @@ void map::rotate(int turns)
             std::swap( rotated[old_x][old_y], new_sm->ter[new_lx][new_ly] );
             std::swap( furnrot[old_x][old_y], new_sm->frn[new_lx][new_ly] );
             std::swap( traprot[old_x][old_y], new_sm->trp[new_lx][new_ly] );
-            std::swap( fldrot[old_x][old_y], new_sm->fld[new_lx][new_ly] );
-            std::swap( radrot[old_x][old_y], new_sm->rad[new_lx][new_ly] );
-            std::swap( cosmetics_rot[old_x][old_y], new_sm->cosmetics[new_lx][new_ly] );
+            // Only touch the sparse layers where they have content, so they stay unallocated otherwise
+            if( new_sm->fld.is_allocated() ) {
+                std::swap( fldrot[old_x][old_y], new_sm->get_field( new_lx, new_ly ) );
+            }
+            radrot[old_x][old_y] = new_sm->get_radiation( new_lx, new_ly );
+            new_sm->set_radiation( new_lx, new_ly, 0 );
+            const auto cosm = new_sm->cosmetics.find( point( new_lx, new_ly ) );
+            if( cosm != new_sm->cosmetics.end() ) {
+                cosmetics_rot[old_x][old_y].swap( cosm->second );
+                new_sm->cosmetics.erase( cosm );
+            }
             auto items = i_at(new_x, new_y);
             itrot[old_x][old_y].reserve( items.size() );
             // Copy items, if we move them, it'll wreck i_clear().
@@ -11037,9 +11080,13 @@ void map::rotate(int turns)
             std::swap( rotated[i][j], sm->ter[lx][ly] );
             std::swap( furnrot[i][j], sm->frn[lx][ly] );
             std::swap( traprot[i][j], sm->trp[lx][ly] );
-            std::swap( fldrot[i][j], sm->fld[lx][ly] );
-            std::swap( radrot[i][j], sm->rad[lx][ly] );
-            std::swap( cosmetics_rot[i][j], sm->cosmetics[lx][ly] );
+            if( fldrot[i][j].fieldCount() != 0 ) {
+                std::swap( fldrot[i][j], sm->get_field( lx, ly ) );
+            }
+            sm->set_radiation( lx, ly, radrot[i][j] );
+            if( !cosmetics_rot[i][j].empty() ) {
+                cosmetics_rot[i][j].swap( sm->get_cosmetics( lx, ly ) );
+            }
             for( auto &itm : itrot[i][j] ) {
                 add_item( i, j, itm );
             }
@@ -11543,7 +11590,7 @@ void set_science_room(map *m, int x1, int y1, bool faces_right, int turn)
         for (int i = x1; i <= x2; i++) {
             for (int j = y1; j <= y2; j++) {
                 m->ter_set(i, j, rotated[x2 - (i - x1)][j]);
-                m->spawn_items(i, j, itrot[x2 - (i - x1)][j]);
+                m->spawn_items(i, j, std::move( itrot[x2 - (i - x1)][j] ) );
             }
         }
     }
@@ -179,6 +179,17 @@ private:
     std::vector<jmapgen_obj> objects;
 };
 
+/**
+ * A run of tiles in one column of one submap that a compiled json mapgen writes in one go,
+ * the ids are taken from offset onwards in the matching id array.
+ */
+struct jmapgen_layer_run {
+    int x;
+    int y;
+    size_t count;
+    size_t offset;
+};
+
 class mapgen_function_json : public virtual mapgen_function {
     public:
     bool check_inbounds( const jmapgen_int &var ) const;
@@ -219,7 +230,18 @@ private:
     jmapgen_objects objects;
     jmapgen_int rotation;
 
-    void formatted_set_incredibly_simple( map *m ) const;
+    /**
+     * The "rows" of @ref format compiled by @ref compile_format into runs of pre-resolved
+     * ids. Tiles that would not change (undefined, or the same as fill_ter, which has already
+     * been drawn) are left out.
+     */
+    std::vector<ter_id> compiled_ter;
+    std::vector<jmapgen_layer_run> ter_runs;
+    std::vector<furn_id> compiled_furn;
+    std::vector<jmapgen_layer_run> furn_runs;
+
+    void compile_format();
+    void apply_format( map &m ) const;
 };
 
 /////////////////////////////////////////////////////////////////////////////////
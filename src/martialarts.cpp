@@ -675,28 +675,24 @@ void player::ma_ongethit_effects()
 template<typename C, typename F>
 static void accumulate_ma_buff_effects( const C &container, F f )
 {
-    for( auto &elem : container ) {
-        for( auto &eff : elem.second ) {
-            if( auto buff = ma_buff::from_effect( eff.second ) ) {
-                f( *buff, eff.second );
-            }
+    container.for_each( [&f]( const effect & eff ) {
+        if( auto buff = ma_buff::from_effect( eff ) ) {
+            f( *buff, eff );
         }
-    }
+    } );
 }
 
 template<typename C, typename F>
 static bool search_ma_buff_effect( const C &container, F f )
 {
-    for( auto &elem : container ) {
-        for( auto &eff : elem.second ) {
-            if( auto buff = ma_buff::from_effect( eff.second ) ) {
-                if( f( *buff, eff.second ) ) {
-                    return true;
-                }
-            }
+    bool found = false;
+    container.for_each( [&f, &found]( const effect & eff ) {
+        if( !found ) {
+            auto buff = ma_buff::from_effect( eff );
+            found = buff != nullptr && f( *buff, eff );
         }
-    }
-    return false;
+    } );
+    return found;
 }
 
 // bonuses
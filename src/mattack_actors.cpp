@@ -169,7 +169,7 @@ bool bite_actor::call( monster &z ) const
 
     z.mod_moves( -move_cost );
 
-    add_msg( m_debug, "%s attempting to bite %s", z.name().c_str(), target->disp_name().c_str() );
+    add_msg_debug( "%s attempting to bite %s", z.name().c_str(), target->disp_name().c_str() );
 
     int hitspread = target->deal_melee_attack( &z, z.hit_roll() );
 
@@ -194,7 +194,7 @@ bool bite_actor::call( monster &z ) const
 
     hit = dealt_damage.bp_hit;
     int damage_total = dealt_damage.total_damage();
-    add_msg( m_debug, "%s's bite did %d damage", z.name().c_str(), damage_total );
+    add_msg_debug( "%s's bite did %d damage", z.name().c_str(), damage_total );
     if( damage_total > 0 ) {
         auto msg_type = target == &g->u ? m_bad : m_info;
         //~ 1$s is monster name, 2$s bodypart in accusative
@@ -1244,12 +1244,12 @@ void print_damage_info( const damage_instance &di )
         ss << name_by_dt( du.type ) << ':' << amount << ',';
     }
 
-    add_msg( m_debug, "%stotal: %d", ss.str().c_str(), total );
+    add_msg_debug( "%stotal: %d", ss.str().c_str(), total );
 }
 
 void player::perform_technique(const ma_technique &technique, Creature &t, damage_instance &di, int &move_cost)
 {
-    add_msg( m_debug, "dmg before tec:" );
+    add_msg_debug( "dmg before tec:" );
     print_damage_info( di );
 
     for( damage_unit &du : di.damage_units ) {
@@ -1263,7 +1263,7 @@ void player::perform_technique(const ma_technique &technique, Creature &t, damag
         du.res_pen += technique.armor_penetration( *this, du.type );
     }
 
-    add_msg( m_debug, "dmg after tec:" );
+    add_msg_debug( "dmg after tec:" );
     print_damage_info( di );
 
     move_cost *= technique.move_cost_multiplier( *this );
@@ -1875,7 +1875,7 @@ std::vector<special_attack> player::mutation_attacks(Creature &t) const
 
             // Calculate actor ability value to be compared against mutation attack difficulty and add debug message
             const int proc_value = get_dex() + unarmed;
-            add_msg( m_debug, "%s proc chance: %d in %d", pr.first.c_str(), proc_value, mut_atk.chance );
+            add_msg_debug( "%s proc chance: %d in %d", pr.first.c_str(), proc_value, mut_atk.chance );
             // If the mutation attack fails to proc, bail out
             if( !x_in_y( proc_value, mut_atk.chance ) ) {
                 continue;
@@ -1886,7 +1886,7 @@ std::vector<special_attack> player::mutation_attacks(Creature &t) const
                 [this]( const std::string &blocker ) {
                     return has_trait( blocker );
                 } ) ) {
-                add_msg( m_debug, "%s not procing: blocked", pr.first.c_str() );
+                add_msg_debug( "%s not procing: blocked", pr.first.c_str() );
                 continue;
             }
 
@@ -1895,7 +1895,7 @@ std::vector<special_attack> player::mutation_attacks(Creature &t) const
                 [this]( const std::string &need ) {
                     return has_trait( need );
                 } ) ) {
-                add_msg( m_debug, "%s not procing: unmet req", pr.first.c_str() );
+                add_msg_debug( "%s not procing: unmet req", pr.first.c_str() );
                 continue;
             }
 
@@ -1924,7 +1924,7 @@ std::vector<special_attack> player::mutation_attacks(Creature &t) const
             if( tmp.damage.total_damage() > 0.0f ) {
                 ret.emplace_back( tmp );
             } else {
-                add_msg( m_debug, "%s not procing: zero damage", pr.first.c_str() );
+                add_msg_debug( "%s not procing: zero damage", pr.first.c_str() );
             }
         }
     }
@@ -2164,7 +2164,7 @@ double player::weapon_value( const item &weap, long ammo ) const
 
     // A small bonus for guns you can also use to hit stuff with (bayonets etc.)
     const double my_val = more + (less / 2.0);
-    add_msg( m_debug, "%s (%ld ammo) sum value: %.1f", weap.tname().c_str(), ammo, my_val );
+    add_msg_debug( "%s (%ld ammo) sum value: %.1f", weap.tname().c_str(), ammo, my_val );
     return my_val;
 }
 
@@ -2212,7 +2212,7 @@ double player::melee_value( const item &weap ) const
         my_value *= 1.0f + 0.5f * (sqrtf( reach ) - 1.0f);
     }
 
-    add_msg( m_debug, "%s as melee: %.1f", weap.tname().c_str(), my_value );
+    add_msg_debug( "%s as melee: %.1f", weap.tname().c_str(), my_value );
 
     return std::max( 0.0, my_value );
 }
@@ -217,6 +217,10 @@ void Messages::vadd_msg(const char *msg, va_list ap)
 
 void Messages::vadd_msg(game_message_type type, const char *msg, va_list ap)
 {
+    if (type == m_debug && !debug_mode) {
+        // Dropped by add_msg_string anyway, don't bother formatting it.
+        return;
+    }
     player_messages.impl_->add_msg_string(vstring_format(msg, ap), type);
 }
 
@@ -2,6 +2,7 @@
 #define MESSAGES_H
 
 #include "cursesdef.h" // WINDOW
+#include "debug.h"
 
 #include <memory>
 #include <string>
@@ -38,4 +39,10 @@ class Messages
 void add_msg( const char *msg, ... );
 void add_msg( game_message_type type, const char *msg, ... );
 
+/**
+ * Adds a m_debug message. Those are only shown in debug mode, so the arguments
+ * are only evaluated (and the message only formatted) when it is enabled.
+ */
+#define add_msg_debug(...) do { if( debug_mode ) { add_msg( m_debug, __VA_ARGS__ ); } } while( false )
+
 #endif
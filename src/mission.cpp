@@ -11,7 +11,7 @@
 
 #include <sstream>
 
-#define dbg(x) DebugLog((DebugLevel)(x),D_GAME) << __FILE__ << ":" << __LINE__ << ": "
+#define dbg(x) DebugLogLazy((DebugLevel)(x),D_GAME) << __FILE__ << ":" << __LINE__ << ": "
 
 mission mission_type::create( const int npc_id ) const
 {
@@ -1596,6 +1596,6 @@ std::vector<item*> talk_function::loot_building(const tripoint site)
         }
     }
     bay.save();
-    overmap_buffer.ter(site.x, site.y, site.z) = oter_id( "looted_building" );
+    overmap_buffer.ter_set( site, oter_id( "looted_building" ) );
     return items_found;
 }
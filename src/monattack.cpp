@@ -4269,7 +4269,7 @@ bool mattack::kamikaze(monster *z)
 {
     if (z->ammo.empty()) {
         // We somehow lost our ammo! Toggle this special off so we stop processing
-        add_msg(m_debug, "Missing ammo in kamikaze special for %s.", z->name().c_str());
+        add_msg_debug("Missing ammo in kamikaze special for %s.", z->name().c_str());
         z->disable_special("KAMIKAZE");
         return true;
     }
@@ -4289,14 +4289,14 @@ bool mattack::kamikaze(monster *z)
         auto usage = bomb_type->get_use( "transform" );
         if ( usage == nullptr ) {
             // Invalid item usage, Toggle this special off so we stop processing
-            add_msg(m_debug, "Invalid bomb transform use in kamikaze special for %s.", z->name().c_str());
+            add_msg_debug("Invalid bomb transform use in kamikaze special for %s.", z->name().c_str());
             z->disable_special("KAMIKAZE");
             return true;
         }
         const iuse_transform *actor = dynamic_cast<const iuse_transform *>( usage->get_actor_ptr() );
         if( actor == nullptr ) {
             // Invalid bomb item, Toggle this special off so we stop processing
-            add_msg(m_debug, "Invalid bomb type in kamikaze special for %s.", z->name().c_str());
+            add_msg_debug("Invalid bomb type in kamikaze special for %s.", z->name().c_str());
             z->disable_special("KAMIKAZE");
             return true;
         }
@@ -4321,14 +4321,14 @@ bool mattack::kamikaze(monster *z)
     auto use = act_bomb_type->get_use( "explosion" );
     if (use == nullptr ) {
         // Invalid active bomb item usage, Toggle this special off so we stop processing
-        add_msg(m_debug, "Invalid active bomb explosion use in kamikaze special for %s.", z->name().c_str());
+        add_msg_debug("Invalid active bomb explosion use in kamikaze special for %s.", z->name().c_str());
         z->disable_special("KAMIKAZE");
         return true;
     }
     const explosion_iuse *exp_actor = dynamic_cast<const explosion_iuse *>( use->get_actor_ptr() );
     if( exp_actor == nullptr ) {
         // Invalid active bomb item, Toggle this special off so we stop processing
-        add_msg(m_debug, "Invalid active bomb type in kamikaze special for %s.", z->name().c_str());
+        add_msg_debug("Invalid active bomb type in kamikaze special for %s.", z->name().c_str());
         z->disable_special("KAMIKAZE");
         return true;
     }
@@ -4466,7 +4466,7 @@ int grenade_helper(monster *const z, Creature *const target, const int dist,
     // if the player can see it
     if (g->u.sees(*z)) {
         if (data[att].message == "") {
-            add_msg(m_debug, "Invalid ammo message in grenadier special.");
+            add_msg_debug("Invalid ammo message in grenadier special.");
         } else {
             add_msg(m_bad, data[att].message.c_str(), z->name().c_str());
         }
@@ -4477,13 +4477,13 @@ int grenade_helper(monster *const z, Creature *const target, const int dist,
     auto usage = bomb_type->get_use( "place_monster" );
     if (usage == nullptr ) {
         // Invalid bomb item usage, Toggle this special off so we stop processing
-        add_msg(m_debug, "Invalid bomb item usage in grenadier special for %s.", z->name().c_str());
+        add_msg_debug("Invalid bomb item usage in grenadier special for %s.", z->name().c_str());
         return -1;
     }
     auto *actor = dynamic_cast<const place_monster_iuse *>( usage->get_actor_ptr() );
     if( actor == nullptr ) {
         // Invalid bomb item, Toggle this special off so we stop processing
-        add_msg(m_debug, "Invalid bomb type in grenadier special for %s.", z->name().c_str());
+        add_msg_debug("Invalid bomb type in grenadier special for %s.", z->name().c_str());
         return -1;
     }
 
@@ -689,7 +689,7 @@ void mdeath::detonate(monster *z)
                             item::find_type(bomb_id)->get_use( "transform" )->get_actor_ptr() );
             if( actor == nullptr ) {
                 // Invalid bomb item, move to the next ammo item
-                add_msg(m_debug, "Invalid bomb type in detonate mondeath for %s.", z->name().c_str());
+                add_msg_debug("Invalid bomb type in detonate mondeath for %s.", z->name().c_str());
                 continue;
             }
             dets.emplace_back( actor->target, actor->ammo_qty );
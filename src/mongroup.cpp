@@ -43,6 +43,46 @@ const MonsterGroup& string_id<MonsterGroup>::obj() const
     return MonsterGroupManager::GetMonsterGroup( *this );
 }
 
+mongroup_grid::mongroup_grid() : buckets( num_x * num_y ), count( 0 )
+{
+}
+
+void mongroup_grid::insert( const mongroup &group )
+{
+    buckets[bucket_index( group.pos )].push_back( group );
+    count++;
+}
+
+void mongroup_grid::clear()
+{
+    for( auto &bucket : buckets ) {
+        bucket.clear();
+    }
+    count = 0;
+}
+
+std::vector<mongroup *> mongroup_grid::groups_at( const tripoint &p )
+{
+    std::vector<mongroup *> result;
+    for( mongroup &mg : buckets[bucket_index( p )] ) {
+        if( mg.pos == p ) {
+            result.push_back( &mg );
+        }
+    }
+    return result;
+}
+
+std::vector<const mongroup *> mongroup_grid::groups_at( const tripoint &p ) const
+{
+    std::vector<const mongroup *> result;
+    for( const mongroup &mg : buckets[bucket_index( p )] ) {
+        if( mg.pos == p ) {
+            result.push_back( &mg );
+        }
+    }
+    return result;
+}
+
 bool mongroup::is_safe() const
 {
     return type.obj().is_safe;
@@ -1,11 +1,14 @@
 #ifndef MONGROUP_H
 #define MONGROUP_H
 
+#include <algorithm>
 #include <vector>
+#include <list>
 #include <map>
 #include <set>
 #include <string>
 #include "enums.h"
+#include "game_constants.h"
 #include "json.h"
 #include "string_id.h"
 #include "monster.h"
@@ -154,6 +157,123 @@ struct mongroup : public JsonSerializer, public JsonDeserializer {
     void serialize( JsonOut &jsout ) const override;
 };
 
+/**
+ * The monster groups of one overmap, bucketed by their (submap) position.
+ *
+ * Each bucket covers a square of @ref bucket_size submaps and keeps its groups
+ * in a list, so moving a group to another bucket is a splice that keeps
+ * pointers to it valid. Radius queries only visit the buckets overlapping the
+ * search area. Groups outside of the overmap (hordes can wander off it) are
+ * stored in the nearest edge bucket.
+ */
+class mongroup_grid
+{
+    public:
+        static constexpr int bucket_size = 12;
+
+        mongroup_grid();
+
+        void insert( const mongroup &group );
+        void clear();
+        size_t size() const {
+            return count;
+        }
+
+        /** All groups at exactly this position. */
+        std::vector<mongroup *> groups_at( const tripoint &p );
+        std::vector<const mongroup *> groups_at( const tripoint &p ) const;
+
+        template<typename F>
+        void for_each( F func ) {
+            for( auto &bucket : buckets ) {
+                for( mongroup &mg : bucket ) {
+                    func( mg );
+                }
+            }
+        }
+        template<typename F>
+        void for_each( F func ) const {
+            for( const auto &bucket : buckets ) {
+                for( const mongroup &mg : bucket ) {
+                    func( mg );
+                }
+            }
+        }
+
+        /**
+         * Calls func on every group that may be within radius of p. Candidates
+         * come from the overlapping buckets, the caller does the exact distance check.
+         */
+        template<typename F>
+        void for_each_near( const tripoint &p, int radius, F func ) {
+            const int x0 = bucket_coord( p.x - radius, num_x );
+            const int x1 = bucket_coord( p.x + radius, num_x );
+            const int y0 = bucket_coord( p.y - radius, num_y );
+            const int y1 = bucket_coord( p.y + radius, num_y );
+            for( int by = y0; by <= y1; by++ ) {
+                for( int bx = x0; bx <= x1; bx++ ) {
+                    for( mongroup &mg : buckets[by * num_x + bx] ) {
+                        func( mg );
+                    }
+                }
+            }
+        }
+
+        /**
+         * Calls func on every group, func may change the group position. Groups
+         * that end up in another bucket are moved there afterwards, so every
+         * group is visited exactly once.
+         */
+        template<typename F>
+        void update_each( F func ) {
+            std::list<mongroup> moved;
+            for( size_t i = 0; i < buckets.size(); i++ ) {
+                auto &bucket = buckets[i];
+                for( auto it = bucket.begin(); it != bucket.end(); ) {
+                    func( *it );
+                    if( bucket_index( it->pos ) != i ) {
+                        moved.splice( moved.end(), bucket, it++ );
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+            while( !moved.empty() ) {
+                auto &target = buckets[bucket_index( moved.front().pos )];
+                target.splice( target.end(), moved, moved.begin() );
+            }
+        }
+
+        /** Erases every group for which pred returns true, pred may modify the group. */
+        template<typename P>
+        void remove_if( P pred ) {
+            for( auto &bucket : buckets ) {
+                for( auto it = bucket.begin(); it != bucket.end(); ) {
+                    if( pred( *it ) ) {
+                        it = bucket.erase( it );
+                        count--;
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+        }
+
+    private:
+        static constexpr int num_x = ( OMAPX * 2 + bucket_size - 1 ) / bucket_size;
+        static constexpr int num_y = ( OMAPY * 2 + bucket_size - 1 ) / bucket_size;
+
+        static int bucket_coord( int sm, int num ) {
+            return sm < 0 ? 0 : std::min( sm / bucket_size, num - 1 );
+        }
+        static size_t bucket_index( const tripoint &p ) {
+            return bucket_coord( p.y, num_y ) * num_x + bucket_coord( p.x, num_x );
+        }
+
+        std::vector<std::list<mongroup>> buckets;
+        size_t count;
+};
+
 class MonsterGroupManager
 {
     public:
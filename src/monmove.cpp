@@ -57,9 +57,9 @@ bool monster::is_immune_field( const field_id fid ) const
         case fd_electricity:
             return has_flag( MF_ELECTRIC );
         case fd_fungal_haze:
-            return has_flag( MF_NO_BREATHE ) || type->in_species( FUNGUS );
+            return has_flag( MF_NO_BREATHE ) || ai->fungus;
         case fd_fungicidal_gas:
-            return !type->in_species( FUNGUS );
+            return !ai->fungus;
         default:
             // Suppress warning
             break;
@@ -104,7 +104,7 @@ bool monster::can_move_to( const tripoint &p ) const
         }
 
         // Don't enter open pits ever unless tiny, can fly or climb well
-        if( !( type->size == MS_TINY || can_climb ) &&
+        if( !( ai->size == MS_TINY || can_climb ) &&
             ( target == t_pit || target == t_pit_spiked || target == t_pit_glass ) ) {
             return false;
         }
@@ -112,7 +112,7 @@ bool monster::can_move_to( const tripoint &p ) const
         // The following behaviors are overridden when attacking
         if( attitude( &( g->u ) ) != MATT_ATTACK ) {
             if( g->m.has_flag( "SHARP", p ) &&
-                !( type->size == MS_TINY || has_flag( MF_FLIES ) ) ) {
+                !( ai->size == MS_TINY || has_flag( MF_FLIES ) ) ) {
                 return false;
             }
         }
@@ -192,18 +192,22 @@ float monster::rate_target( Creature &c, float best, bool smart ) const
 
 void monster::plan( const mfactions &factions )
 {
+    apply_plan( plan_target( factions ) );
+}
+
+monster_plan monster::plan_target( const mfactions &factions ) const
+{
+    monster_plan plan;
     // Bots are more intelligent than most living stuff
     bool smart_planning = has_flag( MF_PRIORITIZE_TARGETS );
-    Creature *target = nullptr;
+    Creature *&target = plan.target;
     // 8.6f is rating for tank drone 60 tiles away, moose 16 or boomer 33
     float dist = !smart_planning ? 1000 : 8.6f;
-    bool fleeing = false;
-    bool docile = friendly != 0 && has_effect( effect_docile );
-    bool angers_hostile_weak = type->anger.find( MTRIG_HOSTILE_WEAK ) != type->anger.end();
-    int angers_hostile_near =
-        ( type->anger.find( MTRIG_HOSTILE_CLOSE ) != type->anger.end() ) ? 5 : 0;
-    int fears_hostile_near = ( type->fear.find( MTRIG_HOSTILE_CLOSE ) != type->fear.end() ) ? 5 : 0;
-    bool group_morale = has_flag( MF_GROUP_MORALE ) && morale < type->morale;
+    bool &fleeing = plan.fleeing;
+    plan.docile = friendly != 0 && has_effect( effect_docile );
+    int angers_hostile_near = ai->anger[MTRIG_HOSTILE_CLOSE] ? 5 : 0;
+    int fears_hostile_near = ai->fear[MTRIG_HOSTILE_CLOSE] ? 5 : 0;
+    bool group_morale = has_flag( MF_GROUP_MORALE ) && morale < ai->morale;
     bool swarms = has_flag( MF_SWARMS );
     auto mood = attitude();
 
@@ -213,10 +217,10 @@ void monster::plan( const mfactions &factions )
         fleeing = fleeing || is_fleeing( g->u );
         target = &g->u;
         if( dist <= 5 ) {
-            anger += angers_hostile_near;
-            morale -= fears_hostile_near;
+            plan.anger += angers_hostile_near;
+            plan.morale -= fears_hostile_near;
         }
-    } else if( friendly != 0 && !docile ) {
+    } else if( friendly != 0 && !plan.docile ) {
         // Target unfriendly monsters, only if we aren't interacting with the player.
         for( int i = 0, numz = g->num_zombies(); i < numz; i++ ) {
             monster &tmp = g->zombie( i );
@@ -230,29 +234,28 @@ void monster::plan( const mfactions &factions )
         }
     }
 
-    if( docile ) {
-        if( friendly != 0 && target != nullptr ) {
-            set_dest( target->pos() );
-        }
-
-        return;
+    if( plan.docile ) {
+        return plan;
     }
 
     for( size_t i = 0; i < g->active_npc.size(); i++ ) {
         npc *me = g->active_npc[i];
         float rating = rate_target( *me, dist, smart_planning );
-        bool fleeing_from = is_fleeing( *me );
+        // With the changes from the hostiles seen so far
+        const int cur_anger = anger + plan.anger;
+        const int cur_morale = morale + plan.morale;
+        bool fleeing_from = is_fleeing( *me, cur_anger, cur_morale );
         // Switch targets if closer and hostile or scarier than current target
         if( ( rating < dist && fleeing ) ||
-            ( rating < dist && attitude( me ) == MATT_ATTACK ) ||
+            ( rating < dist && attitude( me, cur_anger, cur_morale ) == MATT_ATTACK ) ||
             ( !fleeing && fleeing_from ) ) {
             target = me;
             dist = rating;
         }
         fleeing = fleeing || fleeing_from;
         if( rating <= 5 ) {
-            anger += angers_hostile_near;
-            morale -= fears_hostile_near;
+            plan.anger += angers_hostile_near;
+            plan.morale -= fears_hostile_near;
         }
     }
 
@@ -272,8 +275,8 @@ void monster::plan( const mfactions &factions )
                     dist = rating;
                 }
                 if( rating <= 5 ) {
-                    anger += angers_hostile_near;
-                    morale -= fears_hostile_near;
+                    plan.anger += angers_hostile_near;
+                    plan.morale -= fears_hostile_near;
                 }
             }
         }
@@ -284,9 +287,7 @@ void monster::plan( const mfactions &factions )
     const auto actual_faction = friendly == 0 ? faction : mfaction_str_id( "player" );
     auto const &myfaction_iter = factions.find( actual_faction );
     if( myfaction_iter == factions.end() ) {
-        DebugLog( D_ERROR, D_GAME ) << disp_name() << " tried to find faction "
-                                    << actual_faction.id().str()
-                                    << " which wasn't loaded in game::monmove";
+        plan.missing_faction = true;
         swarms = false;
         group_morale = false;
     }
@@ -296,16 +297,15 @@ void monster::plan( const mfactions &factions )
             monster &mon = g->zombie( i );
             float rating = rate_target( mon, dist, smart_planning );
             if( group_morale && rating <= 10 ) {
-                morale += 10 - rating;
+                plan.morale += 10 - rating;
             }
             if( swarms ) {
                 if( rating < 5 ) { // Too crowded here
-                    wander_pos.x = posx() * rng( 1, 3 ) - mon.posx();
-                    wander_pos.y = posy() * rng( 1, 3 ) - mon.posy();
-                    wandf = 2;
+                    plan.crowded_by = &mon;
                     target = nullptr;
                     // Swarm to the furthest ally you can see
-                } else if( rating < INT_MAX && rating > dist && wandf <= 0 ) {
+                } else if( rating < INT_MAX && rating > dist && wandf <= 0 &&
+                           plan.crowded_by == nullptr ) {
                     target = &mon;
                     dist = rating;
                 }
@@ -313,16 +313,43 @@ void monster::plan( const mfactions &factions )
         }
     }
 
+    return plan;
+}
+
+void monster::apply_plan( const monster_plan &plan )
+{
+    Creature *target = plan.target;
+    if( plan.docile ) {
+        if( friendly != 0 && target != nullptr ) {
+            set_dest( target->pos() );
+        }
+
+        return;
+    }
+
+    anger += plan.anger;
+    morale += plan.morale;
+    if( plan.missing_faction ) {
+        DebugLog( D_ERROR, D_GAME ) << disp_name() << " tried to find faction "
+                                    << ( friendly == 0 ? faction : mfaction_str_id( "player" ) ).id().str()
+                                    << " which wasn't loaded in game::monmove";
+    }
+    if( plan.crowded_by != nullptr ) {
+        wander_pos.x = posx() * rng( 1, 3 ) - plan.crowded_by->posx();
+        wander_pos.y = posy() * rng( 1, 3 ) - plan.crowded_by->posy();
+        wandf = 2;
+    }
+
     if( target != nullptr ) {
 
         tripoint dest = target->pos();
         auto att_to_target = attitude_to( *target );
-        if( att_to_target == Attitude::A_HOSTILE && !fleeing ) {
+        if( att_to_target == Attitude::A_HOSTILE && !plan.fleeing ) {
             set_dest( dest );
-        } else if( fleeing ) {
+        } else if( plan.fleeing ) {
             set_dest( tripoint( posx() * 2 - dest.x, posy() * 2 - dest.y, posz() ) );
         }
-        if( angers_hostile_weak && att_to_target != Attitude::A_FRIENDLY ) {
+        if( ai->anger[MTRIG_HOSTILE_WEAK] && att_to_target != Attitude::A_FRIENDLY ) {
             int hp_per = target->hp_percentage();
             if( hp_per <= 70 ) {
                 anger += 10 - int( hp_per / 10 );
@@ -768,7 +795,7 @@ void monster::footsteps( const tripoint &p )
     if( digging() ) {
         volume = 10;
     }
-    switch( type->size ) {
+    switch( ai->size ) {
         case MS_TINY:
             return; // No sound for the tinies
         case MS_SMALL:
@@ -1141,7 +1168,7 @@ bool monster::move_to( const tripoint &p, bool force, const float stagger_adjust
         return true;
     }
     // TODO: Make tanks stop taking damage from rubble, because it's just silly
-    if( type->size != MS_TINY && on_ground ) {
+    if( ai->size != MS_TINY && on_ground ) {
         if( g->m.has_flag( "SHARP", pos() ) && !one_in( 4 ) ) {
             apply_damage( nullptr, bp_torso, rng( 1, 10 ) );
         }
@@ -1163,7 +1190,7 @@ bool monster::move_to( const tripoint &p, bool force, const float stagger_adjust
     // Diggers turn the dirt into dirtmound
     if( digging() ) {
         int factor = 0;
-        switch( type->size ) {
+        switch( ai->size ) {
             case MS_TINY:
                 factor = 100;
                 break;
@@ -27,6 +27,7 @@
 #include "line.h"
 #include "mapdata.h"
 #include "mtype.h"
+#include "monstergenerator.h"
 #include "field.h"
 #include "sounds.h"
 #include "npc.h"
@@ -112,6 +113,14 @@ const efftype_id effect_stunned( "stunned" );
 const efftype_id effect_tied( "tied" );
 const efftype_id effect_webbed( "webbed" );
 
+static const trait_iid trait_ANIMALDISCORD( "ANIMALDISCORD" );
+static const trait_iid trait_ANIMALEMPATH( "ANIMALEMPATH" );
+static const trait_iid trait_FLOWERS( "FLOWERS" );
+static const trait_iid trait_MYCUS_THRESH( "MYCUS_THRESH" );
+static const trait_iid trait_PHEROMONE_INSECT( "PHEROMONE_INSECT" );
+static const trait_iid trait_PHEROMONE_MAMMAL( "PHEROMONE_MAMMAL" );
+static const trait_iid trait_TERRIFYING( "TERRIFYING" );
+
 monster::monster()
 {
     position.x = 20;
@@ -135,11 +144,13 @@ monster::monster()
     upgrades = false;
     upgrade_time = -1;
     last_updated = 0;
+    ai = nullptr;
 }
 
 monster::monster( const mtype_id& id ) : monster()
 {
     type = &id.obj();
+    ai = &MonsterGenerator::generator().get_ai( *type );
     moves = type->speed;
     Creature::set_speed_base(type->speed);
     hp = type->hp;
@@ -187,6 +198,7 @@ void monster::poly( const mtype_id& id )
 {
     double hp_percentage = double(hp) / double(type->hp);
     type = &id.obj();
+    ai = &MonsterGenerator::generator().get_ai( *type );
     moves = 0;
     Creature::set_speed_base(type->speed);
     anger = type->agro;
@@ -488,7 +500,7 @@ bool monster::avoid_trap( const tripoint & /* pos */, const trap &tr ) const
 
 bool monster::has_flag(const m_flag f) const
 {
- return type->has_flag(f);
+ return ai->flags[f];
 }
 
 bool monster::can_see() const
@@ -533,8 +545,8 @@ int monster::sight_range( const int light_level ) const
         return 1;
     }
 
-    int range = ( light_level * type->vision_day ) +
-                ( ( DAYLIGHT_LEVEL - light_level ) * type->vision_night );
+    int range = ( light_level * ai->vision_day ) +
+                ( ( DAYLIGHT_LEVEL - light_level ) * ai->vision_night );
     range /= DAYLIGHT_LEVEL;
 
     return range;
@@ -597,11 +609,16 @@ Creature *monster::attack_target()
 }
 
 bool monster::is_fleeing(player &u) const
+{
+    return is_fleeing( u, anger, morale );
+}
+
+bool monster::is_fleeing( player &u, const int base_anger, const int base_morale ) const
 {
     if( has_effect( effect_run) ) {
         return true;
     }
-    monster_attitude att = attitude(&u);
+    monster_attitude att = attitude( &u, base_anger, base_morale );
     return (att == MATT_FLEE || (att == MATT_FOLLOW && rl_dist( pos(), u.pos() ) <= 4));
 }
 
@@ -649,6 +666,11 @@ Creature::Attitude monster::attitude_to( const Creature &other ) const
 }
 
 monster_attitude monster::attitude(player *u) const
+{
+    return attitude( u, anger, morale );
+}
+
+monster_attitude monster::attitude( player *u, const int base_anger, const int base_morale ) const
 {
     if( friendly != 0 ) {
         if( has_effect( effect_docile ) ) {
@@ -659,7 +681,7 @@ monster_attitude monster::attitude(player *u) const
         }
         // Zombies don't understand not attacking NPCs, but dogs and bots should.
         npc *np = dynamic_cast< npc* >( u );
-        if( np != nullptr && np->attitude != NPCATT_KILL && !type->in_species( ZOMBIE ) ) {
+        if( np != nullptr && np->attitude != NPCATT_KILL && !ai->zombie ) {
             return MATT_FRIEND;
         }
     }
@@ -670,25 +692,25 @@ monster_attitude monster::attitude(player *u) const
         return MATT_ZLAVE;
     }
 
-    int effective_anger  = anger;
-    int effective_morale = morale;
+    int effective_anger  = base_anger;
+    int effective_morale = base_morale;
 
     if (u != NULL) {
-        if (((type->in_species( MAMMAL ) && u->has_trait("PHEROMONE_MAMMAL")) ||
-             (type->in_species( INSECT ) && u->has_trait("PHEROMONE_INSECT"))) &&
+        if (((ai->mammal && u->has_trait( trait_PHEROMONE_MAMMAL )) ||
+             (ai->insect && u->has_trait( trait_PHEROMONE_INSECT ))) &&
             effective_anger >= 10) {
             effective_anger -= 20;
         }
 
-        if ( (type->id == mon_bee) && (u->has_trait("FLOWERS"))) {
+        if ( (type->id == mon_bee) && (u->has_trait( trait_FLOWERS ))) {
             effective_anger -= 10;
         }
 
-        if (u->has_trait("TERRIFYING")) {
+        if (u->has_trait( trait_TERRIFYING )) {
             effective_morale -= 10;
         }
 
-        if (u->has_trait("ANIMALEMPATH") && has_flag(MF_ANIMAL)) {
+        if (u->has_trait( trait_ANIMALEMPATH ) && has_flag(MF_ANIMAL)) {
             if (effective_anger >= 10) {
                 effective_anger -= 10;
             }
@@ -696,7 +718,7 @@ monster_attitude monster::attitude(player *u) const
                 effective_morale += 5;
             }
         }
-        if (u->has_trait("ANIMALDISCORD") && has_flag(MF_ANIMAL)) {
+        if (u->has_trait( trait_ANIMALDISCORD ) && has_flag(MF_ANIMAL)) {
             if (effective_anger >= 10) {
                 effective_anger += 10;
             }
@@ -704,7 +726,7 @@ monster_attitude monster::attitude(player *u) const
                 effective_morale -= 5;
             }
         }
-        if( type->in_species( FUNGUS ) && u->has_trait("MYCUS_THRESH") ) {
+        if( ai->fungus && u->has_trait( trait_MYCUS_THRESH ) ) {
             // We. Are. The Mycus.
             effective_anger = 0;
         }
@@ -735,19 +757,19 @@ int monster::hp_percentage() const
 
 void monster::process_triggers()
 {
-    anger += trigger_sum( type->anger );
-    anger -= trigger_sum( type->placate );
-    morale -= trigger_sum( type->fear );
-    if( morale != type->morale && one_in( 10 ) ) {
-        if( morale < type->morale ) {
+    anger += trigger_sum( ai->anger );
+    anger -= trigger_sum( ai->placate );
+    morale -= trigger_sum( ai->fear );
+    if( morale != ai->morale && one_in( 10 ) ) {
+        if( morale < ai->morale ) {
             morale++;
         } else {
             morale--;
         }
     }
 
-    if( anger != type->agro && one_in( 10 ) ) {
-        if( anger < type->agro ) {
+    if( anger != ai->agro && one_in( 10 ) ) {
+        if( anger < ai->agro ) {
             anger++;
         } else {
             anger--;
@@ -762,47 +784,32 @@ void monster::process_triggers()
 // This Adjustes anger/morale levels given a single trigger.
 void monster::process_trigger(monster_trigger trig, int amount)
 {
-    if (type->has_anger_trigger(trig)){
+    if (ai->anger[trig]){
         anger += amount;
     }
-    if (type->has_fear_trigger(trig)){
+    if (ai->fear[trig]){
         morale -= amount;
     }
-    if (type->has_placate_trigger(trig)){
+    if (ai->placate[trig]){
         anger -= amount;
     }
 }
 
 
-int monster::trigger_sum( const std::set<monster_trigger>& triggers ) const
+int monster::trigger_sum( const std::bitset<N_MONSTER_TRIGGERS> &triggers ) const
 {
     int ret = 0;
     bool check_terrain = false, check_meat = false, check_fire = false;
-    for( const auto &trigger : triggers ) {
-        switch( trigger ) {
-            case MTRIG_STALK:
-                if( anger > 0 && one_in( 5 ) ) {
-                    ret++;
-                }
-                break;
-
-            case MTRIG_MEAT:
-                // Disable meat checking for now
-                // It's hard to ever see it in action
-                // and even harder to balance it without making it exploity
-
-                // check_terrain = true;
-                // check_meat = true;
-                break;
-
-            case MTRIG_FIRE:
-                check_terrain = true;
-                check_fire = true;
-                break;
-
-            default:
-                break; // The rest are handled when the impetus occurs
-        }
+    // The rest are handled when the impetus occurs
+    if( triggers[MTRIG_STALK] && anger > 0 && one_in( 5 ) ) {
+        ret++;
+    }
+    // Meat checking (MTRIG_MEAT) is disabled for now
+    // It's hard to ever see it in action
+    // and even harder to balance it without making it exploity
+    if( triggers[MTRIG_FIRE] ) {
+        check_terrain = true;
+        check_fire = true;
     }
 
     if( check_terrain ) {
@@ -912,7 +919,7 @@ bool monster::block_hit(Creature *, body_part &, damage_instance &) {
 
 void monster::absorb_hit(body_part, damage_instance &dam) {
     for( auto &elem : dam.damage_units ) {
-        add_msg(m_debug, "Dam Type: %s :: Ar Pen: %.1f :: Armor Mult: %.1f", name_by_dt(elem.type).c_str(), elem.res_pen, elem.res_mult);
+        add_msg_debug("Dam Type: %s :: Ar Pen: %.1f :: Armor Mult: %.1f", name_by_dt(elem.type).c_str(), elem.res_pen, elem.res_mult);
         elem.amount -= std::min( resistances( *this ).get_effective_resist( elem ), elem.amount );
     }
 }
@@ -1669,40 +1676,37 @@ void monster::process_effects()
 {
     // Monster only effects
     int mod = 1;
-    for( auto &elem : effects ) {
-        for( auto &_effect_it : elem.second ) {
-            auto &it = _effect_it.second;
-            // Monsters don't get trait-based reduction, but they do get effect based reduction
-            bool reduced = resists_effect(it);
-
-            mod_speed_bonus(it.get_mod("SPEED", reduced));
-
-            int val = it.get_mod("HURT", reduced);
-            if (val > 0) {
-                if(it.activated(calendar::turn, "HURT", val, reduced, mod)) {
-                    apply_damage(nullptr, bp_torso, val);
-                }
+    effects.for_each( [this, mod]( effect & it ) {
+        // Monsters don't get trait-based reduction, but they do get effect based reduction
+        bool reduced = resists_effect(it);
+
+        mod_speed_bonus(it.get_mod("SPEED", reduced));
+
+        int val = it.get_mod("HURT", reduced);
+        if (val > 0) {
+            if(it.activated(calendar::turn, "HURT", val, reduced, mod)) {
+                apply_damage(nullptr, bp_torso, val);
             }
+        }
 
-            const efftype_id &id = _effect_it.second.get_id();
-            // MATERIALS-TODO: use fire resistance
-            if( id == effect_onfire ) {
-                int dam = 0;
-                if( made_of( material_id( "veggy" ) ) ) {
-                    dam = rng( 10, 20 );
-                } else if( made_of( material_id( "flesh" ) ) || made_of( material_id( "iflesh" ) ) ) {
-                    dam = rng( 5, 10 );
-                }
+        const efftype_id &id = it.get_id();
+        // MATERIALS-TODO: use fire resistance
+        if( id == effect_onfire ) {
+            int dam = 0;
+            if( made_of( material_id( "veggy" ) ) ) {
+                dam = rng( 10, 20 );
+            } else if( made_of( material_id( "flesh" ) ) || made_of( material_id( "iflesh" ) ) ) {
+                dam = rng( 5, 10 );
+            }
 
-                dam -= get_armor_type( DT_HEAT, bp_torso );
-                if( dam > 0 ) {
-                    apply_damage( nullptr, bp_torso, dam );
-                } else {
-                    it.set_duration( 0 );
-                }
+            dam -= get_armor_type( DT_HEAT, bp_torso );
+            if( dam > 0 ) {
+                apply_damage( nullptr, bp_torso, dam );
+            } else {
+                it.set_duration( 0 );
             }
         }
-    }
+    } );
 
     // Like with player/NPCs - keep the speed above 0
     const int min_speed_bonus = -0.75 * get_speed_base();
@@ -2108,6 +2112,6 @@ void monster::on_load()
         healed_speed = get_speed_base() - old_speed;
     }
 
-    add_msg( m_debug, "on_load() by %s, %d turns, healed %d hp, %d speed",
+    add_msg_debug( "on_load() by %s, %d turns, healed %d hp, %d speed",
              name().c_str(), dt, healed, healed_speed );
 }
@@ -4,6 +4,8 @@
 #include "creature.h"
 #include "enums.h"
 #include "int_id.h"
+#include "mtype.h"
+#include <bitset>
 #include <vector>
 
 class map;
@@ -43,6 +45,20 @@ enum monster_attitude {
     NUM_MONSTER_ATTITUDES
 };
 
+/** A target chosen by @ref monster::plan_target, to be carried out by @ref monster::apply_plan. */
+struct monster_plan {
+    Creature *target = nullptr;
+    bool fleeing = false;
+    bool docile = false;
+    /** A member of our swarm that stands too close, we wander away from it. */
+    const monster *crowded_by = nullptr;
+    /** Change of anger and morale from the hostiles nearby. */
+    int anger = 0;
+    int morale = 0;
+    /** Our faction was not among those passed to @ref monster::plan_target. */
+    bool missing_faction = false;
+};
+
 class monster : public Creature, public JsonSerializer, public JsonDeserializer
 {
         friend class editmap;
@@ -158,6 +174,13 @@ class monster : public Creature, public JsonSerializer, public JsonDeserializer
         // Pass all factions to mon, so that hordes of same-faction mons
         // do not iterate over each other
         void plan( const mfactions &factions );
+        /**
+         * The part of @ref plan that looks for a target. It only reads the game state (and
+         * does not roll any dice), so it can run for many monsters in parallel.
+         */
+        monster_plan plan_target( const mfactions &factions ) const;
+        /** The rest of @ref plan: sets the destination and changes mood according to @p plan. */
+        void apply_plan( const monster_plan &plan );
         void move(); // Actual movement
         void footsteps( const tripoint &p ); // noise made by movement
 
@@ -227,7 +250,7 @@ class monster : public Creature, public JsonSerializer, public JsonDeserializer
         Attitude attitude_to( const Creature &other ) const override;
         void process_triggers(); // Process things that anger/scare us
         void process_trigger( monster_trigger trig, int amount ); // Single trigger
-        int trigger_sum( const std::set<monster_trigger> &triggers ) const;
+        int trigger_sum( const std::bitset<N_MONSTER_TRIGGERS> &triggers ) const;
 
         bool is_underwater() const override;
         bool is_on_ground() const override;
@@ -355,6 +378,8 @@ class monster : public Creature, public JsonSerializer, public JsonDeserializer
         mfaction_id faction; // Our faction (species, for most monsters)
         int mission_id; // If we're related to a mission
         const mtype *type;
+        /** The AI descriptor of @ref type, what the per-turn AI reads instead of the type. */
+        const mtype_ai *ai;
         bool no_extra_death_drops;    // if true, don't spawn loot items as part of death
         bool no_corpse_quiet = false; //if true, monster dies quietly and leaves no corpse
         bool is_dead() const;
@@ -413,6 +438,12 @@ class monster : public Creature, public JsonSerializer, public JsonDeserializer
         bool dead;
         /** Legacy loading logic for monsters that are packing ammo. **/
         void normalize_ammo( const int old_ammo );
+        /**
+         * @ref attitude and @ref is_fleeing as if anger and morale had the given values,
+         * for @ref plan_target, which changes them while it looks around.
+         */
+        monster_attitude attitude( player *u, int base_anger, int base_morale ) const;
+        bool is_fleeing( player &u, int base_anger, int base_morale ) const;
         /** Normal upgrades **/
         int next_upgrade_time();
         bool upgrades;
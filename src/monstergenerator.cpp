@@ -79,6 +79,8 @@ void MonsterGenerator::reset()
 
     mon_species->reset();
     mon_species->insert( species_type() );
+
+    mon_ai.clear();
 }
 
 void MonsterGenerator::finalize_mtypes()
@@ -89,6 +91,11 @@ void MonsterGenerator::finalize_mtypes()
         set_mtype_flags( mon );
         set_species_ids( mon );
     }
+
+    mon_ai.clear();
+    for( const auto &elem : mon_templates->get_all() ) {
+        mon_ai.emplace_back( elem );
+    }
 }
 
 void MonsterGenerator::apply_species_attributes( mtype &mon )
@@ -557,6 +564,17 @@ void species_type::load( JsonObject &jo )
     optional( jo, was_loaded, "fear_triggers", fear_trig, trigger_reader );
 }
 
+const mtype_ai &MonsterGenerator::get_ai( const mtype &type ) const
+{
+    const size_t index = type.id.get_cid().to_i();
+    if( index >= mon_ai.size() ) {
+        debugmsg( "monster type %s has no AI descriptor", type.id.c_str() );
+        static const mtype_ai null_ai{};
+        return null_ai;
+    }
+    return mon_ai[index];
+}
+
 const std::vector<mtype> &MonsterGenerator::get_all_mtypes() const
 {
     return mon_templates->get_all();
@@ -8,9 +8,11 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <vector>
 
 class Creature;
 struct mtype;
+struct mtype_ai;
 enum m_flag : int;
 enum monster_trigger : int;
 enum m_size : int;
@@ -56,13 +58,15 @@ class MonsterGenerator
         void load_monster( JsonObject &jo );
         void load_species( JsonObject &jo );
 
-        // combines mtype and species information, sets bitflags
+        // combines mtype and species information, sets bitflags, builds the AI descriptors
         void finalize_mtypes();
 
 
         void check_monster_definitions() const;
 
         const std::vector<mtype> &get_all_mtypes() const;
+        /** The AI descriptor of @p type, which must be a finalized type. */
+        const mtype_ai &get_ai( const mtype &type ) const;
         mtype_id get_valid_hallucination() const;
         friend struct mtype;
         friend struct species_type;
@@ -95,6 +99,8 @@ class MonsterGenerator
         // Using unique_ptr here to avoid including generic_factory.h in this header.
         std::unique_ptr<generic_factory<mtype>> mon_templates;
         std::unique_ptr<generic_factory<species_type>> mon_species;
+        /** Indexed by the int id of the monster types, in the same order as @ref get_all_mtypes. */
+        std::vector<mtype_ai> mon_ai;
 
         std::map<std::string, phase_id> phase_map;
         std::map<std::string, mon_action_death> death_map;
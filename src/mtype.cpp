@@ -8,6 +8,10 @@
 #include <algorithm>
 
 const species_id MOLLUSK( "MOLLUSK" );
+const species_id ZOMBIE( "ZOMBIE" );
+const species_id FUNGUS( "FUNGUS" );
+const species_id MAMMAL( "MAMMAL" );
+const species_id INSECT( "INSECT" );
 
 mtype::mtype()
 {
@@ -59,6 +63,15 @@ bool mtype::has_special_attack( const std::string &attack_name ) const
     return special_attacks.find( attack_name ) != special_attacks.end();
 }
 
+mtype_ai::mtype_ai( const mtype &type )
+    : flags( type.bitflags ), anger( type.bitanger ), fear( type.bitfear ),
+      placate( type.bitplacate ), size( type.size ), agro( type.agro ), morale( type.morale ),
+      vision_day( type.vision_day ), vision_night( type.vision_night ),
+      zombie( type.in_species( ZOMBIE ) ), fungus( type.in_species( FUNGUS ) ),
+      mammal( type.in_species( MAMMAL ) ), insect( type.in_species( INSECT ) )
+{
+}
+
 bool mtype::has_flag( m_flag flag ) const
 {
     return bitflags[flag];
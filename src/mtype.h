@@ -227,6 +227,26 @@ public:
     }
 };
 
+/**
+ * The parts of a monster type that the monster AI reads every turn, packed together
+ * instead of spread over the large @ref mtype. Built for each type by
+ * MonsterGenerator::finalize_mtypes, monsters keep a pointer to theirs in monster::ai.
+ */
+struct mtype_ai {
+    std::bitset<MF_MAX> flags;
+    std::bitset<N_MONSTER_TRIGGERS> anger, fear, placate;
+    m_size size;
+    int agro;
+    int morale;
+    int vision_day;
+    int vision_night;
+    /** Membership in the species that the AI checks all the time. */
+    bool zombie, fungus, mammal, insect;
+
+    mtype_ai() = default;
+    explicit mtype_ai( const mtype &type );
+};
+
 struct mtype {
     private:
         friend class MonsterGenerator;
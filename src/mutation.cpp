@@ -16,7 +16,29 @@
 
 bool Character::has_trait(const std::string &b) const
 {
-    return my_mutations.count( b ) > 0;
+    return has_trait( trait_iid::find( b ) );
+}
+
+bool Character::has_trait( const trait_iid &id ) const
+{
+    return id.is_valid() && size_t( id.to_i() ) < trait_bits.size() && trait_bits[id.to_i()];
+}
+
+void Character::set_trait_bit( const std::string &mut, bool value )
+{
+    const trait_iid id( mut );
+    if( size_t( id.to_i() ) >= trait_bits.size() ) {
+        trait_bits.resize( std::max( trait_iid::count(), size_t( id.to_i() + 1 ) ), false );
+    }
+    trait_bits[id.to_i()] = value;
+}
+
+void Character::update_trait_bits()
+{
+    trait_bits.assign( trait_iid::count(), false );
+    for( const auto &mut : my_mutations ) {
+        set_trait_bit( mut.first, true );
+    }
 }
 
 bool Character::has_trait_flag( const std::string &b ) const
@@ -49,9 +71,11 @@ void Character::toggle_trait(const std::string &flag)
     const auto miter = my_mutations.find( flag );
     if( miter == my_mutations.end() ) {
         my_mutations[flag]; // Creates a new entry with default values
+        set_trait_bit( flag, true );
         mutation_effect(flag);
     } else {
         my_mutations.erase( miter );
+        set_trait_bit( flag, false );
         mutation_loss_effect(flag);
     }
     recalc_sight_limits();
@@ -63,6 +87,7 @@ void Character::set_mutation(const std::string &flag)
     const auto iter = my_mutations.find( flag );
     if( iter == my_mutations.end() ) {
         my_mutations[flag]; // Creates a new entry with default values
+        set_trait_bit( flag, true );
     } else {
         debugmsg("Trying to set %s mutation, but the character already has it.", flag.c_str());
     }
@@ -77,6 +102,7 @@ void Character::unset_mutation(const std::string &flag)
         debugmsg("Trying to unset %s mutation, but the character does not have it.", flag.c_str());
     } else {
         my_mutations.erase( iter );
+        set_trait_bit( flag, false );
     }
     recalc_sight_limits();
     reset_encumbrance();
@@ -7,6 +7,7 @@
 #include "color.h"
 #include "damage.h"
 #include "string_id.h"
+#include "interned_id.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -18,6 +19,7 @@ class martialart;
 using matype_id = string_id<martialart>;
 struct dream;
 struct mutation_branch;
+using trait_iid = interned_id<mutation_branch>;
 class item;
 
 extern std::vector<dream> dreams;
@@ -126,6 +126,8 @@ void mutation_branch::load( JsonObject &jsobj )
 {
     const std::string id = jsobj.get_string( "id" );
     mutation_branch &new_mut = mutation_data[id];
+    // Known traits get the low ids, so the bitsets of characters stay small.
+    trait_iid{ id };
 
     JsonArray jsarr;
     new_mut.name = _(jsobj.get_string("name").c_str());
@@ -2420,10 +2420,12 @@ void Character::empty_traits()
     }
     my_traits.clear();
     my_mutations.clear();
+    trait_bits.clear();
 }
 
 void Character::empty_skills()
 {
+    skill_changes++;
     for( auto &sk : _skills ) {
         sk.second.level( 0 );
     }
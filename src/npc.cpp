@@ -1117,7 +1117,7 @@ void npc::form_opinion( const player &u )
         attitude = NPCATT_FLEE;
     }
 
-    add_msg( m_debug, "%s formed an opinion of u: %s",
+    add_msg_debug( "%s formed an opinion of u: %s",
              name.c_str(), npc_attitude_name( attitude ).c_str() );
 }
 
@@ -1173,7 +1173,7 @@ void npc::make_angry()
         return; // We're already angry!
     }
 
-    add_msg( m_debug, "%s gets angry", name.c_str() );
+    add_msg_debug( "%s gets angry", name.c_str() );
     // Make associated faction, if any, angry at the player too.
     if( my_fac != nullptr ) {
         my_fac->likes_u = std::max( -50, my_fac->likes_u - 50 );
@@ -2021,7 +2021,7 @@ void npc::on_load()
     // Cap at some reasonable number, say 2 days (2 * 48 * 30 minutes)
     dt = std::min( dt, 2 * 48 * MINUTES(30) );
     int cur = now - dt;
-    add_msg( m_debug, "on_load() by %s, %d turns", name.c_str(), dt );
+    add_msg_debug( "on_load() by %s, %d turns", name.c_str(), dt );
     // First update with 30 minute granularity, then 5 minutes, then turns
     for( ; cur < now - MINUTES(30); cur += MINUTES(30) + 1 ) {
         update_body( cur, cur + MINUTES(30) );
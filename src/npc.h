@@ -242,6 +242,32 @@ struct npc_short_term_cache
     double my_weapon_value;
 
     std::vector<npc_target> friends;
+    /** Indices (into the game's monster list) of the monsters seen while building the cache. */
+    std::vector<size_t> seen_monsters;
+};
+
+/**
+ * The monsters of the reality bubble, bucketed by z-level and submap. It is built once
+ * before the NPCs take their turns so that each NPC only checks line of sight to the
+ * monsters that are close enough to be seen at all, instead of to every monster.
+ * Monsters move, spawn and die during those turns, so the buckets are built again
+ * whenever the creature tracker has changed since.
+ */
+class npc_threat_map
+{
+    public:
+        /** Buckets the current monster list of the game. */
+        void build();
+        /** Forgets the buckets, @ref monsters_near then checks every monster. */
+        void clear();
+        /** Indices of the monsters within @p range (on every axis) of @p center, sorted. */
+        std::vector<size_t> monsters_near( const tripoint &center, int range );
+
+    private:
+        std::vector<std::vector<size_t>> cells;
+        /** @ref Creature_tracker::revision the buckets were built at. */
+        unsigned long built_revision = 0;
+        bool built = false;
 };
 
 // DO NOT USE! This is old, use strings as talk topic instead, e.g. "TALK_AGREE_FOLLOW" instead of
@@ -2,6 +2,8 @@
 #include "npc.h"
 #include "rng.h"
 #include "game.h"
+#include "creature_tracker.h"
+#include "catalua.h"
 #include "map.h"
 #include "map_iterator.h"
 #include "projectile.h"
@@ -17,12 +19,13 @@
 #include "mtype.h"
 #include "field.h"
 #include "sounds.h"
+#include "visitable_inline.h"
 
 #include <algorithm>
 
 #define NPC_DANGER_VERY_LOW 5
 
-#define dbg(x) DebugLog((DebugLevel)(x),D_NPC) << __FILE__ << ":" << __LINE__ << ": "
+#define dbg(x) DebugLogLazy((DebugLevel)(x),D_NPC) << __FILE__ << ":" << __LINE__ << ": "
 
 const skill_id skill_firstaid( "firstaid" );
 const skill_id skill_gun( "gun" );
@@ -171,13 +174,95 @@ float npc::evaluate_enemy( const Creature &target ) const {
     }
 }
 
+static int threat_cell( int coord )
+{
+    return std::max( 0, std::min( coord / SEEX, MAPSIZE - 1 ) );
+}
+
+static size_t threat_cell_index( int cx, int cy, int z )
+{
+    return ( size_t( z + OVERMAP_DEPTH ) * MAPSIZE + cx ) * MAPSIZE + cy;
+}
+
+void npc_threat_map::build()
+{
+    cells.resize( OVERMAP_LAYERS * MAPSIZE * MAPSIZE );
+    for( auto &cell : cells ) {
+        cell.clear();
+    }
+    built_revision = g->critter_tracker->revision();
+    for( size_t i = 0; i < g->num_zombies(); i++ ) {
+        const tripoint &p = g->zombie( i ).pos();
+        if( p.z < -OVERMAP_DEPTH || p.z > OVERMAP_HEIGHT ) {
+            continue;
+        }
+        cells[threat_cell_index( threat_cell( p.x ), threat_cell( p.y ), p.z )].push_back( i );
+    }
+    built = true;
+}
+
+void npc_threat_map::clear()
+{
+    // Keep the buckets allocated for the next turn.
+    built = false;
+}
+
+std::vector<size_t> npc_threat_map::monsters_near( const tripoint &center, int range )
+{
+    std::vector<size_t> result;
+    const auto in_range = [&center, range]( size_t i ) {
+        return square_dist( center, g->zombie( i ).pos() ) <= range;
+    };
+    const size_t num_zombies = g->num_zombies();
+    if( !built ) {
+        for( size_t i = 0; i < num_zombies; i++ ) {
+            if( in_range( i ) ) {
+                result.push_back( i );
+            }
+        }
+        return result;
+    }
+    if( built_revision != g->critter_tracker->revision() ) {
+        build();
+    }
+
+    const int zmin = std::max( center.z - range, -OVERMAP_DEPTH );
+    const int zmax = std::min( center.z + range, OVERMAP_HEIGHT );
+    for( int z = zmin; z <= zmax; z++ ) {
+        for( int cx = threat_cell( center.x - range ); cx <= threat_cell( center.x + range ); cx++ ) {
+            for( int cy = threat_cell( center.y - range ); cy <= threat_cell( center.y + range ); cy++ ) {
+                for( size_t i : cells[threat_cell_index( cx, cy, z )] ) {
+                    if( in_range( i ) ) {
+                        result.push_back( i );
+                    }
+                }
+            }
+        }
+    }
+    std::sort( result.begin(), result.end() );
+    return result;
+}
+
+/**
+ * Upper bound of the distance at which @p np could possibly see a monster,
+ * following the checks of @ref player::sees and @ref Creature::sees.
+ */
+static int max_monster_sight( const npc &np )
+{
+    if( np.has_active_bionic( "bio_ground_sonar" ) ) {
+        // Sonar sees digging monsters at any distance.
+        return SEEX * MAPSIZE;
+    }
+    const int sight = std::max( np.sight_range( DAYLIGHT_LEVEL ), np.sight_range( 0 ) );
+    // Antennae sense monsters within 3 squares.
+    return std::max( { std::min( sight, np.unimpaired_range() ), np.clairvoyance(), 3 } );
+}
+
 void npc::assess_danger()
 {
     float assessment = 0;
-    for (size_t i = 0; i < g->num_zombies(); i++) {
-        if( sees( g->zombie( i ) ) ) {
-            assessment += g->zombie(i).type->difficulty;
-        }
+    for( size_t i : ai_cache.seen_monsters ) {
+        assessment += g->zombie( i ).type->difficulty;
     }
     assessment /= 10;
     if (assessment <= 2) {
@@ -241,7 +326,7 @@ float npc::character_danger( const Character &uc ) const
 
     ret *= std::max( 0.5, u.get_speed() / 100.0 );
 
-    add_msg( m_debug, "%s danger: %1f", u.disp_name().c_str(), ret );
+    add_msg_debug( "%s danger: %1f", u.disp_name().c_str(), ret );
     return ret;
 }
 
@@ -252,6 +337,12 @@ void npc::regen_ai_cache()
     ai_cache.danger = 0.0f;
     ai_cache.total_danger = 0.0f;
     ai_cache.my_weapon_value = weapon_value( weapon );
+    ai_cache.seen_monsters.clear();
+    for( size_t i : g->threat_map->monsters_near( pos(), max_monster_sight( *this ) ) ) {
+        if( sees( g->zombie( i ) ) ) {
+            ai_cache.seen_monsters.push_back( i );
+        }
+    }
     assess_danger();
 
     choose_target();
@@ -265,12 +356,12 @@ void npc::move()
     static const std::string no_target_str = "none";
     const Creature *target = current_target();
     const std::string &target_name = target != nullptr ? target->disp_name() : no_target_str;
-    add_msg( m_debug, "NPC %s: target = %s, danger = %.1f, range = %d",
+    add_msg_debug( "NPC %s: target = %s, danger = %.1f, range = %d",
              name.c_str(), target_name.c_str(), ai_cache.danger, confident_shoot_range( weapon ) );
 
     //faction opinion determines if it should consider you hostile
     if( my_fac != nullptr && my_fac->likes_u < -10 && is_enemy() && sees( g->u ) ) {
-        add_msg( m_debug, "NPC %s turning hostile because my_fac->likes_u %d < -10",
+        add_msg_debug( "NPC %s turning hostile because my_fac->likes_u %d < -10",
                  name.c_str(), my_fac->likes_u );
         if (op_of_u.fear > 10 + personality.aggression + personality.bravery) {
             attitude = NPCATT_FLEE;    // We don't want to take u on!
@@ -360,7 +451,7 @@ void npc::move()
         action = method_of_attack();
     }
 
-    add_msg( m_debug, "%s chose action %s.", name.c_str(), npc_action_name( action ).c_str() );
+    add_msg_debug( "%s chose action %s.", name.c_str(), npc_action_name( action ).c_str() );
 
     execute_action( action );
 }
@@ -684,7 +775,7 @@ void npc::execute_action( npc_action action )
         break;
 
     case npc_noop:
-        add_msg( m_debug, "%s skips turn (noop)", disp_name().c_str() );
+        add_msg_debug( "%s skips turn (noop)", disp_name().c_str() );
         return;
 
     default:
@@ -692,7 +783,7 @@ void npc::execute_action( npc_action action )
     }
 
     if( oldmoves == moves ) {
-        add_msg( m_debug, "NPC didn't use its moves.  Action %d.", action);
+        add_msg_debug( "NPC didn't use its moves.  Action %d.", action);
     }
 }
 
@@ -732,12 +823,8 @@ void npc::choose_target()
         return true;
     };
 
-    for( size_t i = 0; i < g->num_zombies(); i++ ) {
+    for( size_t i : ai_cache.seen_monsters ) {
         monster &mon = g->zombie( i );
-        if( !sees( mon ) ) {
-            continue;
-        }
-
         int dist = rl_dist( pos(), mon.pos() );
         // @todo This should include ranged attacks in calculation
         float scaled_distance = std::max( 1.0f, dist / mon.speed_rating() );
@@ -1003,7 +1090,7 @@ item &npc::find_reloadable()
     // TODO: Cache items checked for reloading to avoid re-checking same items every turn
     // TODO: Make it understand smaller and bigger magazines
     item *reloadable = nullptr;
-    visit_items( [this, &reloadable]( item *node ) {
+    visit_inline( [this, &reloadable]( item *node ) {
         if( !wants_to_reload( *this, *node ) ) {
             return VisitResponse::NEXT;
         }
@@ -1177,7 +1264,7 @@ npc_action npc::address_player()
 
 npc_action npc::long_term_goal_action()
 {
-    add_msg( m_debug, "long_term_goal_action()" );
+    add_msg_debug( "long_term_goal_action()" );
 
     if (mission == NPC_MISSION_SHOPKEEP || mission == NPC_MISSION_SHELTER) {
         return npc_pause;    // Shopkeeps just stay put.
@@ -1254,7 +1341,7 @@ int npc::confident_gun_mode_range( const item::gun_mode &gun, int at_recoil ) co
     // 5 round burst equivalent to ~2 individually aimed shots
     ret /= std::max( sqrt( gun.qty / 1.5 ), 1.0 );
 
-    add_msg( m_debug, "confident_gun_mode_range (%s=%d)", gun.mode.c_str(), ret );
+    add_msg_debug( "confident_gun_mode_range (%s=%d)", gun.mode.c_str(), ret );
     return std::max( ret, 1 );
 }
 
@@ -1279,7 +1366,7 @@ int npc::confident_throw_range( const item &thrown ) const
     deviation = std::max( 1.0, deviation );
 
     const int ret = std::min( int( confidence_mult() * 360 / deviation ), throw_range( thrown ) );
-    add_msg( m_debug, "confident_throw_range == %d", ret );
+    add_msg_debug( "confident_throw_range == %d", ret );
     return ret;
 }
 
@@ -1386,7 +1473,7 @@ bool npc::update_path( const tripoint &p, const bool no_bashing, bool force )
     const int bash_power = no_bashing ? 0 : smash_ability();
     auto new_path = g->m.route( pos(), p, bash_power, 1000 );
     if( new_path.empty() ) {
-        add_msg( m_debug, "Failed to path %d,%d,%d->%d,%d,%d",
+        add_msg_debug( "Failed to path %d,%d,%d->%d,%d,%d",
                  posx(), posy(), posz(), p.x, p.y, p.z );
     }
 
@@ -1594,7 +1681,7 @@ void npc::move_to_next()
     }
 
     if( path.empty() ) {
-        add_msg( m_debug, "npc::move_to_next() called with an empty path or path containing only current position" );
+        add_msg_debug( "npc::move_to_next() called with an empty path or path containing only current position" );
         move_pause();
         return;
     }
@@ -1802,13 +1889,13 @@ void npc::find_item()
 void npc::pick_up_item()
 {
     if( is_following() && !rules.allow_pick_up ) {
-        add_msg( m_debug, "%s::pick_up_item(); Cancelling on player's request", name.c_str() );
+        add_msg_debug( "%s::pick_up_item(); Cancelling on player's request", name.c_str() );
         fetching_item = false;
         moves -= 1;
         return;
     }
 
-    add_msg( m_debug, "%s::pick_up_item(); [%d, %d, %d] => [%d, %d, %d]", name.c_str(),
+    add_msg_debug( "%s::pick_up_item(); [%d, %d, %d] => [%d, %d, %d]", name.c_str(),
              posx(), posy(), posz(), wanted_item_pos.x, wanted_item_pos.y, wanted_item_pos.z );
     update_path( wanted_item_pos );
 
@@ -1833,7 +1920,7 @@ void npc::pick_up_item()
     }
 
     if( path.size() > 1 ) {
-        add_msg( m_debug, "Moving; [%d, %d, %d] => [%d, %d, %d]",
+        add_msg_debug( "Moving; [%d, %d, %d] => [%d, %d, %d]",
                  posx(), posy(), posz(), path[0].x, path[0].y, path[0].z );
 
         move_to_next();
@@ -1944,7 +2031,7 @@ std::list<item> npc::pick_up_item_vehicle( vehicle &veh, int part_index )
 
 void npc::drop_items(int weight, int volume)
 {
-    add_msg( m_debug, "%s is dropping items-%d,%d (%d items, wgt %d/%d, vol %d/%d)",
+    add_msg_debug( "%s is dropping items-%d,%d (%d items, wgt %d/%d, vol %d/%d)",
                  name.c_str(), weight, volume, inv.size(), weight_carried(),
                  weight_capacity(), volume_carried() / units::legacy_volume_factor, volume_capacity() / units::legacy_volume_factor);
 
@@ -2178,7 +2265,7 @@ bool npc::wield_better_weapon()
     // Fists aren't checked below
     compare_weapon( ret_null );
 
-    visit_items( [this, &compare_weapon]( item *node ) {
+    visit_inline( [this, &compare_weapon]( item *node ) {
         // Skip some bad items
         if( !node->is_gun() && node->type->melee_dam + node->type->melee_cut < 5 ) {
             return VisitResponse::SKIP;
@@ -2194,12 +2281,12 @@ bool npc::wield_better_weapon()
     // Until then, the NPCs should reload the guns as a last resort
 
     if( best == &weapon ) {
-        add_msg( m_debug, "Wielded %s is best at %.1f, not switching",
+        add_msg_debug( "Wielded %s is best at %.1f, not switching",
                  best->display_name().c_str(), best_value );
         return false;
     }
 
-    add_msg( m_debug, "Wielding %s at value %.1f",
+    add_msg_debug( "Wielding %s at value %.1f",
              best->display_name().c_str(), best_value );
 
     wield( *best );
@@ -2208,7 +2295,7 @@ bool npc::wield_better_weapon()
 
 bool npc::scan_new_items()
 {
-    add_msg( m_debug, "%s scanning new items", name.c_str() );
+    add_msg_debug( "%s scanning new items", name.c_str() );
     if( !wield_better_weapon() ) {
         // Stop "having new items" when you no longer do anything with them
         has_new_items = false;
@@ -2394,6 +2481,7 @@ void npc::activate_item(int item_index)
     const int oldmoves = moves;
     item *it = &i_at(item_index);
     if( it->is_tool() || it->is_food() ) {
+        lua_hook_item_use( *this, *it, pos() );
         it->type->invoke( this, it, pos() );
     }
 
@@ -2427,6 +2515,7 @@ void npc::heal_player( player &patient )
         return;
     }
 
+    lua_hook_item_use( *this, used, patient.pos() );
     long charges_used = used.type->invoke( this, &used, patient.pos(), "heal" );
     consume_charges( used, charges_used );
 
@@ -2455,6 +2544,7 @@ void npc::heal_self()
         add_msg( _("%s applies a %s"), name.c_str(), used.tname().c_str() );
     }
 
+    lua_hook_item_use( *this, used, pos() );
     long charges_used = used.type->invoke( this, &used, pos(), "heal" );
     consume_charges( used, charges_used );
 }
@@ -2833,13 +2923,13 @@ void npc::set_destination()
     surface_omt_loc.z = 0;
 
     goal = overmap_buffer.find_closest( surface_omt_loc, dest_type, 0, false );
-    add_msg( m_debug, "New goal: %s at %d,%d,%d", dest_type.c_str(), goal.x, goal.y, goal.z );
+    add_msg_debug( "New goal: %s at %d,%d,%d", dest_type.c_str(), goal.x, goal.y, goal.z );
 }
 
 void npc::go_to_destination()
 {
     if( goal == no_goal_point ) {
-        add_msg( m_debug, "npc::go_to_destination with no goal" );
+        add_msg_debug( "npc::go_to_destination with no goal" );
         move_pause();
         reach_destination();
         return;
@@ -2850,7 +2940,7 @@ void npc::go_to_destination()
     int sy = sgn( goal.y - omt_pos.y );
     const int minz = std::min( goal.z, posz() );
     const int maxz = std::max( goal.z, posz() );
-    add_msg( m_debug, "%s going (%d,%d,%d)->(%d,%d,%d)", name.c_str(),
+    add_msg_debug( "%s going (%d,%d,%d)->(%d,%d,%d)", name.c_str(),
              omt_pos.x, omt_pos.y, omt_pos.z, goal.x, goal.y, goal.z );
     if( goal == omt_pos ) {
         // We're at our desired map square!
@@ -2961,7 +3051,7 @@ std::string npc_action_name(npc_action action)
 void print_action( const char *prepend, npc_action action )
 {
     if( action != npc_undecided ) {
-        add_msg( m_debug, prepend, npc_action_name( action ).c_str() );
+        add_msg_debug( prepend, npc_action_name( action ).c_str() );
     }
 }
 
@@ -365,7 +365,7 @@ static std::map<std::string, json_talk_topic> json_talk_topics;
 #define SUCCESS_ACTION(func)  ret.back().success.effect = func
 #define FAILURE_ACTION(func)  ret.back().failure.effect = func
 
-#define dbg(x) DebugLog((DebugLevel)(x),D_GAME) << __FILE__ << ":" << __LINE__ << ": "
+#define dbg(x) DebugLogLazy((DebugLevel)(x),D_GAME) << __FILE__ << ":" << __LINE__ << ": "
 
 int topic_category( const talk_topic &topic );
 
@@ -4625,9 +4625,9 @@ std::string give_item_to( npc &p, bool allow_use, bool allow_carry )
     const double new_weapon_value = p.weapon_value( given, new_ammo );
     const double cur_weapon_value = p.weapon_value( p.weapon, our_ammo );
     if( allow_use ) {
-        add_msg( m_debug, "NPC evaluates own %s (%d ammo): %0.1f",
+        add_msg_debug( "NPC evaluates own %s (%d ammo): %0.1f",
                  p.weapon.tname().c_str(), our_ammo, cur_weapon_value );
-        add_msg( m_debug, "NPC evaluates your %s (%d ammo): %0.1f",
+        add_msg_debug( "NPC evaluates your %s (%d ammo): %0.1f",
                  given.tname().c_str(), new_ammo, new_weapon_value );
         if( new_weapon_value > cur_weapon_value ) {
             p.wield( given );
@@ -40,7 +40,7 @@
 #include <ostream>
 #include <algorithm>
 
-#define dbg(x) DebugLog((DebugLevel)(x),D_MAP_GEN) << __FILE__ << ":" << __LINE__ << ": "
+#define dbg(x) DebugLogLazy((DebugLevel)(x),D_MAP_GEN) << __FILE__ << ":" << __LINE__ << ": "
 
 #define STREETCHANCE 2
 #define NUM_FOREST 250
@@ -98,6 +98,7 @@ void set_oter_ids()   // fixme constify
 }
 
 std::unordered_map<std::string, oter_t> obasetermap;
+std::unordered_map<std::string, std::vector<oter_id>> ot_type_matches;
 //const regional_settings default_region_settings;
 t_regional_settings_map region_settings_map;
 
@@ -302,6 +303,21 @@ bool is_ot_type(const std::string &otype, const oter_id &oter)
     return oter_str.str()[compare_size] == '_';
 }
 
+const std::vector<oter_id> &ot_types_matching( const std::string &otype )
+{
+    auto iter = ot_type_matches.find( otype );
+    if( iter == ot_type_matches.end() ) {
+        std::vector<oter_id> matches;
+        for( const oter_t &ot : oterlist ) {
+            if( is_ot_type( otype, ot.loadid ) ) {
+                matches.push_back( ot.loadid );
+            }
+        }
+        iter = ot_type_matches.emplace( otype, std::move( matches ) ).first;
+    }
+    return iter->second;
+}
+
 bool road_allowed(const oter_id &ter)
 {
     return ter->has_flag( allow_road );
@@ -369,6 +385,7 @@ void reset_overmap_terrain()
 {
     otermap.clear();
     oterlist.clear();
+    ot_type_matches.clear();
 }
 
 /*
@@ -942,14 +959,7 @@ void apply_region_overlay(JsonObject &jo, regional_settings &region)
 
 overmap::overmap(int const x, int const y): loc(x, y), nullret(""), nullbool(false)
 {
-    const std::string rsettings_id = get_world_option<std::string>( "DEFAULT_REGION" );
-    t_regional_settings_map_citr rsit = region_settings_map.find( rsettings_id );
-
-    if ( rsit == region_settings_map.end() ) {
-        debugmsg("overmap(%d,%d): can't find region '%s'", x, y, rsettings_id.c_str() ); // gonna die now =[
-    }
-    settings = rsit->second;
-
+    init_settings( get_world_option<std::string>( "DEFAULT_REGION" ) );
     init_layers();
     try {
         open();
@@ -958,6 +968,17 @@ overmap::overmap(int const x, int const y): loc(x, y), nullret(""), nullbool(fal
     }
 }
 
+overmap::overmap( int const x, int const y, rng_stream &stream,
+                  const overmap_generation_options &options, const overmap *north,
+                  const overmap *east, const overmap *south, const overmap *west )
+    : loc( x, y ), nullret( "" ), nullbool( false )
+{
+    init_settings( options.region );
+    init_layers();
+    rng_stream_scope scope( stream );
+    generate( options, north, east, south, west );
+}
+
 overmap::overmap(): loc(0, 0), nullret(""), nullbool(false)
 {
     t_regional_settings_map_citr rsit = region_settings_map.find( "default" );
@@ -973,6 +994,61 @@ overmap::~overmap()
 {
 }
 
+/**
+ * Points of an overmap within radius of center on its z-level. Like map::points_in_radius,
+ * which generation used before, but it does not depend on the game map.
+ */
+static tripoint_range om_points_in_radius( const tripoint &center, int radius )
+{
+    return tripoint_range( tripoint( std::max( center.x - radius, 0 ), std::max( center.y - radius, 0 ),
+                                     center.z ),
+                           tripoint( std::min( center.x + radius, OMAPX - 1 ),
+                                     std::min( center.y + radius, OMAPY - 1 ), center.z ) );
+}
+
+overmap_generation_options overmap_generation_options::from_world()
+{
+    overmap_generation_options result;
+    result.region = get_world_option<std::string>( "DEFAULT_REGION" );
+    result.city_size = get_world_option<int>( "CITY_SIZE" );
+    result.city_spacing = get_world_option<int>( "CITY_SPACING" );
+    result.classic_zombies = get_world_option<bool>( "CLASSIC_ZOMBIES" );
+    result.wander_spawns = get_world_option<bool>( "WANDER_SPAWNS" );
+    result.static_spawn = get_world_option<bool>( "STATIC_SPAWN" );
+    return result;
+}
+
+void overmap::init_settings( const std::string &rsettings_id )
+{
+    t_regional_settings_map_citr rsit = region_settings_map.find( rsettings_id );
+
+    if ( rsit == region_settings_map.end() ) {
+        debugmsg("overmap(%d,%d): can't find region '%s'", loc.x, loc.y, rsettings_id.c_str() ); // gonna die now =[
+    }
+    settings = rsit->second;
+}
+
+rng_stream overmap::generation_stream( const point &om )
+{
+    return rng_root( rng_subsystem::overmap ).derive( tripoint( om.x, om.y, 0 ) );
+}
+
+std::unique_ptr<overmap> overmap::border_copy() const
+{
+    std::unique_ptr<overmap> result( new overmap() );
+    result->loc = loc;
+    for( int i = 0; i < OMAPX; i++ ) {
+        result->ter( i, 0, 0 ) = get_ter( i, 0, 0 );
+        result->ter( i, OMAPY - 1, 0 ) = get_ter( i, OMAPY - 1, 0 );
+    }
+    for( int j = 0; j < OMAPY; j++ ) {
+        result->ter( 0, j, 0 ) = get_ter( 0, j, 0 );
+        result->ter( OMAPX - 1, j, 0 ) = get_ter( OMAPX - 1, j, 0 );
+    }
+    result->roads_out = roads_out;
+    return result;
+}
+
 void overmap::init_layers()
 {
     for(int z = 0; z < OVERMAP_LAYERS; ++z) {
@@ -986,6 +1062,7 @@ void overmap::init_layers()
             }
         }
     }
+    ter_locations_dirty.fill( true );
 }
 
 oter_id &overmap::ter(const int x, const int y, const int z)
@@ -994,6 +1071,9 @@ oter_id &overmap::ter(const int x, const int y, const int z)
         return ot_null;
     }
 
+    // The caller may change the terrain through the reference.
+    ter_locations_dirty[z + OVERMAP_DEPTH] = true;
+    mondensity_table[z + OVERMAP_DEPTH].clear();
     return layer[z + OVERMAP_DEPTH].terrain[x][y];
 }
 
@@ -1034,19 +1114,19 @@ bool overmap::is_explored(int const x, int const y, int const z) const
 
 bool overmap::mongroup_check(const mongroup &candidate) const
 {
-    const auto matching_range = zg.equal_range(candidate.pos);
-    return std::find_if( matching_range.first, matching_range.second,
-        [candidate](std::pair<tripoint, mongroup> match) {
+    const auto matching = zg.groups_at( candidate.pos );
+    return std::find_if( matching.begin(), matching.end(),
+        [candidate]( const mongroup *match ) {
             // This is extra strict since we're using it to test serialization.
-            return candidate.type == match.second.type && candidate.pos == match.second.pos &&
-                candidate.radius == match.second.radius &&
-                candidate.population == match.second.population &&
-                candidate.target == match.second.target &&
-                candidate.interest == match.second.interest &&
-                candidate.dying == match.second.dying &&
-                candidate.horde == match.second.horde &&
-                candidate.diffuse == match.second.diffuse;
-        } ) != matching_range.second;
+            return candidate.type == match->type && candidate.pos == match->pos &&
+                candidate.radius == match->radius &&
+                candidate.population == match->population &&
+                candidate.target == match->target &&
+                candidate.interest == match->interest &&
+                candidate.dying == match->dying &&
+                candidate.horde == match->horde &&
+                candidate.diffuse == match->diffuse;
+        } ) != matching.end();
 }
 
 int overmap::num_mongroups() const
@@ -1233,10 +1313,9 @@ void overmap::set_scent( const tripoint &loc, scent_trace &new_scent )
     scents[loc] = new_scent;
 }
 
-void overmap::generate(const overmap *north, const overmap *east,
-                       const overmap *south, const overmap *west)
+void overmap::generate( const overmap_generation_options &options, const overmap *north,
+                        const overmap *east, const overmap *south, const overmap *west )
 {
-    dbg(D_INFO) << "overmap::generate start...";
     std::vector<city> road_points; // cities and roads_out together
     std::vector<point> river_start;// West/North endpoints of rivers
     std::vector<point> river_end; // East/South endpoints of rivers
@@ -1395,7 +1474,7 @@ void overmap::generate(const overmap *north, const overmap *east,
 
     // Cities and forests come next.
     // These're agnostic of adjacent maps, so it's very simple.
-    place_cities();
+    place_cities( options );
     place_forest();
 
     // Ideally we should have at least two exit points for roads, on different sides
@@ -1447,7 +1526,7 @@ void overmap::generate(const overmap *north, const overmap *east,
     }
     // And finally connect them via "highways"
     place_hiways(road_points, 0, "road");
-    place_specials();
+    place_specials( options );
     // Clean up our roads and rivers
     polish(0);
 
@@ -1462,9 +1541,8 @@ void overmap::generate(const overmap *north, const overmap *east,
     } while(requires_sub && (--z >= -OVERMAP_DEPTH));
 
     // Place the monsters, now that the terrain is laid out
-    place_mongroups();
+    place_mongroups( options );
     place_radios();
-    dbg(D_INFO) << "overmap::generate done";
 }
 
 
@@ -1551,7 +1629,7 @@ bool overmap::generate_sub(int const z)
                 // but at this point we don't know
                 requires_sub = true;
             } else if( oter_above == "mine_finale" ) {
-                for( auto &p : g->m.points_in_radius( tripoint( i, j, z ), 1, 0 ) ) {
+                for( auto &p : om_points_in_radius( tripoint( i, j, z ), 1 ) ) {
                     ter( p.x, p.y, p.z ) = oter_id( "spiral" );
                 }
                 ter( i, j, z ) = oter_id( "spiral_hub" );
@@ -1631,6 +1709,59 @@ std::vector<point> overmap::find_terrain(const std::string &term, int zlevel)
     return found;
 }
 
+const std::vector<point> &overmap::terrain_locations( const oter_id &type, int z )
+{
+    static const std::vector<point> none;
+    if( z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT ) {
+        return none;
+    }
+    const int zi = z + OVERMAP_DEPTH;
+    auto &index = ter_locations[zi];
+    if( ter_locations_dirty[zi] ) {
+        index.clear();
+        for( int y = 0; y < OMAPY; y++ ) {
+            for( int x = 0; x < OMAPX; x++ ) {
+                index[layer[zi].terrain[x][y]].push_back( point( x, y ) );
+            }
+        }
+        ter_locations_dirty[zi] = false;
+    }
+    const auto iter = index.find( type );
+    return iter != index.end() ? iter->second : none;
+}
+
+int overmap::mondensity_sum( int x1, int y1, int x2, int y2, int const z ) const
+{
+    x1 = std::max( x1, 0 );
+    y1 = std::max( y1, 0 );
+    x2 = std::min( x2, OMAPX - 1 );
+    y2 = std::min( y2, OMAPY - 1 );
+    if( x1 > x2 || y1 > y2 ) {
+        return 0;
+    }
+    if( z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT ) {
+        // Same as what get_ter returns there.
+        return ( x2 - x1 + 1 ) * ( y2 - y1 + 1 ) * ot_null->mondensity;
+    }
+    // table[index( x, y )] is the sum over all terrain left of x and above y.
+    const auto index = []( int x, int y ) {
+        return x * ( OMAPY + 1 ) + y;
+    };
+    std::vector<int> &table = mondensity_table[z + OVERMAP_DEPTH];
+    if( table.empty() ) {
+        const map_layer &l = layer[z + OVERMAP_DEPTH];
+        table.assign( ( OMAPX + 1 ) * ( OMAPY + 1 ), 0 );
+        for( int x = 0; x < OMAPX; x++ ) {
+            for( int y = 0; y < OMAPY; y++ ) {
+                table[index( x + 1, y + 1 )] = l.terrain[x][y]->mondensity + table[index( x, y + 1 )] +
+                                               table[index( x + 1, y )] - table[index( x, y )];
+            }
+        }
+    }
+    return table[index( x2 + 1, y2 + 1 )] - table[index( x1, y2 + 1 )] -
+           table[index( x2 + 1, y1 )] + table[index( x1, y1 )];
+}
+
 int overmap::dist_from_city( const tripoint &p )
 {
     int distance = 999;
@@ -2533,7 +2664,7 @@ tripoint overmap::draw_overmap(const tripoint &orig, const draw_data_t &data)
                         curs.y += diry;
                     } else if( action == "CONFIRM" ) { // Actually modify the overmap
                         if( terrain ) {
-                            overmap_buffer.ter( curs ) = uistate.place_terrain->id.id();
+                            overmap_buffer.ter_set( curs, uistate.place_terrain->id.id() );
                             overmap_buffer.set_seen( curs.x, curs.y, curs.z, true );
                         } else {
                             for( const auto &s_ter : uistate.place_special->terrains ) {
@@ -2543,7 +2674,7 @@ tripoint overmap::draw_overmap(const tripoint &orig, const draw_data_t &data)
                                 if( oter->has_flag( rotates ) ) {
                                     oter = rotate( oter, uistate.omedit_rotation );
                                 }
-                                overmap_buffer.ter( pos ) = oter;
+                                overmap_buffer.ter_set( pos, oter );
                                 overmap_buffer.set_seen( pos.x, pos.y, pos.z, true );
                             }
                         }
@@ -2602,18 +2733,13 @@ tripoint overmap::find_random_omt( const std::string &omt_base_type ) const
 
 void overmap::process_mongroups()
 {
-    for( auto it = zg.begin(); it != zg.end(); ) {
-        mongroup &mg = it->second;
+    zg.remove_if( []( mongroup &mg ) {
         if( mg.dying ) {
             mg.population = (mg.population * 4) / 5;
             mg.radius = (mg.radius * 9) / 10;
         }
-        if( mg.empty() ) {
-            zg.erase( it++ );
-        } else {
-            ++it;
-        }
-    }
+        return mg.empty();
+    } );
 }
 
 void overmap::clear_mon_groups()
@@ -2654,14 +2780,12 @@ void mongroup::wander( overmap &om )
 
 void overmap::move_hordes()
 {
-    // Prevent hordes to be moved twice by putting them in here after moving.
-    decltype(zg) tmpzg;
     //MOVE ZOMBIE GROUPS
-    for( auto it = zg.begin(); it != zg.end(); ) {
-        mongroup &mg = it->second;
+    // Groups that change their bucket are only re-filed after all have moved,
+    // so none of them is moved twice.
+    zg.update_each( [this]( mongroup &mg ) {
         if( !mg.horde ) {
-            ++it;
-            continue;
+            return;
         }
 
         if(mg.horde_behaviour == "") {
@@ -2676,7 +2800,7 @@ void overmap::move_hordes()
         }
 
         // Decrease movement chance according to the terrain we're currently on.
-        const oter_id& walked_into = ter(mg.pos.x, mg.pos.y, mg.pos.z);
+        const oter_id walked_into = get_ter(mg.pos.x, mg.pos.y, mg.pos.z);
         int movement_chance = 1;
         if(walked_into == ot_forest || walked_into == ot_forest_water) {
             movement_chance = 3;
@@ -2701,16 +2825,8 @@ void overmap::move_hordes()
             if( mg.pos.y < mg.target.y) {
                 mg.pos.y++;
             }
-
-            // Erase the group at it's old location, add the group with the new location
-            tmpzg.insert( std::pair<tripoint, mongroup>( mg.pos, mg ) );
-            zg.erase( it++ );
-        } else {
-            ++it;
         }
-    }
-    // and now back into the monster group map.
-    zg.insert( tmpzg.begin(), tmpzg.end() );
+    } );
 
 
     if(get_world_option<bool>( "WANDER_SPAWNS" ) ) {
@@ -2743,16 +2859,12 @@ void overmap::move_hordes()
 
             // Scan for compatible hordes in this area.
             mongroup *add_to_group = NULL;
-            auto group_bucket = zg.equal_range(p);
-            std::for_each( group_bucket.first, group_bucket.second,
-                [&](std::pair<const tripoint, mongroup> &horde_entry ) {
-                mongroup &horde = horde_entry.second;
-
+            for( mongroup *horde : zg.groups_at( p ) ) {
                 // We only absorb zombies into GROUP_ZOMBIE hordes
-                if(horde.horde && !horde.monsters.empty() && horde.type == GROUP_ZOMBIE) {
-                    add_to_group = &horde;
+                if(horde->horde && !horde->monsters.empty() && horde->type == GROUP_ZOMBIE) {
+                    add_to_group = horde;
                 }
-            });
+            }
 
             // If there is no horde to add the monster to, create one.
             if(add_to_group == NULL) {
@@ -2776,14 +2888,13 @@ void overmap::move_hordes()
 */
 void overmap::signal_hordes( const tripoint &p, const int sig_power)
 {
-    for( auto &elem : zg ) {
-        mongroup &mg = elem.second;
+    zg.for_each_near( p, sig_power, [&p, sig_power]( mongroup &mg ) {
         if( !mg.horde ) {
-            continue;
+            return;
         }
             const int dist = rl_dist( p, mg.pos );
             if( sig_power <= dist ) {
-                continue;
+                return;
             }
             // TODO: base this in monster attributes, foremost GOODHEARING.
             const int d_inter = (sig_power - dist) * 5;
@@ -2800,7 +2911,7 @@ void overmap::signal_hordes( const tripoint &p, const int sig_power)
                     mg.set_interest( d_inter );
                 }
             }
-    }
+    } );
 }
 
 void grow_forest_oter_id(oter_id &oid, bool swampy)
@@ -2985,13 +3096,13 @@ void overmap::place_river(point pa, point pb)
 
 spawns happen at... <cue Clue music>
 20:56 <kevingranade>: game:pawn_mon() in game.cpp:7380*/
-void overmap::place_cities()
+void overmap::place_cities( const overmap_generation_options &options )
 {
-    int op_city_size = get_world_option<int>( "CITY_SIZE" );
+    int op_city_size = options.city_size;
     if( op_city_size <= 0 ) {
         return;
     }
-    int op_city_spacing = get_world_option<int>( "CITY_SPACING" );
+    int op_city_spacing = options.city_spacing;
 
     // spacing dictates how much of the map is covered in cities
     //   city  |  cities  |   size N cities per overmap
@@ -3332,7 +3443,7 @@ bool overmap::build_slimepit( int x, int y, int z, int s )
 
     bool requires_sub = false;
     tripoint origin( x, y, z );
-    for( auto p : g->m.points_in_radius( origin, s + z + 1, 0 ) ) {
+    for( auto p : om_points_in_radius( origin, s + z + 1 ) ) {
         int dist = square_dist( x, y, p.x, p.y );
         if( one_in( 2 * dist ) ) {
             chip_rock( p.x, p.y, p.z );
@@ -4016,9 +4127,9 @@ bool overmap::allow_special(const overmap_special& special, const tripoint& p, i
 // iterate through specials, check if special is valid
 // pick & place special
 
-void overmap::place_specials()
+void overmap::place_specials( const overmap_generation_options &options )
 {
-    const bool CLASSIC_ZOMBIES = get_world_option<bool>( "CLASSIC_ZOMBIES" );
+    const bool CLASSIC_ZOMBIES = options.classic_zombies;
     /*
     This function uses pointers in to the @ref overmap_specials container.
     The pointers are assumed to be stable (overmap_specials should not be change during this
@@ -4035,7 +4146,7 @@ void overmap::place_specials()
             num_placed.emplace( &special, 0 );
         } else {
             // occurrence is actually a % chance, so less than 1
-            if( rand() % 100 <= special.min_occurrences ) {
+            if( rng( 0, 99 ) <= special.min_occurrences ) {
                 // Priority add one in this map
                 num_placed.emplace( &special, -1 );
             } else {
@@ -4221,11 +4332,11 @@ oter_id overmap::rotate(const oter_id &oter, int dir)
     return otert.directional_peers[dir];
 }
 
-void overmap::place_mongroups()
+void overmap::place_mongroups( const overmap_generation_options &options )
 {
     // Cities are full of zombies
     for( auto &elem : cities ) {
-        if( get_world_option<bool>( "WANDER_SPAWNS" ) ) {
+        if( options.wander_spawns ) {
             if( !one_in( 16 ) || elem.s > 5 ) {
                 mongroup m( mongroup_id( "GROUP_ZOMBIE" ), ( elem.x * 2 ), ( elem.y * 2 ), 0, int( elem.s * 2.5 ),
                             elem.s * 80 );
@@ -4235,13 +4346,13 @@ void overmap::place_mongroups()
                 add_mon_group( m );
             }
         }
-        if( !get_world_option<bool>( "STATIC_SPAWN" ) ) {
+        if( !options.static_spawn ) {
             add_mon_group( mongroup( mongroup_id( "GROUP_ZOMBIE" ), ( elem.x * 2 ), ( elem.y * 2 ), 0,
                                      int( elem.s * 2.5 ), elem.s * 80 ) );
         }
     }
 
-    if (!get_world_option<bool>( "CLASSIC_ZOMBIES" ) ) {
+    if( !options.classic_zombies ) {
         // Figure out where swamps are, and place swamp monsters
         for (int x = 3; x < OMAPX - 3; x += 7) {
             for (int y = 3; y < OMAPY - 3; y += 7) {
@@ -4260,7 +4371,7 @@ void overmap::place_mongroups()
         }
     }
 
-    if (!get_world_option<bool>( "CLASSIC_ZOMBIES" ) ) {
+    if( !options.classic_zombies ) {
         // Figure out where rivers are, and place swamp monsters
         for (int x = 3; x < OMAPX - 3; x += 7) {
             for (int y = 3; y < OMAPY - 3; y += 7) {
@@ -4279,7 +4390,7 @@ void overmap::place_mongroups()
         }
     }
 
-    if (!get_world_option<bool>( "CLASSIC_ZOMBIES" ) ) {
+    if( !options.classic_zombies ) {
         // Place the "put me anywhere" groups
         int numgroups = rng(0, 3);
         for (int i = 0; i < numgroups; i++) {
@@ -4365,7 +4476,12 @@ void overmap::open()
             pointers.push_back(overmap_buffer.get_existing(loc.x+i, loc.y));
         }
         // pointers looks like (north, south, west, east)
-        generate(pointers[0], pointers[3], pointers[1], pointers[2]);
+        rng_stream stream = generation_stream( loc );
+        rng_stream_scope scope( stream );
+        dbg(D_INFO) << "overmap::generate start...";
+        generate( overmap_generation_options::from_world(), pointers[0], pointers[3], pointers[1],
+                  pointers[2] );
+        dbg(D_INFO) << "overmap::generate done";
     }
 }
 
@@ -4497,7 +4613,7 @@ void overmap::add_mon_group(const mongroup &group)
     // makes the diffuse setting obsolete (as it only controls how the radius
     // is interpreted) - it's only used when adding monster groups with function.
     if( group.radius == 1 ) {
-        zg.insert(std::pair<tripoint, mongroup>( group.pos, group ) );
+        zg.insert( group );
         return;
     }
     // diffuse groups use a circular area, non-diffuse groups use a rectangular area
@@ -8,6 +8,7 @@
 #include "game_constants.h"
 #include "monster.h"
 #include "weather_gen.h"
+#include "mongroup.h"
 
 #include <array>
 #include <iosfwd>
@@ -20,9 +21,9 @@
 
 class input_context;
 class JsonObject;
-struct mongroup;
 class npc;
 class overmapbuffer;
+class rng_stream;
 
 // base oters: exactly what's defined in json before things are split up into blah_east or roadtype_ns, etc
 extern std::unordered_map<std::string, oter_t> obasetermap;
@@ -178,7 +179,7 @@ struct radio_tower {
  int frequency;
 radio_tower(int X = -1, int Y = -1, int S = -1, std::string M = "",
             radio_type T = MESSAGE_BROADCAST) :
-    x (X), y (Y), strength (S), type (T), message (M) {frequency = rand();}
+    x (X), y (Y), strength (S), type (T), message (M) {frequency = rng( 0, RAND_MAX );}
 };
 
 struct map_layer {
@@ -188,16 +189,52 @@ struct map_layer {
     std::vector<om_note> notes;
 };
 
+/**
+ * The world options overmap generation depends on. They are read on the main thread
+ * and handed to the generation, which may run on a worker thread.
+ */
+struct overmap_generation_options {
+    std::string region;
+    int city_size = 0;
+    int city_spacing = 0;
+    bool classic_zombies = false;
+    bool wander_spawns = false;
+    bool static_spawn = false;
+
+    /** The options of the active world. */
+    static overmap_generation_options from_world();
+};
+
 class overmap
 {
  public:
     overmap(const overmap&) = default;
     overmap(overmap &&) = default;
     overmap(int x, int y);
+    /**
+     * Generates a new overmap at the given overmap coordinates next to the given
+     * neighbors (any of which may be null), drawing all random numbers from @p stream.
+     * Unlike the constructor above this never loads from disk and never touches
+     * the overmap buffer, the game or the world options, so it can run on worker threads.
+     */
+    overmap( int x, int y, rng_stream &stream, const overmap_generation_options &options,
+             const overmap *north, const overmap *east, const overmap *south, const overmap *west );
     // Argument-less constructor bypasses trying to load matching file, only used for unit testing.
     overmap();
     ~overmap();
 
+    /**
+     * Stream a new overmap at the given overmap coordinates is generated from, derived
+     * from the world seed. The same world seed and neighbors yield the same overmap.
+     */
+    static rng_stream generation_stream( const point &om );
+    /**
+     * Copy of the parts of this overmap that the generation of its neighbors looks at
+     * (the z-level 0 terrain along the borders and @ref roads_out). Neighbors can be
+     * generated from it on other threads while this overmap keeps changing.
+     */
+    std::unique_ptr<overmap> border_copy() const;
+
     overmap& operator=(overmap const&) = default;
 
     point const& pos() const { return loc; }
@@ -217,6 +254,21 @@ class overmap
      * coordinates), or empty vector if no matching terrain is found.
      */
     std::vector<point> find_terrain(const std::string &term, int zlevel);
+    /**
+     * Local coordinates of every tile with exactly this terrain on the z-level,
+     * sorted by y, then x. The index behind this is built on first use and
+     * rebuilt once the z-level has been accessed through the non-const @ref ter.
+     * Not const because of that, so it needs the same exclusive access to the
+     * overmap as changing its terrain, and const access (e.g. from other threads)
+     * never writes to the overmap.
+     */
+    const std::vector<point> &terrain_locations( const oter_id &type, int z );
+    /**
+     * Sum of @ref oter_t::mondensity over the given rectangle of overmap terrain on
+     * z-level z. The corners are inclusive local coordinates, the parts outside of this
+     * overmap are ignored.
+     */
+    int mondensity_sum( int x1, int y1, int x2, int y2, int z ) const;
 
     oter_id& ter(const int x, const int y, const int z);
     const oter_id get_ter(const int x, const int y, const int z) const;
@@ -321,7 +373,7 @@ class overmap
   }
     void clear_mon_groups();
 private:
-    std::multimap<tripoint, mongroup> zg;
+    mongroup_grid zg;
 public:
     /** Unit test enablers to check if a given mongroup is present. */
     bool mongroup_check(const mongroup &candidate) const;
@@ -340,6 +392,11 @@ public:
   point loc;
 
     std::array<map_layer, OVERMAP_LAYERS> layer;
+    /** Per z-level index for @ref terrain_locations. */
+    std::array<std::unordered_map<oter_id, std::vector<point>>, OVERMAP_LAYERS> ter_locations;
+    std::array<bool, OVERMAP_LAYERS> ter_locations_dirty;
+    /** Per z-level summed-area table for @ref mondensity_sum, empty when outdated. */
+    mutable std::array<std::vector<int>, OVERMAP_LAYERS> mondensity_table;
 
   oter_id nullret;
   bool nullbool;
@@ -356,6 +413,7 @@ public:
     regional_settings settings;
 
   // Initialise
+  void init_settings( const std::string &region );
   void init_layers();
   // open existing overmap, or generate a new one
   void open();
@@ -372,7 +430,8 @@ public:
   void unserialize_legacy(std::istream &fin);
   void unserialize_view_legacy(std::istream &fin);
  private:
-  void generate(const overmap* north, const overmap* east, const overmap* south, const overmap* west);
+  void generate( const overmap_generation_options &options, const overmap *north,
+                 const overmap *east, const overmap *south, const overmap *west );
   bool generate_sub(int const z);
 
     int dist_from_city( const tripoint &p );
@@ -415,7 +474,7 @@ public:
   void place_river(point pa, point pb);
   void place_forest();
   // City Building
-  void place_cities();
+  void place_cities( const overmap_generation_options &options );
   void put_buildings(int x, int y, int dir, city town);
   void make_road(int cx, int cy, int cs, int dir, city town);
   bool build_lab(int x, int y, int z, int s, bool ice = false);
@@ -442,9 +501,9 @@ public:
                         const std::list<std::string>& allowed, const std::list<std::string>& disallowed );
   bool allow_special(const overmap_special& special, const tripoint& p, int &rotate);
   // Monsters, radios, etc.
-  void place_specials();
+  void place_specials( const overmap_generation_options &options );
   void place_special(const overmap_special& special, const tripoint& p, int rotation);
-  void place_mongroups();
+  void place_mongroups( const overmap_generation_options &options );
   void place_radios();
 
     void add_mon_group(const mongroup &group);
@@ -471,6 +530,8 @@ void finalize_overmap_terrain();
 
 bool is_river(const oter_id &ter);
 bool is_ot_type(const std::string &otype, const oter_id &oter);
+/** All terrain ids for which @ref is_ot_type holds, cached per type string. */
+const std::vector<oter_id> &ot_types_matching( const std::string &otype );
 
 inline tripoint rotate_tripoint( tripoint p, int rotations );
 
@@ -14,19 +14,84 @@
 #include "vehicle.h"
 #include "filesystem.h"
 #include "cata_utility.h"
+#include "rng.h"
+#include "thread_pool.h"
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <future>
+#include <map>
 #include <sstream>
 #include <stdlib.h>
 
 overmapbuffer overmap_buffer;
 
+/** A running @ref overmapbuffer::pregenerate call. */
+struct overmap_pregeneration {
+    /** Overmap coordinates of the overmaps that are being generated. */
+    std::set<point> positions;
+    std::future<std::vector<std::unique_ptr<overmap>>> result;
+};
+
+namespace
+{
+
+struct pregeneration_job {
+    point pos;
+    rng_stream stream;
+};
+
+/**
+ * Runs on a worker thread. @p borders are border copies of the already existing
+ * neighbors of the jobs, nothing in here touches the overmap buffer, the game or
+ * the world options.
+ */
+std::vector<std::unique_ptr<overmap>> generate_overmaps( std::vector<pregeneration_job> jobs,
+                                   std::map<point, std::unique_ptr<overmap>> borders,
+                                   overmap_generation_options options )
+{
+    std::map<point, const overmap *> neighbors;
+    for( const auto &elem : borders ) {
+        neighbors[elem.first] = elem.second.get();
+    }
+    std::vector<std::unique_ptr<overmap>> result;
+    // Adjacent overmaps differ in parity, so each wave can be generated in parallel
+    // and the second one still connects its rivers and roads to the first one.
+    for( int parity = 0; parity < 2; parity++ ) {
+        std::vector<pregeneration_job *> wave;
+        for( pregeneration_job &job : jobs ) {
+            if( ( ( job.pos.x + job.pos.y ) & 1 ) == parity ) {
+                wave.push_back( &job );
+            }
+        }
+        std::vector<std::unique_ptr<overmap>> generated( wave.size() );
+        parallel_for( wave.size(), [&]( size_t i ) {
+            const point &p = wave[i]->pos;
+            const auto neighbor = [&]( int dx, int dy ) -> const overmap * {
+                const auto iter = neighbors.find( point( p.x + dx, p.y + dy ) );
+                return iter == neighbors.end() ? nullptr : iter->second;
+            };
+            generated[i].reset( new overmap( p.x, p.y, wave[i]->stream, options, neighbor( 0, -1 ),
+                                             neighbor( 1, 0 ), neighbor( 0, 1 ), neighbor( -1, 0 ) ) );
+        } );
+        for( std::unique_ptr<overmap> &om : generated ) {
+            neighbors[om->pos()] = om.get();
+            result.push_back( std::move( om ) );
+        }
+    }
+    return result;
+}
+
+} // namespace
+
 overmapbuffer::overmapbuffer()
 : last_requested_overmap( nullptr )
 {
 }
 
+overmapbuffer::~overmapbuffer() = default;
+
 std::string overmapbuffer::terrain_filename(int const x, int const y)
 {
     std::ostringstream filename;
@@ -60,6 +125,13 @@ overmap &overmapbuffer::get( const int x, const int y )
         return *(last_requested_overmap = it->second.get());
     }
 
+    if( is_pregenerating_near( p ) ) {
+        // Either it's being generated right now or generating it now would not
+        // connect to the neighbors that are.
+        adopt_pregenerated( true );
+        return get( x, y );
+    }
+
     // That constructor loads an existing overmap or creates a new one.
     std::unique_ptr<overmap> new_om( new overmap( x, y ) );
     overmap &result = *new_om;
@@ -74,18 +146,15 @@ overmap &overmapbuffer::get( const int x, const int y )
 
 void overmapbuffer::fix_mongroups(overmap &new_overmap)
 {
-    for( auto it = new_overmap.zg.begin(); it != new_overmap.zg.end(); ) {
-        auto &mg = it->second;
+    new_overmap.zg.remove_if( [this, &new_overmap]( mongroup &mg ) {
         // spawn related code simply sets population to 0 when they have been
         // transformed into spawn points on a submap, the group can then be removed
         if( mg.empty() ) {
-            new_overmap.zg.erase( it++ );
-            continue;
+            return true;
         }
         // Inside the bounds of the overmap?
         if( mg.pos.x >= 0 && mg.pos.y >= 0 && mg.pos.x < OMAPX * 2 && mg.pos.y < OMAPY * 2 ) {
-            ++it;
-            continue;
+            return false;
         }
         point smabs( mg.pos.x + new_overmap.pos().x * OMAPX * 2,
                      mg.pos.y + new_overmap.pos().y * OMAPY * 2 );
@@ -93,19 +162,20 @@ void overmapbuffer::fix_mongroups(overmap &new_overmap)
         if( !has( omp.x, omp.y ) ) {
             // Don't generate new overmaps, as this can be called from the
             // overmap-generating code.
-            ++it;
-            continue;
+            return false;
         }
         overmap &om = get( omp.x, omp.y );
         mg.pos.x = smabs.x;
         mg.pos.y = smabs.y;
         om.add_mon_group( mg );
-        new_overmap.zg.erase( it++ );
-    }
+        return true;
+    } );
 }
 
 void overmapbuffer::save()
 {
+    // Pre-generated overmaps are saved as well, neighbors generated later rely on them.
+    adopt_pregenerated( true );
     for( auto &omp : overmaps ) {
         // Note: this may throw io errors from std::ofstream
         omp.second->save();
@@ -114,11 +184,107 @@ void overmapbuffer::save()
 
 void overmapbuffer::clear()
 {
+    if( pregeneration ) {
+        // The workers still use the world settings, let them finish before dropping the results.
+        pregeneration->result.wait();
+        pregeneration.reset();
+        flush_deferred_debugmsgs();
+    }
     overmaps.clear();
     known_non_existing.clear();
     last_requested_overmap = NULL;
 }
 
+void overmapbuffer::pregenerate( const point &om, int radius )
+{
+    if( pregeneration ) {
+        adopt_pregenerated( false );
+        if( pregeneration ) {
+            return;
+        }
+    }
+
+    std::unique_ptr<overmap_pregeneration> pregen( new overmap_pregeneration() );
+    std::vector<pregeneration_job> jobs;
+    for( int x = om.x - radius; x <= om.x + radius; x++ ) {
+        for( int y = om.y - radius; y <= om.y + radius; y++ ) {
+            const point p( x, y );
+            if( overmaps.count( p ) > 0 || file_exist( terrain_filename( x, y ) ) ) {
+                continue;
+            }
+            jobs.push_back( pregeneration_job{ p, overmap::generation_stream( p ) } );
+            pregen->positions.insert( p );
+        }
+    }
+    if( jobs.empty() ) {
+        return;
+    }
+
+    std::map<point, std::unique_ptr<overmap>> borders;
+    for( const pregeneration_job &job : jobs ) {
+        for( const point &d : { point( 0, -1 ), point( 1, 0 ), point( 0, 1 ), point( -1, 0 ) } ) {
+            const point n( job.pos.x + d.x, job.pos.y + d.y );
+            if( pregen->positions.count( n ) > 0 || borders.count( n ) > 0 ) {
+                continue;
+            }
+            // This is what overmap::open does for on demand generation, it may load the neighbor.
+            if( const overmap *neighbor = get_existing( n.x, n.y ) ) {
+                borders[n] = neighbor->border_copy();
+            }
+        }
+    }
+
+    pregen->result = std::async( std::launch::async, generate_overmaps, std::move( jobs ),
+                                 std::move( borders ), overmap_generation_options::from_world() );
+    pregeneration = std::move( pregen );
+}
+
+void overmapbuffer::adopt_pregenerated( bool const wait )
+{
+    if( !pregeneration ) {
+        return;
+    }
+    if( !wait &&
+        pregeneration->result.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready ) {
+        return;
+    }
+    std::vector<std::unique_ptr<overmap>> generated;
+    try {
+        generated = pregeneration->result.get();
+    } catch( const std::exception &err ) {
+        debugmsg( "overmap pre-generation failed: %s", err.what() );
+    }
+    pregeneration.reset();
+    // Messages about bad data the workers ran into
+    flush_deferred_debugmsgs();
+
+    std::vector<overmap *> adopted;
+    for( std::unique_ptr<overmap> &om : generated ) {
+        const point p = om->pos();
+        if( overmaps.count( p ) > 0 ) {
+            continue;
+        }
+        known_non_existing.erase( p );
+        adopted.push_back( om.get() );
+        overmaps[p] = std::move( om );
+    }
+    // Only now, fix_mongroups may move groups into any of them.
+    for( overmap *om : adopted ) {
+        fix_mongroups( *om );
+    }
+}
+
+bool overmapbuffer::is_pregenerating_near( const point &om ) const
+{
+    if( !pregeneration ) {
+        return false;
+    }
+    const std::set<point> &positions = pregeneration->positions;
+    return positions.count( om ) > 0 ||
+           positions.count( point( om.x, om.y - 1 ) ) > 0 || positions.count( point( om.x + 1, om.y ) ) > 0 ||
+           positions.count( point( om.x, om.y + 1 ) ) > 0 || positions.count( point( om.x - 1, om.y ) ) > 0;
+}
+
 const regional_settings& overmapbuffer::get_settings(int x, int y, int z)
 {
     (void)z;
@@ -151,6 +317,12 @@ overmap *overmapbuffer::get_existing(int x, int y)
     if( it != overmaps.end() ) {
         return last_requested_overmap = it->second.get();
     }
+    if( pregeneration && pregeneration->positions.count( p ) > 0 ) {
+        adopt_pregenerated( false );
+        auto const adopted = overmaps.find( p );
+        // Not done yet, it doesn't exist for now.
+        return adopted == overmaps.end() ? nullptr : last_requested_overmap = adopted->second.get();
+    }
     if (known_non_existing.count(p) > 0) {
         // This overmap does not exist on disk (this has already been
         // checked in a previous call of this function).
@@ -345,12 +517,11 @@ std::vector<mongroup*> overmapbuffer::groups_at(int x, int y, int z)
     }
     const tripoint dpos( x, y, z );
     overmap &om = get( omp.x, omp.y );
-    for( auto it = om.zg.lower_bound( dpos ), end = om.zg.upper_bound( dpos ); it != end; ++it ) {
-        auto &mg = it->second;
-        if( mg.empty() ) {
+    for( mongroup *mg : om.zg.groups_at( dpos ) ) {
+        if( mg->empty() ) {
             continue;
         }
-        result.push_back( &mg );
+        result.push_back( mg );
     }
     return result;
 }
@@ -439,9 +610,34 @@ void overmapbuffer::set_seen(int x, int y, int z, bool seen)
     om.seen(x, y, z) = seen;
 }
 
-oter_id& overmapbuffer::ter(int x, int y, int z) {
-    overmap &om = get_om_global(x, y);
-    return om.ter(x, y, z);
+oter_id overmapbuffer::ter(int x, int y, int z) {
+    const overmap &om = get_om_global(x, y);
+    return om.get_ter(x, y, z);
+}
+
+void overmapbuffer::ter_set( const tripoint &p, const oter_id &id )
+{
+    int x = p.x;
+    int y = p.y;
+    overmap &om = get_om_global( x, y );
+    om.ter( x, y, p.z ) = id;
+}
+
+int overmapbuffer::mondensity_sum( const tripoint &p, int radius )
+{
+    const point min_om = omt_to_om_copy( point( p.x - radius, p.y - radius ) );
+    const point max_om = omt_to_om_copy( point( p.x + radius, p.y + radius ) );
+    int sum = 0;
+    for( int omx = min_om.x; omx <= max_om.x; omx++ ) {
+        for( int omy = min_om.y; omy <= max_om.y; omy++ ) {
+            // The part of the square on this overmap, in its local coordinates.
+            const int left = omx * OMAPX;
+            const int top = omy * OMAPY;
+            sum += get( omx, omy ).mondensity_sum( p.x - radius - left, p.y - radius - top,
+                                                  p.x + radius - left, p.y + radius - top, p.z );
+        }
+    }
+    return sum;
 }
 
 bool overmapbuffer::reveal(const point &center, int radius, int z)
@@ -514,53 +710,75 @@ bool overmapbuffer::check_ot_type(const std::string& type, int x, int y, int z)
     return om.check_ot_type(type, x, y, z);
 }
 
-tripoint overmapbuffer::find_closest(const tripoint& origin, const std::string& type, int const radius, bool must_be_seen)
+/**
+ * Overmaps overlapping the square of the given radius around origin (in
+ * overmap terrain coordinates), paired with their distance to origin and
+ * sorted by it.
+ */
+static std::vector<std::pair<int, point>> overmaps_in_radius( const tripoint &origin, int radius )
 {
-    int max = (radius == 0 ? OMAPX : radius);
-    const int z = origin.z;
-    // expanding box
-    for( int dist = 0; dist <= max; dist++) {
-        // each edge length is 2*dist-2, because corners belong to one edge
-        // south is +y, north is -y
-        for (int i = 0; i < dist*2-1; i++) {
-            //start at northwest, scan north edge
-            int x = origin.x - dist + i;
-            int y = origin.y - dist;
-            if (check_ot_type(type, x, y, z)) {
-                if (!must_be_seen || seen(x, y, z)) {
-                    return tripoint( x, y, z );
-                }
-            }
+    std::vector<std::pair<int, point>> result;
+    const point om_min = omt_to_om_copy( origin.x - radius, origin.y - radius );
+    const point om_max = omt_to_om_copy( origin.x + radius, origin.y + radius );
+    for( int omx = om_min.x; omx <= om_max.x; omx++ ) {
+        for( int omy = om_min.y; omy <= om_max.y; omy++ ) {
+            const int dx = std::max( { 0, omx * OMAPX - origin.x, origin.x - ( omx + 1 ) * OMAPX + 1 } );
+            const int dy = std::max( { 0, omy * OMAPY - origin.y, origin.y - ( omy + 1 ) * OMAPY + 1 } );
+            result.push_back( std::make_pair( std::max( dx, dy ), point( omx, omy ) ) );
+        }
+    }
+    std::stable_sort( result.begin(), result.end(),
+    []( const std::pair<int, point> &a, const std::pair<int, point> &b ) {
+        return a.first < b.first;
+    } );
+    return result;
+}
 
-            //start at southeast, scan south
-            x = origin.x + dist - i;
-            y = origin.y + dist;
-            if (check_ot_type(type, x, y, z)) {
-                if (!must_be_seen || seen(x, y, z)) {
-                    return tripoint( x, y, z );
-                }
-            }
+/** First location with y >= min_y, locations are sorted by y. */
+static std::vector<point>::const_iterator first_row( const std::vector<point> &locations,
+        int min_y )
+{
+    return std::lower_bound( locations.begin(), locations.end(), min_y,
+    []( const point &p, int y ) {
+        return p.y < y;
+    } );
+}
 
-            //start at southwest, scan west
-            x = origin.x - dist;
-            y = origin.y + dist - i;
-            if (check_ot_type(type, x, y, z)) {
-                if (!must_be_seen || seen(x, y, z)) {
-                    return tripoint( x, y, z );
-                }
-            }
+tripoint overmapbuffer::find_closest(const tripoint& origin, const std::string& type, int const radius, bool must_be_seen)
+{
+    const int max = (radius == 0 ? OMAPX : radius);
+    const int z = origin.z;
+    const std::vector<oter_id> &types = ot_types_matching( type );
+    if( types.empty() || z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT ) {
+        return overmap::invalid_tripoint;
+    }
 
-            //start at northeast, scan east
-            x = origin.x + dist;
-            y = origin.y - dist + i;
-            if (check_ot_type(type, x, y, z)) {
-                if (!must_be_seen || seen(x, y, z)) {
-                    return tripoint( x, y, z );
+    tripoint result = overmap::invalid_tripoint;
+    // Anything at this distance or further away loses against the current result.
+    int best = max + 1;
+    for( const auto &candidate : overmaps_in_radius( origin, max ) ) {
+        if( candidate.first >= best ) {
+            break;
+        }
+        overmap &om = get( candidate.second.x, candidate.second.y );
+        const int left = candidate.second.x * OMAPX;
+        const int top = candidate.second.y * OMAPY;
+        const map_layer &lay = om.layer[z + OVERMAP_DEPTH];
+        for( const oter_id &ot : types ) {
+            const std::vector<point> &locations = om.terrain_locations( ot, z );
+            for( auto it = first_row( locations, origin.y - top - best + 1 );
+                 it != locations.end() && it->y + top < origin.y + best; ++it ) {
+                const int dist = std::max( std::abs( it->x + left - origin.x ),
+                                           std::abs( it->y + top - origin.y ) );
+                if( dist >= best || ( must_be_seen && !lay.visible[it->x][it->y] ) ) {
+                    continue;
                 }
+                best = dist;
+                result = tripoint( it->x + left, it->y + top, z );
             }
         }
     }
-    return overmap::invalid_tripoint;
+    return result;
 }
 
 std::vector<tripoint> overmapbuffer::find_all( const tripoint& origin, const std::string& type,
@@ -569,16 +787,31 @@ std::vector<tripoint> overmapbuffer::find_all( const tripoint& origin, const std
     std::vector<tripoint> result;
     // dist == 0 means search a whole overmap diameter.
     dist = dist ? dist : OMAPX;
-    for (int x = origin.x - dist; x <= origin.x + dist; x++) {
-        for (int y = origin.y - dist; y <= origin.y + dist; y++) {
-            if (must_be_seen && !seen(x, y, origin.z)) {
-                continue;
-            }
-            if (check_ot_type(type, x, y, origin.z)) {
-                result.push_back( tripoint( x, y, origin.z ) );
+    const int z = origin.z;
+    const std::vector<oter_id> &types = ot_types_matching( type );
+    if( types.empty() || z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT ) {
+        return result;
+    }
+
+    for( const auto &candidate : overmaps_in_radius( origin, dist ) ) {
+        overmap &om = get( candidate.second.x, candidate.second.y );
+        const int left = candidate.second.x * OMAPX;
+        const int top = candidate.second.y * OMAPY;
+        const map_layer &lay = om.layer[z + OVERMAP_DEPTH];
+        for( const oter_id &ot : types ) {
+            const std::vector<point> &locations = om.terrain_locations( ot, z );
+            for( auto it = first_row( locations, origin.y - dist - top );
+                 it != locations.end() && it->y + top <= origin.y + dist; ++it ) {
+                if( std::abs( it->x + left - origin.x ) > dist ||
+                    ( must_be_seen && !lay.visible[it->x][it->y] ) ) {
+                    continue;
+                }
+                result.push_back( tripoint( it->x + left, it->y + top, z ) );
             }
         }
     }
+    // Same order as a scan over x, then y.
+    std::sort( result.begin(), result.end() );
     return result;
 }
 
@@ -23,6 +23,7 @@ class overmap;
 struct radio_tower;
 struct regional_settings;
 class vehicle;
+struct overmap_pregeneration;
 
 struct radio_tower_reference {
     /** Overmap the radio tower is on. */
@@ -56,6 +57,7 @@ class overmapbuffer
 {
 public:
     overmapbuffer();
+    ~overmapbuffer();
 
     static std::string terrain_filename(int const x, int const y);
     static std::string player_filename(int const x, int const y);
@@ -67,13 +69,34 @@ public:
     overmap &get( const int x, const int y );
     void save();
     void clear();
+    /**
+     * Starts generating the missing overmaps within the given radius (in overmaps)
+     * around the given overmap on worker threads and returns right away. They are
+     * moved into the buffer once they are done; @ref get only blocks if it needs
+     * one of them (or a neighbor of one of them) before that.
+     * Neighbors of each other are generated one after the other, so rivers and roads
+     * connect just like with on demand generation. Does nothing while a previous
+     * call is still running.
+     */
+    void pregenerate( const point &om, int radius = 1 );
 
     /**
      * Uses global overmap terrain coordinates, creates the
      * overmap if needed.
      */
-    oter_id& ter(int x, int y, int z);
-    oter_id& ter(const tripoint& p) { return ter(p.x, p.y, p.z); }
+    oter_id ter(int x, int y, int z);
+    oter_id ter(const tripoint& p) { return ter(p.x, p.y, p.z); }
+    /**
+     * Changes the terrain at the given global overmap terrain coordinates,
+     * creates the overmap if needed.
+     */
+    void ter_set( const tripoint &p, const oter_id &id );
+    /**
+     * Sum of @ref oter_t::mondensity over the square of overmap terrain with the
+     * given radius around p (global overmap terrain coordinates), creates the
+     * overmaps if needed.
+     */
+    int mondensity_sum( const tripoint &p, int radius );
     /**
      * Uses global overmap terrain coordinates.
      */
@@ -319,6 +342,16 @@ private:
     mutable std::set<point> known_non_existing;
     // Cached result of previous call to overmapbuffer::get_existing
     overmap mutable *last_requested_overmap;
+    /** The running @ref pregenerate call, if any. */
+    std::unique_ptr<overmap_pregeneration> pregeneration;
+
+    /**
+     * Moves the overmaps of a finished @ref pregenerate call into the buffer.
+     * @param wait Wait for the call to finish instead of leaving it running.
+     */
+    void adopt_pregenerated( bool wait );
+    /** Whether generating the given overmap right now could conflict with @ref pregeneration. */
+    bool is_pregenerating_near( const point &om ) const;
 
     /**
      * Get a list of notes in the (loaded) overmaps.
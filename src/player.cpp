@@ -169,6 +169,153 @@ stats player_stats;
 
 static const itype_id OPTICAL_CLOAK_ITEM_ID( "optical_cloak" );
 
+static const trait_iid trait_ACIDBLOOD( "ACIDBLOOD" );
+static const trait_iid trait_ADDICTIVE( "ADDICTIVE" );
+static const trait_iid trait_ALBINO( "ALBINO" );
+static const trait_iid trait_AMORPHOUS( "AMORPHOUS" );
+static const trait_iid trait_ARACHNID_ARMS( "ARACHNID_ARMS" );
+static const trait_iid trait_ARACHNID_ARMS_OK( "ARACHNID_ARMS_OK" );
+static const trait_iid trait_ASTHMA( "ASTHMA" );
+static const trait_iid trait_BADHEARING( "BADHEARING" );
+static const trait_iid trait_BADKNEES( "BADKNEES" );
+static const trait_iid trait_CANINE_EARS( "CANINE_EARS" );
+static const trait_iid trait_CEPH_EYES( "CEPH_EYES" );
+static const trait_iid trait_CHAOTIC( "CHAOTIC" );
+static const trait_iid trait_CHEMIMBALANCE( "CHEMIMBALANCE" );
+static const trait_iid trait_CHITIN2( "CHITIN2" );
+static const trait_iid trait_CHITIN3( "CHITIN3" );
+static const trait_iid trait_CHITIN_FUR3( "CHITIN_FUR3" );
+static const trait_iid trait_CHLOROMORPH( "CHLOROMORPH" );
+static const trait_iid trait_COLDBLOOD( "COLDBLOOD" );
+static const trait_iid trait_COLDBLOOD2( "COLDBLOOD2" );
+static const trait_iid trait_COLDBLOOD3( "COLDBLOOD3" );
+static const trait_iid trait_COLDBLOOD4( "COLDBLOOD4" );
+static const trait_iid trait_COMPOUND_EYES( "COMPOUND_EYES" );
+static const trait_iid trait_DEBUG_LS( "DEBUG_LS" );
+static const trait_iid trait_EATHEALTH( "EATHEALTH" );
+static const trait_iid trait_FASTHEALER( "FASTHEALER" );
+static const trait_iid trait_FASTHEALER2( "FASTHEALER2" );
+static const trait_iid trait_FAT( "FAT" );
+static const trait_iid trait_FELINE_EARS( "FELINE_EARS" );
+static const trait_iid trait_FLEET( "FLEET" );
+static const trait_iid trait_FLEET2( "FLEET2" );
+static const trait_iid trait_FLIMSY( "FLIMSY" );
+static const trait_iid trait_FLIMSY2( "FLIMSY2" );
+static const trait_iid trait_FLIMSY3( "FLIMSY3" );
+static const trait_iid trait_FLOWERS( "FLOWERS" );
+static const trait_iid trait_GILLS( "GILLS" );
+static const trait_iid trait_GILLS_CEPH( "GILLS_CEPH" );
+static const trait_iid trait_GOODHEARING( "GOODHEARING" );
+static const trait_iid trait_HEAVYSLEEPER( "HEAVYSLEEPER" );
+static const trait_iid trait_HEAVYSLEEPER2( "HEAVYSLEEPER2" );
+static const trait_iid trait_HIBERNATE( "HIBERNATE" );
+static const trait_iid trait_HOLLOW_BONES( "HOLLOW_BONES" );
+static const trait_iid trait_HOOVES( "HOOVES" );
+static const trait_iid trait_HUGE( "HUGE" );
+static const trait_iid trait_HUGE_OK( "HUGE_OK" );
+static const trait_iid trait_INFIMMUNE( "INFIMMUNE" );
+static const trait_iid trait_INFRESIST( "INFRESIST" );
+static const trait_iid trait_INSECT_ARMS( "INSECT_ARMS" );
+static const trait_iid trait_INSECT_ARMS_OK( "INSECT_ARMS_OK" );
+static const trait_iid trait_JITTERY( "JITTERY" );
+static const trait_iid trait_LARGE( "LARGE" );
+static const trait_iid trait_LARGE_OK( "LARGE_OK" );
+static const trait_iid trait_LEAVES( "LEAVES" );
+static const trait_iid trait_LEG_TENTACLES( "LEG_TENTACLES" );
+static const trait_iid trait_LIGHT_BONES( "LIGHT_BONES" );
+static const trait_iid trait_LUPINE_EARS( "LUPINE_EARS" );
+static const trait_iid trait_MEMBRANE( "MEMBRANE" );
+static const trait_iid trait_MET_RAT( "MET_RAT" );
+static const trait_iid trait_MOODSWINGS( "MOODSWINGS" );
+static const trait_iid trait_MYOPIC( "MYOPIC" );
+static const trait_iid trait_M_BLOSSOMS( "M_BLOSSOMS" );
+static const trait_iid trait_M_IMMUNE( "M_IMMUNE" );
+static const trait_iid trait_M_SKIN2( "M_SKIN2" );
+static const trait_iid trait_M_SPORES( "M_SPORES" );
+static const trait_iid trait_NONADDICTIVE( "NONADDICTIVE" );
+static const trait_iid trait_NOPAIN( "NOPAIN" );
+static const trait_iid trait_PADDED_FEET( "PADDED_FEET" );
+static const trait_iid trait_PAINREC1( "PAINREC1" );
+static const trait_iid trait_PAINREC2( "PAINREC2" );
+static const trait_iid trait_PAINREC3( "PAINREC3" );
+static const trait_iid trait_PARAIMMUNE( "PARAIMMUNE" );
+static const trait_iid trait_PARKOUR( "PARKOUR" );
+static const trait_iid trait_PER_SLIME( "PER_SLIME" );
+static const trait_iid trait_PER_SLIME_OK( "PER_SLIME_OK" );
+static const trait_iid trait_PLANTSKIN( "PLANTSKIN" );
+static const trait_iid trait_PONDEROUS1( "PONDEROUS1" );
+static const trait_iid trait_PONDEROUS2( "PONDEROUS2" );
+static const trait_iid trait_PONDEROUS3( "PONDEROUS3" );
+static const trait_iid trait_QUICK( "QUICK" );
+static const trait_iid trait_RADIOACTIVE1( "RADIOACTIVE1" );
+static const trait_iid trait_RADIOACTIVE2( "RADIOACTIVE2" );
+static const trait_iid trait_RADIOACTIVE3( "RADIOACTIVE3" );
+static const trait_iid trait_RADIOGENIC( "RADIOGENIC" );
+static const trait_iid trait_REGEN( "REGEN" );
+static const trait_iid trait_REGEN_LIZ( "REGEN_LIZ" );
+static const trait_iid trait_ROOTS2( "ROOTS2" );
+static const trait_iid trait_ROOTS3( "ROOTS3" );
+static const trait_iid trait_SCHIZOPHRENIC( "SCHIZOPHRENIC" );
+static const trait_iid trait_SHOUT1( "SHOUT1" );
+static const trait_iid trait_SHOUT2( "SHOUT2" );
+static const trait_iid trait_SHOUT3( "SHOUT3" );
+static const trait_iid trait_SLEEPY( "SLEEPY" );
+static const trait_iid trait_SLEEPY2( "SLEEPY2" );
+static const trait_iid trait_SLOWHEALER( "SLOWHEALER" );
+static const trait_iid trait_SLOWRUNNER( "SLOWRUNNER" );
+static const trait_iid trait_SMELLY( "SMELLY" );
+static const trait_iid trait_SMELLY2( "SMELLY2" );
+static const trait_iid trait_SORES( "SORES" );
+static const trait_iid trait_SUNBURN( "SUNBURN" );
+static const trait_iid trait_SUNLIGHT_DEPENDENT( "SUNLIGHT_DEPENDENT" );
+static const trait_iid trait_THICK_SCALES( "THICK_SCALES" );
+static const trait_iid trait_THIRST( "THIRST" );
+static const trait_iid trait_THIRST2( "THIRST2" );
+static const trait_iid trait_THIRST3( "THIRST3" );
+static const trait_iid trait_THRESH_MYCUS( "THRESH_MYCUS" );
+static const trait_iid trait_TOUGH_FEET( "TOUGH_FEET" );
+static const trait_iid trait_TROGLO( "TROGLO" );
+static const trait_iid trait_TROGLO2( "TROGLO2" );
+static const trait_iid trait_TROGLO3( "TROGLO3" );
+static const trait_iid trait_UNSTABLE( "UNSTABLE" );
+static const trait_iid trait_URSINE_EARS( "URSINE_EARS" );
+static const trait_iid trait_URSINE_EYE( "URSINE_EYE" );
+static const trait_iid trait_VOMITOUS( "VOMITOUS" );
+static const trait_iid trait_WAKEFUL( "WAKEFUL" );
+static const trait_iid trait_WAKEFUL2( "WAKEFUL2" );
+static const trait_iid trait_WAKEFUL3( "WAKEFUL3" );
+static const trait_iid trait_WEAKSCENT( "WEAKSCENT" );
+static const trait_iid trait_WEBBED( "WEBBED" );
+static const trait_iid trait_WEB_SPINNER( "WEB_SPINNER" );
+static const trait_iid trait_WHISKERS( "WHISKERS" );
+static const trait_iid trait_WHISKERS_RAT( "WHISKERS_RAT" );
+static const trait_iid trait_WINGS_BUTTERFLY( "WINGS_BUTTERFLY" );
+static const bionic_iid bio_advreactor( "bio_advreactor" );
+static const bionic_iid bio_dis_acid( "bio_dis_acid" );
+static const bionic_iid bio_dis_shock( "bio_dis_shock" );
+static const bionic_iid bio_drain( "bio_drain" );
+static const bionic_iid bio_earplugs( "bio_earplugs" );
+static const bionic_iid bio_ears( "bio_ears" );
+static const bionic_iid bio_eye_optic( "bio_eye_optic" );
+static const bionic_iid bio_geiger( "bio_geiger" );
+static const bionic_iid bio_gills( "bio_gills" );
+static const bionic_iid bio_itchy( "bio_itchy" );
+static const bionic_iid bio_leaky( "bio_leaky" );
+static const bionic_iid bio_membrane( "bio_membrane" );
+static const bionic_iid bio_metabolics( "bio_metabolics" );
+static const bionic_iid bio_noise( "bio_noise" );
+static const bionic_iid bio_plut_filter( "bio_plut_filter" );
+static const bionic_iid bio_power_weakness( "bio_power_weakness" );
+static const bionic_iid bio_reactor( "bio_reactor" );
+static const bionic_iid bio_recycler( "bio_recycler" );
+static const bionic_iid bio_shakes( "bio_shakes" );
+static const bionic_iid bio_sleepy( "bio_sleepy" );
+static const bionic_iid bio_solar( "bio_solar" );
+static const bionic_iid bio_spasm( "bio_spasm" );
+static const bionic_iid bio_speed( "bio_speed" );
+static const bionic_iid bio_trip( "bio_trip" );
+static const bionic_iid bio_watch( "bio_watch" );
+
 static bool should_combine_bps( const player &, size_t, size_t );
 
 
@@ -382,19 +529,19 @@ void player::reset_stats()
     clear_miss_reasons();
 
     // Trait / mutation buffs
-    if( has_trait( "THICK_SCALES" ) ) {
+    if( has_trait( trait_THICK_SCALES ) ) {
         add_miss_reason( _( "Your thick scales get in the way." ), 2 );
     }
-    if( has_trait( "CHITIN2" ) || has_trait( "CHITIN3" ) || has_trait( "CHITIN_FUR3" ) ) {
+    if( has_trait( trait_CHITIN2 ) || has_trait( trait_CHITIN3 ) || has_trait( trait_CHITIN_FUR3 ) ) {
         add_miss_reason( _( "Your chitin gets in the way." ), 1 );
     }
-    if( has_trait( "COMPOUND_EYES" ) && !wearing_something_on( bp_eyes ) ) {
+    if( has_trait( trait_COMPOUND_EYES ) && !wearing_something_on( bp_eyes ) ) {
         mod_per_bonus( 1 );
     }
-    if( has_trait( "INSECT_ARMS" ) ) {
+    if( has_trait( trait_INSECT_ARMS ) ) {
         add_miss_reason( _( "Your insect limbs get in the way." ), 2 );
     }
-    if( has_trait( "INSECT_ARMS_OK" ) ) {
+    if( has_trait( trait_INSECT_ARMS_OK ) ) {
         if( !wearing_something_on( bp_torso ) ) {
             mod_dex_bonus( 1 );
         } else {
@@ -402,13 +549,13 @@ void player::reset_stats()
             add_miss_reason( _( "Your clothing restricts your insect arms." ), 1 );
         }
     }
-    if( has_trait( "WEBBED" ) ) {
+    if( has_trait( trait_WEBBED ) ) {
         add_miss_reason( _( "Your webbed hands get in the way." ), 1 );
     }
-    if( has_trait( "ARACHNID_ARMS" ) ) {
+    if( has_trait( trait_ARACHNID_ARMS ) ) {
         add_miss_reason( _( "Your arachnid limbs get in the way." ), 4 );
     }
-    if( has_trait( "ARACHNID_ARMS_OK" ) ) {
+    if( has_trait( trait_ARACHNID_ARMS_OK ) ) {
         if( !wearing_something_on( bp_torso ) ) {
             mod_dex_bonus( 2 );
         } else if( !exclusive_flag_coverage( "OVERSIZE" )[bp_torso] ) {
@@ -487,14 +634,14 @@ void player::reset_stats()
     mod_dodge_bonus( mabuff_dodge_bonus() - ( encumb( bp_leg_l ) + encumb( bp_leg_r ) ) / 20 - ( encumb(
                          bp_torso ) / 10 ) );
     // Whiskers don't work so well if they're covered
-    if( has_trait( "WHISKERS" ) && !wearing_something_on( bp_mouth ) ) {
+    if( has_trait( trait_WHISKERS ) && !wearing_something_on( bp_mouth ) ) {
         mod_dodge_bonus( 1 );
     }
-    if( has_trait( "WHISKERS_RAT" ) && !wearing_something_on( bp_mouth ) ) {
+    if( has_trait( trait_WHISKERS_RAT ) && !wearing_something_on( bp_mouth ) ) {
         mod_dodge_bonus( 2 );
     }
     // Spider hair is basically a full-body set of whiskers, once you get the brain for it
-    if( has_trait( "CHITIN_FUR3" ) ) {
+    if( has_trait( trait_CHITIN_FUR3 ) ) {
         static const std::array<body_part, 5> parts {{bp_head, bp_arm_r, bp_arm_l, bp_leg_r, bp_leg_l}};
         for( auto bp : parts ) {
             if( !wearing_something_on( bp ) ) {
@@ -521,16 +668,13 @@ void player::reset_stats()
     recalc_speed_bonus();
 
     // Effects
-    for( auto maps : effects ) {
-        for( auto i : maps.second ) {
-            const auto &it = i.second;
-            bool reduced = resists_effect( it );
-            mod_str_bonus( it.get_mod( "STR", reduced ) );
-            mod_dex_bonus( it.get_mod( "DEX", reduced ) );
-            mod_per_bonus( it.get_mod( "PER", reduced ) );
-            mod_int_bonus( it.get_mod( "INT", reduced ) );
-        }
-    }
+    effects.for_each( [this]( const effect & it ) {
+        bool reduced = resists_effect( it );
+        mod_str_bonus( it.get_mod( "STR", reduced ) );
+        mod_dex_bonus( it.get_mod( "DEX", reduced ) );
+        mod_per_bonus( it.get_mod( "PER", reduced ) );
+        mod_int_bonus( it.get_mod( "INT", reduced ) );
+    } );
 
     Character::reset_stats();
 }
@@ -542,7 +686,7 @@ void player::process_turn()
     // Didn't just pick something up
     last_item = itype_id( "null" );
 
-    if( has_active_bionic( "bio_metabolics" ) && power_level + 25 <= max_power_level &&
+    if( has_active_bionic( bio_metabolics ) && power_level + 25 <= max_power_level &&
         get_hunger() < 100 && calendar::once_every( 5 ) ) {
         mod_hunger( 2 );
         charge_power( 25 );
@@ -557,25 +701,25 @@ void player::process_turn()
 
     // Set our scent towards the norm
     int norm_scent = 500;
-    if( has_trait( "WEAKSCENT" ) ) {
+    if( has_trait( trait_WEAKSCENT ) ) {
         norm_scent = 300;
     }
-    if( has_trait( "SMELLY" ) ) {
+    if( has_trait( trait_SMELLY ) ) {
         norm_scent = 800;
     }
-    if( has_trait( "SMELLY2" ) ) {
+    if( has_trait( trait_SMELLY2 ) ) {
         norm_scent = 1200;
     }
     // Not so much that you don't have a scent
     // but that you smell like a plant, rather than
     // a human. When was the last time you saw a critter
     // attack a bluebell or an apple tree?
-    if( ( has_trait( "FLOWERS" ) ) && ( !( has_trait( "CHLOROMORPH" ) ) ) ) {
+    if( ( has_trait( trait_FLOWERS ) ) && ( !( has_trait( trait_CHLOROMORPH ) ) ) ) {
         norm_scent -= 200;
     }
     // You *are* a plant.  Unless someone hunts triffids by scent,
     // you don't smell like prey.
-    if( has_trait( "CHLOROMORPH" ) ) {
+    if( has_trait( trait_CHLOROMORPH ) ) {
         norm_scent = 0;
     }
 
@@ -1578,12 +1722,10 @@ void player::recalc_speed_bonus()
 
     mod_speed_bonus( stim > 10 ? 10 : stim / 4 );
 
-    for( auto maps : effects ) {
-        for( auto i : maps.second ) {
-            bool reduced = resists_effect( i.second );
-            mod_speed_bonus( i.second.get_mod( "SPEED", reduced ) );
-        }
-    }
+    effects.for_each( [this]( const effect & it ) {
+        bool reduced = resists_effect( it );
+        mod_speed_bonus( it.get_mod( "SPEED", reduced ) );
+    } );
 
     // add martial arts speed bonus
     mod_speed_bonus( mabuff_speed_bonus() );
@@ -1592,19 +1734,19 @@ void player::recalc_speed_bonus()
     // Ectothermic/COLDBLOOD4 is intended to buff folks in the Summer
     // Threshold-crossing has its charms ;-)
     if( g != NULL ) {
-        if( has_trait( "SUNLIGHT_DEPENDENT" ) && !g->is_in_sunlight( pos() ) ) {
+        if( has_trait( trait_SUNLIGHT_DEPENDENT ) && !g->is_in_sunlight( pos() ) ) {
             mod_speed_bonus( -( g->light_level( posz() ) >= 12 ? 5 : 10 ) );
         }
-        if( has_trait( "COLDBLOOD4" ) || ( has_trait( "COLDBLOOD3" ) && g->get_temperature() < 65 ) ) {
+        if( has_trait( trait_COLDBLOOD4 ) || ( has_trait( trait_COLDBLOOD3 ) && g->get_temperature() < 65 ) ) {
             mod_speed_bonus( ( g->get_temperature() - 65 ) / 2 );
-        } else if( has_trait( "COLDBLOOD2" ) && g->get_temperature() < 65 ) {
+        } else if( has_trait( trait_COLDBLOOD2 ) && g->get_temperature() < 65 ) {
             mod_speed_bonus( ( g->get_temperature() - 65 ) / 3 );
-        } else if( has_trait( "COLDBLOOD" ) && g->get_temperature() < 65 ) {
+        } else if( has_trait( trait_COLDBLOOD ) && g->get_temperature() < 65 ) {
             mod_speed_bonus( ( g->get_temperature() - 65 ) / 5 );
         }
     }
 
-    if( has_trait( "M_SKIN2" ) ) {
+    if( has_trait( trait_M_SKIN2 ) ) {
         mod_speed_bonus( -20 ); // Could be worse--you've got the armor from a (sessile!) Spire
     }
 
@@ -1615,10 +1757,10 @@ void player::recalc_speed_bonus()
         mod_speed_bonus( -20 );
     }
 
-    if( has_trait( "QUICK" ) ) { // multiply by 1.1
+    if( has_trait( trait_QUICK ) ) { // multiply by 1.1
         set_speed_bonus( int( get_speed() * 1.1 ) - get_speed_base() );
     }
-    if( has_bionic( "bio_speed" ) ) { // multiply by 1.1
+    if( has_bionic( bio_speed ) ) { // multiply by 1.1
         set_speed_bonus( int( get_speed() * 1.1 ) - get_speed_base() );
     }
 
@@ -1640,13 +1782,13 @@ int player::run_cost( int base_cost, bool diag ) const
     // The "FLAT" tag includes soft surfaces, so not a good fit.
     const bool on_road = flatground && g->m.has_flag( "ROAD", pos() );
 
-    if( has_trait( "PARKOUR" ) && movecost > 100 ) {
+    if( has_trait( trait_PARKOUR ) && movecost > 100 ) {
         movecost *= .5f;
         if( movecost < 100 ) {
             movecost = 100;
         }
     }
-    if( has_trait( "BADKNEES" ) && movecost > 100 ) {
+    if( has_trait( trait_BADKNEES ) && movecost > 100 ) {
         movecost *= 1.25f;
         if( movecost < 100 ) {
             movecost = 100;
@@ -1665,46 +1807,46 @@ int player::run_cost( int base_cost, bool diag ) const
         movecost += 25;
     }
 
-    if( has_trait( "FLEET" ) && flatground ) {
+    if( has_trait( trait_FLEET ) && flatground ) {
         movecost *= .85f;
     }
-    if( has_trait( "FLEET2" ) && flatground ) {
+    if( has_trait( trait_FLEET2 ) && flatground ) {
         movecost *= .7f;
     }
-    if( has_trait( "SLOWRUNNER" ) && flatground ) {
+    if( has_trait( trait_SLOWRUNNER ) && flatground ) {
         movecost *= 1.15f;
     }
-    if( has_trait( "PADDED_FEET" ) && !footwear_factor() ) {
+    if( has_trait( trait_PADDED_FEET ) && !footwear_factor() ) {
         movecost *= .9f;
     }
-    if( has_trait( "LIGHT_BONES" ) ) {
+    if( has_trait( trait_LIGHT_BONES ) ) {
         movecost *= .9f;
     }
-    if( has_trait( "HOLLOW_BONES" ) ) {
+    if( has_trait( trait_HOLLOW_BONES ) ) {
         movecost *= .8f;
     }
     if( has_active_mutation( "WINGS_INSECT" ) ) {
         movecost *= .75f;
     }
-    if( has_trait( "WINGS_BUTTERFLY" ) ) {
+    if( has_trait( trait_WINGS_BUTTERFLY ) ) {
         movecost -= 10; // You can't fly, but you can make life easier on your legs
     }
-    if( has_trait( "LEG_TENTACLES" ) ) {
+    if( has_trait( trait_LEG_TENTACLES ) ) {
         movecost += 20;
     }
-    if( has_trait( "FAT" ) ) {
+    if( has_trait( trait_FAT ) ) {
         movecost *= 1.05f;
     }
-    if( has_trait( "PONDEROUS1" ) ) {
+    if( has_trait( trait_PONDEROUS1 ) ) {
         movecost *= 1.1f;
     }
-    if( has_trait( "PONDEROUS2" ) ) {
+    if( has_trait( trait_PONDEROUS2 ) ) {
         movecost *= 1.2f;
     }
-    if( has_trait( "AMORPHOUS" ) ) {
+    if( has_trait( trait_AMORPHOUS ) ) {
         movecost *= 1.25f;
     }
-    if( has_trait( "PONDEROUS3" ) ) {
+    if( has_trait( trait_PONDEROUS3 ) ) {
         movecost *= 1.3f;
     }
     if( is_wearing( "stillsuit" ) ) {
@@ -1737,8 +1879,8 @@ int player::run_cost( int base_cost, bool diag ) const
     // ROOTS3 does slow you down as your roots are probing around for nutrients,
     // whether you want them to or not.  ROOTS1 is just too squiggly without shoes
     // to give you some stability.  Plants are a bit of a slow-mover.  Deal.
-    const bool mutfeet = has_trait( "LEG_TENTACLES" ) || has_trait( "PADDED_FEET" ) ||
-                         has_trait( "HOOVES" ) || has_trait( "TOUGH_FEET" ) || has_trait( "ROOTS2" );
+    const bool mutfeet = has_trait( trait_LEG_TENTACLES ) || has_trait( trait_PADDED_FEET ) ||
+                         has_trait( trait_HOOVES ) || has_trait( trait_TOUGH_FEET ) || has_trait( trait_ROOTS2 );
     if( !is_wearing_shoes( "left" ) && !mutfeet ) {
         movecost += 8;
     }
@@ -1746,7 +1888,7 @@ int player::run_cost( int base_cost, bool diag ) const
         movecost += 8;
     }
 
-    if( !footwear_factor() && has_trait( "ROOTS3" ) &&
+    if( !footwear_factor() && has_trait( trait_ROOTS3 ) &&
         g->m.has_flag( "DIGGABLE", pos() ) ) {
         movecost += 10 * footwear_factor();
     }
@@ -2410,15 +2552,13 @@ void player::disp_info()
     std::vector<std::string> effect_name;
     std::vector<std::string> effect_text;
     std::string tmp = "";
-    for( auto &elem : effects ) {
-        for( auto &_effect_it : elem.second ) {
-            tmp = _effect_it.second.disp_name();
-            if( tmp != "" ) {
-                effect_name.push_back( tmp );
-                effect_text.push_back( _effect_it.second.disp_desc() );
-            }
+    effects.for_each( [&effect_name, &effect_text, &tmp]( const effect & e ) {
+        tmp = e.disp_name();
+        if( tmp != "" ) {
+            effect_name.push_back( tmp );
+            effect_text.push_back( e.disp_desc() );
         }
-    }
+    } );
     if( abs( get_morale_level() ) >= 100 ) {
         bool pos = ( get_morale_level() > 0 );
         effect_name.push_back( pos ? _( "Elated" ) : _( "Depressed" ) );
@@ -2887,17 +3027,14 @@ Strength - 4;    Dexterity - 4;    Intelligence - 4;    Perception - 4" ) );
 
     std::map<std::string, int> speed_effects;
     std::string dis_text = "";
-    for( auto &elem : effects ) {
-        for( auto &_effect_it : elem.second ) {
-            auto &it = _effect_it.second;
-            bool reduced = resists_effect( it );
-            int move_adjust = it.get_mod( "SPEED", reduced );
-            if( move_adjust != 0 ) {
-                dis_text = it.get_speed_name();
-                speed_effects[dis_text] += move_adjust;
-            }
+    effects.for_each( [this, &dis_text, &speed_effects]( const effect & it ) {
+        bool reduced = resists_effect( it );
+        int move_adjust = it.get_mod( "SPEED", reduced );
+        if( move_adjust != 0 ) {
+            dis_text = it.get_speed_name();
+            speed_effects[dis_text] += move_adjust;
         }
-    }
+    } );
 
     for( auto &speed_effect : speed_effects ) {
         nc_color col = ( speed_effect.second > 0 ? c_green : c_red );
@@ -4109,17 +4246,17 @@ int player::clairvoyance() const
 bool player::sight_impaired() const
 {
     return ( ( ( has_effect( effect_boomered ) || has_effect( effect_darkness ) ) &&
-               ( !( has_trait( "PER_SLIME_OK" ) ) ) ) ||
-             ( underwater && !has_bionic( "bio_membrane" ) && !has_trait( "MEMBRANE" ) &&
-               !worn_with_flag( "SWIM_GOGGLES" ) && !has_trait( "PER_SLIME_OK" ) &&
-               !has_trait( "CEPH_EYES" ) ) ||
-             ( ( has_trait( "MYOPIC" ) || has_trait( "URSINE_EYE" ) ) &&
+               ( !( has_trait( trait_PER_SLIME_OK ) ) ) ) ||
+             ( underwater && !has_bionic( bio_membrane ) && !has_trait( trait_MEMBRANE ) &&
+               !worn_with_flag( "SWIM_GOGGLES" ) && !has_trait( trait_PER_SLIME_OK ) &&
+               !has_trait( trait_CEPH_EYES ) ) ||
+             ( ( has_trait( trait_MYOPIC ) || has_trait( trait_URSINE_EYE ) ) &&
                !is_wearing( "glasses_eye" ) &&
                !is_wearing( "glasses_monocle" ) &&
                !is_wearing( "glasses_bifocal" ) &&
                !has_effect( effect_contacts ) &&
-               !has_bionic( "bio_eye_optic") ) ||
-                has_trait( "PER_SLIME" ) );
+               !has_bionic( bio_eye_optic ) ) ||
+                has_trait( trait_PER_SLIME ) );
 }
 
 bool player::has_two_arms() const
@@ -4248,9 +4385,8 @@ void player::pause()
         return;
     }
 
-    VehicleList vehs = g->m.get_vehicles();
     vehicle *veh = NULL;
-    for( auto &v : vehs ) {
+    for( auto &v : g->m.get_vehicles() ) {
         veh = v.v;
         if( veh && veh->velocity != 0 && veh->player_in_control( *this ) ) {
             if( one_in( 8 ) ) {
@@ -5424,7 +5560,7 @@ void player::get_sick()
     float health_factor = std::pow(2.0f, get_healthy() / 50.0f);
 
     int disease_rarity = (int) (checks_per_year * health_factor / base_diseases_per_year);
-    add_msg( m_debug, "disease_rarity = %d", disease_rarity);
+    add_msg_debug( "disease_rarity = %d", disease_rarity);
     if (one_in(disease_rarity)) {
         if (one_in(6)) {
             // The flu typically lasts 3-10 days.
@@ -5561,11 +5697,11 @@ void player::update_needs( int rate_multiplier )
     // Hunger, thirst, & fatigue up every 5 minutes
     effect &sleep = get_effect( effect_sleep );
     // No food/thirst/fatigue clock at all
-    const bool debug_ls = has_trait( "DEBUG_LS" );
+    const bool debug_ls = has_trait( trait_DEBUG_LS );
     // No food/thirst, capped fatigue clock (only up to tired)
     const bool npc_no_food = is_npc() && get_world_option<bool>( "NO_NPC_FOOD" );
     const bool foodless = debug_ls || npc_no_food;
-    const bool has_recycler = has_bionic("bio_recycler");
+    const bool has_recycler = has_bionic( bio_recycler );
     const bool asleep = !sleep.is_null();
     const bool lying = asleep || has_effect( effect_lying_down );
     const bool hibernating = asleep && is_hibernating();
@@ -5573,18 +5709,18 @@ void player::update_needs( int rate_multiplier )
     add_msg_if_player( m_debug, "Metabolic rate: %.2f", hunger_rate );
 
     float thirst_rate = 1.0f;
-    if( has_trait("PLANTSKIN") ) {
+    if( has_trait( trait_PLANTSKIN ) ) {
         thirst_rate -= 0.2f;
     }
     if( is_wearing("stillsuit") ) {
         thirst_rate -= 0.3f;
     }
 
-    if( has_trait("THIRST") ) {
+    if( has_trait( trait_THIRST ) ) {
         thirst_rate += 0.5f;
-    } else if( has_trait("THIRST2") ) {
+    } else if( has_trait( trait_THIRST2 ) ) {
         thirst_rate += 1.0f;
-    } else if( has_trait("THIRST3") ) {
+    } else if( has_trait( trait_THIRST3 ) ) {
         thirst_rate += 2.0f;
     }
 
@@ -5623,27 +5759,27 @@ void player::update_needs( int rate_multiplier )
     if( get_fatigue() < 1050 && !asleep && !debug_ls ) {
         float fatigue_rate = 1.0f;
         // Wakeful folks don't always gain fatigue!
-        if( has_trait("WAKEFUL") ) {
+        if( has_trait( trait_WAKEFUL ) ) {
             fatigue_rate -= (1.0f / 6.0f);
-        } else if( has_trait("WAKEFUL2") ) {
+        } else if( has_trait( trait_WAKEFUL2 ) ) {
             fatigue_rate -= 0.25f;
-        } else if( has_trait("WAKEFUL3") ) {
+        } else if( has_trait( trait_WAKEFUL3 ) ) {
             // You're looking at over 24 hours to hit Tired here
             fatigue_rate -= 0.5f;
         }
         // Sleepy folks gain fatigue faster; Very Sleepy is twice as fast as typical
-        if( has_trait("SLEEPY") ) {
+        if( has_trait( trait_SLEEPY ) ) {
             fatigue_rate += (1.0f / 3.0f);
-        } else if( has_trait("SLEEPY2") ) {
+        } else if( has_trait( trait_SLEEPY2 ) ) {
             fatigue_rate += 1.0f;
         }
 
-        if( has_trait("MET_RAT") ) {
+        if( has_trait( trait_MET_RAT ) ) {
             fatigue_rate += 0.5f;
         }
 
         // Freakishly Huge folks tire quicker
-        if( has_trait("HUGE") ) {
+        if( has_trait( trait_HUGE ) ) {
             fatigue_rate += (1.0f / 6.0f);
         }
 
@@ -5663,14 +5799,14 @@ void player::update_needs( int rate_multiplier )
 
         // You fatigue & recover faster with Sleepy
         // Very Sleepy, you just fatigue faster
-        if( !hibernating && ( has_trait("SLEEPY") || has_trait("MET_RAT") ) ) {
+        if( !hibernating && ( has_trait( trait_SLEEPY ) || has_trait( trait_MET_RAT ) ) ) {
             recovery_rate += (1.0f + accelerated_recovery_rate) / 2.0f;
         }
 
         // Tireless folks recover fatigue really fast
         // as well as gaining it really slowly
         // (Doesn't speed healing any, though...)
-        if( !hibernating && has_trait("WAKEFUL3") ) {
+        if( !hibernating && has_trait( trait_WAKEFUL3 ) ) {
             recovery_rate += (1.0f + accelerated_recovery_rate) / 2.0f;
         }
 
@@ -5707,12 +5843,12 @@ void player::update_needs( int rate_multiplier )
         mod_painkiller( -std::min( get_painkiller(), rate_multiplier ) );
     }
 
-    if( has_bionic("bio_solar") && g->is_in_sunlight( pos() ) ) {
+    if( has_bionic( bio_solar ) && g->is_in_sunlight( pos() ) ) {
         charge_power( rate_multiplier * 25 );
     }
 
     // Huge folks take penalties for cramming themselves in vehicles
-    if( in_vehicle && (has_trait("HUGE") || has_trait("HUGE_OK")) ) {
+    if( in_vehicle && (has_trait( trait_HUGE ) || has_trait( trait_HUGE_OK )) ) {
         // TODO: Make NPCs complain
         add_msg_if_player(m_bad, _("You're cramping up from stuffing yourself in this vehicle."));
         mod_pain_noresist( 2 * rng(2, 3) );
@@ -5821,13 +5957,13 @@ bool player::is_hibernating() const
 void player::sleep_hp_regen( int rate_multiplier )
 {
     float heal_chance = get_healthy() / 400.0f;
-    if( has_trait("FASTHEALER") || has_trait("MET_RAT") ) {
+    if( has_trait( trait_FASTHEALER ) || has_trait( trait_MET_RAT ) ) {
         heal_chance += 1.0f;
-    } else if (has_trait("FASTHEALER2")) {
+    } else if (has_trait( trait_FASTHEALER2 )) {
         heal_chance += 1.5f;
-    } else if (has_trait("REGEN")) {
+    } else if (has_trait( trait_REGEN )) {
         heal_chance += 2.0f;
-    } else if (has_trait("SLOWHEALER")) {
+    } else if (has_trait( trait_SLOWHEALER )) {
         heal_chance += 0.13f;
     } else {
         heal_chance += 0.25f;
@@ -5837,11 +5973,11 @@ void player::sleep_hp_regen( int rate_multiplier )
         heal_chance /= 7.0f;
     }
 
-    if( has_trait("FLIMSY") ) {
+    if( has_trait( trait_FLIMSY ) ) {
         heal_chance /= (4.0f / 3.0f);
-    } else if( has_trait("FLIMSY2") ) {
+    } else if( has_trait( trait_FLIMSY2 ) ) {
         heal_chance /= 2.0f;
-    } else if( has_trait("FLIMSY3") ) {
+    } else if( has_trait( trait_FLIMSY3 ) ) {
         heal_chance /= 4.0f;
     }
 
@@ -5881,7 +6017,7 @@ void player::add_addiction(add_type type, int strength)
             i.intensity++;
         }
 
-        add_msg( m_debug, "Updating addiction: %d intensity, %d sated",
+        add_msg_debug( "Updating addiction: %d intensity, %d sated",
                  i.intensity, i.sated );
 
         return;
@@ -5889,14 +6025,14 @@ void player::add_addiction(add_type type, int strength)
 
     // Add a new addiction
     const int roll = rng( 0, 100 );
-    add_msg( m_debug, "Addiction: roll %d vs strength %d", roll, strength );
+    add_msg_debug( "Addiction: roll %d vs strength %d", roll, strength );
     if( roll < strength ) {
         //~ %s is addiction name
         const std::string &type_name = addiction_type_name( type );
         add_memorial_log( pgettext("memorial_male", "Became addicted to %s."),
                           pgettext("memorial_female", "Became addicted to %s."),
                           type_name.c_str() );
-        add_msg( m_debug, "%s got addicted to %s", disp_name().c_str(), type_name.c_str() );
+        add_msg_debug( "%s got addicted to %s", disp_name().c_str(), type_name.c_str() );
         addictions.emplace_back( type, 1 );
     }
 }
@@ -6127,12 +6263,12 @@ void player::process_effects() {
     if (has_effect( effect_darkness ) && g->is_in_sunlight(pos())) {
         remove_effect( effect_darkness );
     }
-    if (has_trait("M_IMMUNE") && has_effect( effect_fungus )) {
+    if (has_trait( trait_M_IMMUNE ) && has_effect( effect_fungus )) {
         vomit();
         remove_effect( effect_fungus );
         add_msg_if_player(m_bad,  _("We have mistakenly colonized a local guide!  Purging now."));
     }
-    if (has_trait("PARAIMMUNE") && (has_effect( effect_dermatik ) || has_effect( effect_tapeworm ) ||
+    if (has_trait( trait_PARAIMMUNE ) && (has_effect( effect_dermatik ) || has_effect( effect_tapeworm ) ||
           has_effect( effect_bloodworms ) || has_effect( effect_brainworms ) || has_effect( effect_paincysts )) ) {
         remove_effect( effect_dermatik );
         remove_effect( effect_tapeworm );
@@ -6141,17 +6277,17 @@ void player::process_effects() {
         remove_effect( effect_paincysts );
         add_msg_if_player(m_good, _("Something writhes and inside of you as it dies."));
     }
-    if (has_trait("ACIDBLOOD") && (has_effect( effect_dermatik ) || has_effect( effect_bloodworms ) ||
+    if (has_trait( trait_ACIDBLOOD ) && (has_effect( effect_dermatik ) || has_effect( effect_bloodworms ) ||
           has_effect( effect_brainworms ))) {
         remove_effect( effect_dermatik );
         remove_effect( effect_bloodworms );
         remove_effect( effect_brainworms );
     }
-    if (has_trait("EATHEALTH") && has_effect( effect_tapeworm ) ) {
+    if (has_trait( trait_EATHEALTH ) && has_effect( effect_tapeworm ) ) {
         remove_effect( effect_tapeworm );
         add_msg_if_player(m_good, _("Your bowels gurgle as something inside them dies."));
     }
-    if (has_trait("INFIMMUNE") && (has_effect( effect_bite ) || has_effect( effect_infected ) ||
+    if (has_trait( trait_INFIMMUNE ) && (has_effect( effect_bite ) || has_effect( effect_infected ) ||
           has_effect( effect_recover ) ) ) {
         remove_effect( effect_bite );
         remove_effect( effect_infected );
@@ -6162,214 +6298,211 @@ void player::process_effects() {
     }
 
     //Human only effects
-    for( auto &elem : effects ) {
-        for( auto &_effect_it : elem.second ) {
-            auto &it = _effect_it.second;
-            bool reduced = resists_effect(it);
-            double mod = 1;
-            body_part bp = it.get_bp();
-            int val = 0;
-
-            // Still hardcoded stuff, do this first since some modify their other traits
-            hardcoded_effects(it);
-
-            // Handle miss messages
-            auto msgs = it.get_miss_msgs();
-            if (!msgs.empty()) {
-                for (auto i : msgs) {
-                    add_miss_reason(_(i.first.c_str()), unsigned(i.second));
-                }
+    effects.for_each( [this]( effect & it ) {
+        bool reduced = resists_effect(it);
+        double mod = 1;
+        body_part bp = it.get_bp();
+        int val = 0;
+
+        // Still hardcoded stuff, do this first since some modify their other traits
+        hardcoded_effects(it);
+
+        // Handle miss messages
+        auto msgs = it.get_miss_msgs();
+        if (!msgs.empty()) {
+            for (auto i : msgs) {
+                add_miss_reason(_(i.first.c_str()), unsigned(i.second));
             }
+        }
 
-            // Handle health mod
-            val = it.get_mod("H_MOD", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "H_MOD", val, reduced, mod)) {
-                    int bounded = bound_mod_to_vals(
-                            get_healthy_mod(), val, it.get_max_val("H_MOD", reduced),
-                            it.get_min_val("H_MOD", reduced));
-                    // This already applies bounds, so we pass them through.
-                    mod_healthy_mod(bounded, get_healthy_mod() + bounded);
-                }
+        // Handle health mod
+        val = it.get_mod("H_MOD", reduced);
+        if (val != 0) {
+            mod = 1;
+            if(it.activated(calendar::turn, "H_MOD", val, reduced, mod)) {
+                int bounded = bound_mod_to_vals(
+                        get_healthy_mod(), val, it.get_max_val("H_MOD", reduced),
+                        it.get_min_val("H_MOD", reduced));
+                // This already applies bounds, so we pass them through.
+                mod_healthy_mod(bounded, get_healthy_mod() + bounded);
             }
+        }
 
-            // Handle health
-            val = it.get_mod("HEALTH", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "HEALTH", val, reduced, mod)) {
-                    mod_healthy(bound_mod_to_vals(get_healthy(), val,
-                                it.get_max_val("HEALTH", reduced), it.get_min_val("HEALTH", reduced)));
-                }
+        // Handle health
+        val = it.get_mod("HEALTH", reduced);
+        if (val != 0) {
+            mod = 1;
+            if(it.activated(calendar::turn, "HEALTH", val, reduced, mod)) {
+                mod_healthy(bound_mod_to_vals(get_healthy(), val,
+                            it.get_max_val("HEALTH", reduced), it.get_min_val("HEALTH", reduced)));
             }
+        }
 
-            // Handle stim
-            val = it.get_mod("STIM", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "STIM", val, reduced, mod)) {
-                    stim += bound_mod_to_vals(stim, val, it.get_max_val("STIM", reduced),
-                                                it.get_min_val("STIM", reduced));
-                }
+        // Handle stim
+        val = it.get_mod("STIM", reduced);
+        if (val != 0) {
+            mod = 1;
+            if(it.activated(calendar::turn, "STIM", val, reduced, mod)) {
+                stim += bound_mod_to_vals(stim, val, it.get_max_val("STIM", reduced),
+                                            it.get_min_val("STIM", reduced));
             }
+        }
 
-            // Handle hunger
-            val = it.get_mod("HUNGER", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "HUNGER", val, reduced, mod)) {
-                    mod_hunger(bound_mod_to_vals(get_hunger(), val, it.get_max_val("HUNGER", reduced),
-                                                it.get_min_val("HUNGER", reduced)));
-                }
+        // Handle hunger
+        val = it.get_mod("HUNGER", reduced);
+        if (val != 0) {
+            mod = 1;
+            if(it.activated(calendar::turn, "HUNGER", val, reduced, mod)) {
+                mod_hunger(bound_mod_to_vals(get_hunger(), val, it.get_max_val("HUNGER", reduced),
+                                            it.get_min_val("HUNGER", reduced)));
             }
+        }
 
-            // Handle thirst
-            val = it.get_mod("THIRST", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "THIRST", val, reduced, mod)) {
-                    mod_thirst(bound_mod_to_vals(get_thirst(), val, it.get_max_val("THIRST", reduced),
-                                                it.get_min_val("THIRST", reduced)));
-                }
+        // Handle thirst
+        val = it.get_mod("THIRST", reduced);
+        if (val != 0) {
+            mod = 1;
+            if(it.activated(calendar::turn, "THIRST", val, reduced, mod)) {
+                mod_thirst(bound_mod_to_vals(get_thirst(), val, it.get_max_val("THIRST", reduced),
+                                            it.get_min_val("THIRST", reduced)));
             }
+        }
 
-            // Handle fatigue
-            val = it.get_mod("FATIGUE", reduced);
-            // Prevent ongoing fatigue effects while asleep.
-            // These are meant to change how fast you get tired, not how long you sleep.
-            if (val != 0 && !in_sleep_state()) {
-                mod = 1;
-                if(it.activated(calendar::turn, "FATIGUE", val, reduced, mod)) {
-                    mod_fatigue(bound_mod_to_vals(get_fatigue(), val, it.get_max_val("FATIGUE", reduced),
-                                                it.get_min_val("FATIGUE", reduced)));
-                }
+        // Handle fatigue
+        val = it.get_mod("FATIGUE", reduced);
+        // Prevent ongoing fatigue effects while asleep.
+        // These are meant to change how fast you get tired, not how long you sleep.
+        if (val != 0 && !in_sleep_state()) {
+            mod = 1;
+            if(it.activated(calendar::turn, "FATIGUE", val, reduced, mod)) {
+                mod_fatigue(bound_mod_to_vals(get_fatigue(), val, it.get_max_val("FATIGUE", reduced),
+                                            it.get_min_val("FATIGUE", reduced)));
             }
+        }
 
-            // Handle Radiation
-            val = it.get_mod("RAD", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "RAD", val, reduced, mod)) {
-                    radiation += bound_mod_to_vals(radiation, val, it.get_max_val("RAD", reduced), 0);
-                    // Radiation can't go negative
-                    if (radiation < 0) {
-                        radiation = 0;
-                    }
+        // Handle Radiation
+        val = it.get_mod("RAD", reduced);
+        if (val != 0) {
+            mod = 1;
+            if(it.activated(calendar::turn, "RAD", val, reduced, mod)) {
+                radiation += bound_mod_to_vals(radiation, val, it.get_max_val("RAD", reduced), 0);
+                // Radiation can't go negative
+                if (radiation < 0) {
+                    radiation = 0;
                 }
             }
+        }
 
-            // Handle Pain
-            val = it.get_mod("PAIN", reduced);
-            if (val != 0) {
-                mod = 1;
-                if (it.get_sizing("PAIN")) {
-                    if (has_trait("FAT")) {
-                        mod *= 1.5;
-                    }
-                    if (has_trait("LARGE") || has_trait("LARGE_OK")) {
-                        mod *= 2;
-                    }
-                    if (has_trait("HUGE") || has_trait("HUGE_OK")) {
-                        mod *= 3;
-                    }
+        // Handle Pain
+        val = it.get_mod("PAIN", reduced);
+        if (val != 0) {
+            mod = 1;
+            if (it.get_sizing("PAIN")) {
+                if (has_trait( trait_FAT )) {
+                    mod *= 1.5;
                 }
-                if(it.activated(calendar::turn, "PAIN", val, reduced, mod)) {
-                    int pain_inc = bound_mod_to_vals(get_pain(), val, it.get_max_val("PAIN", reduced), 0);
-                    mod_pain(pain_inc);
-                    if (pain_inc > 0) {
-                        add_pain_msg(val, bp);
-                    }
+                if (has_trait( trait_LARGE ) || has_trait( trait_LARGE_OK )) {
+                    mod *= 2;
                 }
-            }
-
-            // Handle Damage
-            val = it.get_mod("HURT", reduced);
-            if (val != 0) {
-                mod = 1;
-                if (it.get_sizing("HURT")) {
-                    if (has_trait("FAT")) {
-                        mod *= 1.5;
-                    }
-                    if (has_trait("LARGE") || has_trait("LARGE_OK")) {
-                        mod *= 2;
-                    }
-                    if (has_trait("HUGE") || has_trait("HUGE_OK")) {
-                        mod *= 3;
-                    }
+                if (has_trait( trait_HUGE ) || has_trait( trait_HUGE_OK )) {
+                    mod *= 3;
                 }
-                if(it.activated(calendar::turn, "HURT", val, reduced, mod)) {
-                    if (bp == num_bp) {
-                        if (val > 5) {
-                            add_msg_if_player(_("Your %s HURTS!"), body_part_name_accusative(bp_torso).c_str());
-                        } else {
-                            add_msg_if_player(_("Your %s hurts!"), body_part_name_accusative(bp_torso).c_str());
-                        }
-                        apply_damage(nullptr, bp_torso, val);
-                    } else {
-                        if (val > 5) {
-                            add_msg_if_player(_("Your %s HURTS!"), body_part_name_accusative(bp).c_str());
-                        } else {
-                            add_msg_if_player(_("Your %s hurts!"), body_part_name_accusative(bp).c_str());
-                        }
-                        apply_damage(nullptr, bp, val);
-                    }
+            }
+            if(it.activated(calendar::turn, "PAIN", val, reduced, mod)) {
+                int pain_inc = bound_mod_to_vals(get_pain(), val, it.get_max_val("PAIN", reduced), 0);
+                mod_pain(pain_inc);
+                if (pain_inc > 0) {
+                    add_pain_msg(val, bp);
                 }
             }
+        }
 
-            // Handle Sleep
-            val = it.get_mod("SLEEP", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "SLEEP", val, reduced, mod)) {
-                    add_msg_if_player(_("You pass out!"));
-                    fall_asleep(val);
+        // Handle Damage
+        val = it.get_mod("HURT", reduced);
+        if (val != 0) {
+            mod = 1;
+            if (it.get_sizing("HURT")) {
+                if (has_trait( trait_FAT )) {
+                    mod *= 1.5;
+                }
+                if (has_trait( trait_LARGE ) || has_trait( trait_LARGE_OK )) {
+                    mod *= 2;
+                }
+                if (has_trait( trait_HUGE ) || has_trait( trait_HUGE_OK )) {
+                    mod *= 3;
                 }
             }
-
-            // Handle painkillers
-            val = it.get_mod("PKILL", reduced);
-            if (val != 0) {
-                mod = it.get_addict_mod("PKILL", addiction_level(ADD_PKILLER));
-                if(it.activated(calendar::turn, "PKILL", val, reduced, mod)) {
-                    mod_painkiller(bound_mod_to_vals(pkill, val, it.get_max_val("PKILL", reduced), 0));
+            if(it.activated(calendar::turn, "HURT", val, reduced, mod)) {
+                if (bp == num_bp) {
+                    if (val > 5) {
+                        add_msg_if_player(_("Your %s HURTS!"), body_part_name_accusative(bp_torso).c_str());
+                    } else {
+                        add_msg_if_player(_("Your %s hurts!"), body_part_name_accusative(bp_torso).c_str());
+                    }
+                    apply_damage(nullptr, bp_torso, val);
+                } else {
+                    if (val > 5) {
+                        add_msg_if_player(_("Your %s HURTS!"), body_part_name_accusative(bp).c_str());
+                    } else {
+                        add_msg_if_player(_("Your %s hurts!"), body_part_name_accusative(bp).c_str());
+                    }
+                    apply_damage(nullptr, bp, val);
                 }
             }
+        }
 
-            // Handle coughing
+        // Handle Sleep
+        val = it.get_mod("SLEEP", reduced);
+        if (val != 0) {
             mod = 1;
-            val = 0;
-            if (it.activated(calendar::turn, "COUGH", val, reduced, mod)) {
-                cough(it.get_harmful_cough());
+            if(it.activated(calendar::turn, "SLEEP", val, reduced, mod)) {
+                add_msg_if_player(_("You pass out!"));
+                fall_asleep(val);
             }
+        }
 
-            // Handle vomiting
-            mod = vomit_mod();
-            val = 0;
-            if (it.activated(calendar::turn, "VOMIT", val, reduced, mod)) {
-                vomit();
+        // Handle painkillers
+        val = it.get_mod("PKILL", reduced);
+        if (val != 0) {
+            mod = it.get_addict_mod("PKILL", addiction_level(ADD_PKILLER));
+            if(it.activated(calendar::turn, "PKILL", val, reduced, mod)) {
+                mod_painkiller(bound_mod_to_vals(pkill, val, it.get_max_val("PKILL", reduced), 0));
             }
+        }
 
-            // Handle stamina
-            val = it.get_mod("STAMINA", reduced);
-            if (val != 0) {
-                mod = 1;
-                if(it.activated(calendar::turn, "STAMINA", val, reduced, mod)) {
-                    stamina += bound_mod_to_vals( stamina, val,
-                                                  it.get_max_val("STAMINA", reduced),
-                                                  it.get_min_val("STAMINA", reduced) );
-                    if( stamina < 0 ) {
-                        // TODO: Make it drain fatigue and/or oxygen?
-                        stamina = 0;
-                    } else if( stamina > get_stamina_max() ) {
-                        stamina = get_stamina_max();
-                    }
+        // Handle coughing
+        mod = 1;
+        val = 0;
+        if (it.activated(calendar::turn, "COUGH", val, reduced, mod)) {
+            cough(it.get_harmful_cough());
+        }
+
+        // Handle vomiting
+        mod = vomit_mod();
+        val = 0;
+        if (it.activated(calendar::turn, "VOMIT", val, reduced, mod)) {
+            vomit();
+        }
+
+        // Handle stamina
+        val = it.get_mod("STAMINA", reduced);
+        if (val != 0) {
+            mod = 1;
+            if(it.activated(calendar::turn, "STAMINA", val, reduced, mod)) {
+                stamina += bound_mod_to_vals( stamina, val,
+                                              it.get_max_val("STAMINA", reduced),
+                                              it.get_min_val("STAMINA", reduced) );
+                if( stamina < 0 ) {
+                    // TODO: Make it drain fatigue and/or oxygen?
+                    stamina = 0;
+                } else if( stamina > get_stamina_max() ) {
+                    stamina = get_stamina_max();
                 }
             }
-
-            // Speed and stats are handled in recalc_speed_bonus and reset_stats respectively
         }
-    }
+
+        // Speed and stats are handled in recalc_speed_bonus and reset_stats respectively
+    } );
 
     Creature::process_effects();
 }
@@ -6395,7 +6528,7 @@ void player::hardcoded_effects(effect &it)
         deal_damage( nullptr, bp, damage_instance( DT_HEAT, rng( intense, intense * 2 ) ) );
     } else if( id == effect_spores ) {
         // Equivalent to X in 150000 + health * 100
-        if ((!has_trait("M_IMMUNE")) && (one_in(100) && x_in_y(intense, 150 + get_healthy() / 10)) ) {
+        if ((!has_trait( trait_M_IMMUNE )) && (one_in(100) && x_in_y(intense, 150 + get_healthy() / 10)) ) {
             add_effect( effect_fungus, 1, num_bp, true );
         }
     } else if( id == effect_fungus ) {
@@ -7145,7 +7278,7 @@ void player::hardcoded_effects(effect &it)
             }
         }
         if (one_in(10000)) {
-            if (!has_trait("M_IMMUNE")) {
+            if (!has_trait( trait_M_IMMUNE )) {
                 add_effect( effect_fungus, 1, num_bp, true );
             } else {
                 add_msg_if_player(m_info, _("We have many colonists awaiting passage."));
@@ -7286,7 +7419,7 @@ void player::hardcoded_effects(effect &it)
         }
 
         if( dur > 18000 && one_in( MINUTES( 5 ) * 512 ) ) {
-            if( !has_trait( "NOPAIN" ) ) {
+            if( !has_trait( trait_NOPAIN ) ) {
                 add_msg_if_player(m_bad, _("Your heart spasms painfully and stops, dragging you back to reality as you die."));
             } else {
                 add_msg_if_player(_("You dissolve into beautiful paroxysms of energy.  Life fades from your nebulae and you are no more."));
@@ -7337,7 +7470,7 @@ void player::hardcoded_effects(effect &it)
             if (has_effect( effect_recover )) {
                 recover_factor -= get_effect_dur( effect_recover ) / 600;
             }
-            if (has_trait("INFRESIST")) {
+            if (has_trait( trait_INFRESIST )) {
                 recover_factor += 200;
             }
             recover_factor += get_healthy() / 10;
@@ -7370,7 +7503,7 @@ void player::hardcoded_effects(effect &it)
             if (has_effect( effect_recover )) {
                 recover_factor -= get_effect_dur( effect_recover ) / 600;
             }
-            if (has_trait("INFRESIST")) {
+            if (has_trait( trait_INFRESIST )) {
                 recover_factor += 200;
             }
             recover_factor += get_healthy() / 10;
@@ -7456,7 +7589,7 @@ void player::hardcoded_effects(effect &it)
         }
 
         // TODO: Move this to update_needs when NPCs can mutate
-        if( calendar::once_every(MINUTES(10)) && has_trait("CHLOROMORPH") &&
+        if( calendar::once_every(MINUTES(10)) && has_trait( trait_CHLOROMORPH ) &&
             g->is_in_sunlight(pos()) ) {
             // Hunger and thirst fall before your Chloromorphic physiology!
             if (get_hunger() >= -30) {
@@ -7493,7 +7626,7 @@ void player::hardcoded_effects(effect &it)
                     add_msg_if_player( "%s", dream.c_str() );
                 }
                 // Mycus folks upgrade in their sleep.
-                if (has_trait("THRESH_MYCUS")) {
+                if (has_trait( trait_THRESH_MYCUS )) {
                     if (one_in(8)) {
                         mutate_category("MUTCAT_MYCUS");
                         mod_hunger(10);
@@ -7507,7 +7640,7 @@ void player::hardcoded_effects(effect &it)
         bool woke_up = false;
         int tirednessVal = rng(5, 200) + rng(0, abs(get_fatigue() * 2 * 5));
         if( !is_blind() ) {
-            if (has_trait("HEAVYSLEEPER2") && !has_trait("HIBERNATE")) {
+            if (has_trait( trait_HEAVYSLEEPER2 ) && !has_trait( trait_HIBERNATE )) {
                 // So you can too sleep through noon
                 if ((tirednessVal * 1.25) < g->m.ambient_light_at(pos()) && (get_fatigue() < 10 || one_in(get_fatigue() / 2))) {
                     add_msg_if_player(_("It's too bright to sleep."));
@@ -7516,7 +7649,7 @@ void player::hardcoded_effects(effect &it)
                     woke_up = true;
                 }
              // Ursine hibernators would likely do so indoors.  Plants, though, might be in the sun.
-            } else if (has_trait("HIBERNATE")) {
+            } else if (has_trait( trait_HIBERNATE )) {
                 if ((tirednessVal * 5) < g->m.ambient_light_at(pos()) && (get_fatigue() < 10 || one_in(get_fatigue() / 2))) {
                     add_msg_if_player(_("It's too bright to sleep."));
                     // Set ourselves up for removal
@@ -7572,17 +7705,17 @@ void player::hardcoded_effects(effect &it)
     } else if( id == effect_alarm_clock ) {
         if( has_effect( effect_sleep ) ) {
             if (dur == 1) {
-                if(has_bionic("bio_watch")) {
+                if(has_bionic( bio_watch )) {
                     // Normal alarm is volume 12, tested against (2/3/6)d15 for
                     // normal/HEAVYSLEEPER/HEAVYSLEEPER2.
                     //
                     // It's much harder to ignore an alarm inside your own skull,
                     // so this uses an effective volume of 20.
                     const int volume = 20;
-                    if ( (!(has_trait("HEAVYSLEEPER") || has_trait("HEAVYSLEEPER2")) &&
+                    if ( (!(has_trait( trait_HEAVYSLEEPER ) || has_trait( trait_HEAVYSLEEPER2 )) &&
                           dice(2, 15) < volume) ||
-                          (has_trait("HEAVYSLEEPER") && dice(3, 15) < volume) ||
-                          (has_trait("HEAVYSLEEPER2") && dice(6, 15) < volume) ) {
+                          (has_trait( trait_HEAVYSLEEPER ) && dice(3, 15) < volume) ||
+                          (has_trait( trait_HEAVYSLEEPER2 ) && dice(6, 15) < volume) ) {
                         wake_up();
                         add_msg_if_player(_("Your internal chronometer wakes you up."));
                     } else {
@@ -7681,14 +7814,14 @@ void player::suffer()
     }
 
     if (underwater) {
-        if (!has_trait("GILLS") && !has_trait("GILLS_CEPH")) {
+        if (!has_trait( trait_GILLS ) && !has_trait( trait_GILLS_CEPH )) {
             oxygen--;
         }
         if (oxygen < 12 && worn_with_flag("REBREATHER")) {
                 oxygen += 12;
             }
         if (oxygen <= 5) {
-            if (has_bionic("bio_gills") && power_level >= 25) {
+            if (has_bionic( bio_gills ) && power_level >= 25) {
                 oxygen += 5;
                 charge_power(-25);
             } else {
@@ -7704,7 +7837,7 @@ void player::suffer()
     }
 
     double shoe_factor = footwear_factor();
-    if( has_trait("ROOTS3") && g->m.has_flag("DIGGABLE", pos()) && !shoe_factor) {
+    if( has_trait( trait_ROOTS3 ) && g->m.has_flag("DIGGABLE", pos()) && !shoe_factor) {
         if (one_in(100)) {
             add_msg_if_player(m_good, _("This soil is delicious!"));
             if (get_hunger() > -20) {
@@ -7740,9 +7873,9 @@ void player::suffer()
             }
         }
         int timer = -HOURS( 6 );
-        if( has_trait( "ADDICTIVE" ) ) {
+        if( has_trait( trait_ADDICTIVE ) ) {
             timer = -HOURS( 10 );
-        } else if( has_trait( "NONADDICTIVE" ) ) {
+        } else if( has_trait( trait_NONADDICTIVE ) ) {
             timer = -HOURS( 3 );
         }
         for( size_t i = 0; i < addictions.size(); i++ ) {
@@ -7763,8 +7896,8 @@ void player::suffer()
                 }
             }
         }
-        if (has_trait("CHEMIMBALANCE")) {
-            if (one_in(3600) && (!(has_trait("NOPAIN")))) {
+        if (has_trait( trait_CHEMIMBALANCE )) {
+            if (one_in(3600) && (!(has_trait( trait_NOPAIN )))) {
                 add_msg_if_player(m_bad, _("You suddenly feel sharp pain for no reason."));
                 mod_pain( 3 * rng(1, 3) );
             }
@@ -7772,7 +7905,7 @@ void player::suffer()
                 int pkilladd = 5 * rng(-1, 2);
                 if (pkilladd > 0) {
                     add_msg_if_player(m_bad, _("You suddenly feel numb."));
-                } else if ((pkilladd < 0) && (!(has_trait("NOPAIN")))) {
+                } else if ((pkilladd < 0) && (!(has_trait( trait_NOPAIN )))) {
                     add_msg_if_player(m_bad, _("You suddenly ache."));
                 }
                 mod_painkiller(pkilladd);
@@ -7832,7 +7965,7 @@ void player::suffer()
                 }
             }
         }
-        if ((has_trait("SCHIZOPHRENIC") || has_artifact_with(AEP_SCHIZO)) &&
+        if ((has_trait( trait_SCHIZOPHRENIC ) || has_artifact_with(AEP_SCHIZO)) &&
             one_in(2400)) { // Every 4 hours or so
             monster phantasm;
             int i;
@@ -7887,7 +8020,7 @@ void player::suffer()
                     break;
             }
         }
-        if (has_trait("JITTERY") && !has_effect( effect_shakes )) {
+        if (has_trait( trait_JITTERY ) && !has_effect( effect_shakes )) {
             if (stim > 50 && one_in(300 - stim)) {
                 add_effect( effect_shakes, 300 + stim );
             } else if (get_hunger() > 80 && one_in(500 - get_hunger())) {
@@ -7895,7 +8028,7 @@ void player::suffer()
             }
         }
 
-        if (has_trait("MOODSWINGS") && one_in(3600)) {
+        if (has_trait( trait_MOODSWINGS ) && one_in(3600)) {
             if (rng(1, 20) > 9) { // 55% chance
                 add_morale(MORALE_MOODSWING, -100, -500);
             } else {  // 45% chance
@@ -7903,28 +8036,28 @@ void player::suffer()
             }
         }
 
-        if (has_trait("VOMITOUS") && one_in(4200)) {
+        if (has_trait( trait_VOMITOUS ) && one_in(4200)) {
             vomit();
         }
 
-        if (has_trait("SHOUT1") && one_in(3600)) {
+        if (has_trait( trait_SHOUT1 ) && one_in(3600)) {
             shout();
         }
-        if (has_trait("SHOUT2") && one_in(2400)) {
+        if (has_trait( trait_SHOUT2 ) && one_in(2400)) {
             shout();
         }
-        if (has_trait("SHOUT3") && one_in(1800)) {
+        if (has_trait( trait_SHOUT3 ) && one_in(1800)) {
             shout();
         }
-        if (has_trait("M_SPORES") && one_in(2400)) {
+        if (has_trait( trait_M_SPORES ) && one_in(2400)) {
             spores();
         }
-        if (has_trait("M_BLOSSOMS") && one_in(1800)) {
+        if (has_trait( trait_M_BLOSSOMS ) && one_in(1800)) {
             blossoms();
         }
     } // Done with while-awake-only effects
 
-    if( has_trait("ASTHMA") && one_in(3600 - stim * 50) &&
+    if( has_trait( trait_ASTHMA ) && one_in(3600 - stim * 50) &&
         !has_effect( effect_adrenaline ) & !has_effect( effect_datura ) ) {
         bool auto_use = has_charges("inhaler", 1);
         if (underwater) {
@@ -7959,23 +8092,23 @@ void player::suffer()
         }
     }
 
-    if (has_trait("LEAVES") && g->is_in_sunlight(pos()) && one_in(600)) {
+    if (has_trait( trait_LEAVES ) && g->is_in_sunlight(pos()) && one_in(600)) {
         mod_hunger(-1);
     }
 
     if (get_pain() > 0) {
-        if (has_trait("PAINREC1") && one_in(600)) {
+        if (has_trait( trait_PAINREC1 ) && one_in(600)) {
             mod_pain( -1 );
         }
-        if (has_trait("PAINREC2") && one_in(300)) {
+        if (has_trait( trait_PAINREC2 ) && one_in(300)) {
             mod_pain( -1 );
         }
-        if (has_trait("PAINREC3") && one_in(150)) {
+        if (has_trait( trait_PAINREC3 ) && one_in(150)) {
             mod_pain( -1 );
         }
     }
 
-    if( ( has_trait( "ALBINO" ) || has_effect( effect_datura ) ) &&
+    if( ( has_trait( trait_ALBINO ) || has_effect( effect_datura ) ) &&
         g->is_in_sunlight( pos() ) && one_in(10) ) {
         // Umbrellas can keep the sun off the skin and sunglasses - off the eyes.
         if( !weapon.has_flag( "RAIN_PROTECT" ) ) {
@@ -7997,7 +8130,7 @@ void player::suffer()
         }
     }
 
-    if (has_trait("SUNBURN") && g->is_in_sunlight(pos()) && one_in(10)) {
+    if (has_trait( trait_SUNBURN ) && g->is_in_sunlight(pos()) && one_in(10)) {
         if( !( weapon.has_flag( "RAIN_PROTECT" ) ) ) {
         add_msg(m_bad, _("The sunlight burns your skin!"));
         if (in_sleep_state()) {
@@ -8008,7 +8141,7 @@ void player::suffer()
         }
     }
 
-    if((has_trait("TROGLO") || has_trait("TROGLO2")) &&
+    if((has_trait( trait_TROGLO ) || has_trait( trait_TROGLO2 )) &&
         g->is_in_sunlight(pos()) && g->weather == WEATHER_SUNNY) {
         mod_str_bonus(-1);
         mod_dex_bonus(-1);
@@ -8016,14 +8149,14 @@ void player::suffer()
         mod_int_bonus(-1);
         mod_per_bonus(-1);
     }
-    if (has_trait("TROGLO2") && g->is_in_sunlight(pos())) {
+    if (has_trait( trait_TROGLO2 ) && g->is_in_sunlight(pos())) {
         mod_str_bonus(-1);
         mod_dex_bonus(-1);
         add_miss_reason(_("The sunlight distracts you."), 1);
         mod_int_bonus(-1);
         mod_per_bonus(-1);
     }
-    if (has_trait("TROGLO3") && g->is_in_sunlight(pos())) {
+    if (has_trait( trait_TROGLO3 ) && g->is_in_sunlight(pos())) {
         mod_str_bonus(-4);
         mod_dex_bonus(-4);
         add_miss_reason(_("You can't stand the sunlight!"), 4);
@@ -8031,7 +8164,7 @@ void player::suffer()
         mod_per_bonus(-4);
     }
 
-    if (has_trait("SORES")) {
+    if (has_trait( trait_SORES )) {
         for (int i = bp_head; i < num_bp; i++) {
             int sores_pain = 5 + (int)(0.4 * abs( encumb( body_part( i ) ) ) );
             if (get_pain() < sores_pain) {
@@ -8047,7 +8180,7 @@ void player::suffer()
 
     // Blind/Deaf for brief periods about once an hour,
     // and visuals about once every 30 min.
-    if (has_trait("PER_SLIME")) {
+    if (has_trait( trait_PER_SLIME )) {
         if (one_in(600) && !has_effect( effect_deaf )) {
             add_msg_if_player(m_bad, _("Suddenly, you can't hear anything!"));
             add_effect( effect_deaf, 100 * rng ( 2, 6 ) ) ;
@@ -8064,14 +8197,14 @@ void player::suffer()
         }
     }
 
-    if (has_trait("WEB_SPINNER") && !in_vehicle && one_in(3)) {
+    if (has_trait( trait_WEB_SPINNER ) && !in_vehicle && one_in(3)) {
         g->m.add_field( pos(), fd_web, 1, 0 ); //this adds density to if its not already there.
     }
 
-    if (has_trait("UNSTABLE") && one_in(28800)) { // Average once per 2 days
+    if (has_trait( trait_UNSTABLE ) && one_in(28800)) { // Average once per 2 days
         mutate();
     }
-    if (has_trait("CHAOTIC") && one_in(7200)) { // Should be once every 12 hours
+    if (has_trait( trait_CHAOTIC ) && one_in(7200)) { // Should be once every 12 hours
         mutate();
     }
     if (has_artifact_with(AEP_MUTAGENIC) && one_in(28800)) {
@@ -8087,11 +8220,11 @@ void player::suffer()
     const int map_radiation = g->m.get_radiation( pos() );
 
     int rad_mut = 0;
-    if( has_trait("RADIOACTIVE3") ) {
+    if( has_trait( trait_RADIOACTIVE3 ) ) {
         rad_mut = 3;
-    } else if( has_trait("RADIOACTIVE2") ) {
+    } else if( has_trait( trait_RADIOACTIVE2 ) ) {
         rad_mut = 2;
-    } else if( has_trait("RADIOACTIVE1") ) {
+    } else if( has_trait( trait_RADIOACTIVE1 ) ) {
         rad_mut = 1;
     }
 
@@ -8143,7 +8276,7 @@ void player::suffer()
             rads *= 0.3f + 0.1f * rad_mut;
         }
 
-        if( rads > 0.0f && calendar::once_every(MINUTES(3)) && has_bionic("bio_geiger") ) {
+        if( rads > 0.0f && calendar::once_every(MINUTES(3)) && has_bionic( bio_geiger ) ) {
             add_msg_if_player(m_warning, _("You feel anomalous sensation coming from your radiation sensors."));
         }
 
@@ -8205,7 +8338,7 @@ void player::suffer()
         }
     }
 
-    const bool radiogenic = has_trait("RADIOGENIC");
+    const bool radiogenic = has_trait( trait_RADIOGENIC );
     if( radiogenic && int(calendar::turn) % MINUTES(30) == 0 && radiation > 0 ) {
         // At 200 irradiation, twice as fast as REGEN
         if( x_in_y( radiation, 200 ) ) {
@@ -8233,12 +8366,12 @@ void player::suffer()
 
     if (reactor_plut || tank_plut || slow_rad) {
         // Microreactor CBM and supporting bionics
-        if (has_bionic("bio_reactor") || has_bionic("bio_advreactor")) {
+        if (has_bionic( bio_reactor ) || has_bionic( bio_advreactor )) {
             //first do the filtering of plutonium from storage to reactor
             int plut_trans;
             plut_trans = 0;
             if (tank_plut > 0) {
-                if (has_active_bionic("bio_plut_filter")) {
+                if (has_active_bionic( bio_plut_filter )) {
                     plut_trans = (tank_plut * 0.025);
                 } else {
                     plut_trans = (tank_plut * 0.005);
@@ -8255,7 +8388,7 @@ void player::suffer()
             if (reactor_plut > 0) {
                 int power_gen;
                 power_gen = 0;
-                if (has_bionic("bio_advreactor")){
+                if (has_bionic( bio_advreactor )){
                     if ((reactor_plut * 0.05) > 2000){
                         power_gen = 2000;
                     } else {
@@ -8274,7 +8407,7 @@ void player::suffer()
                         break;
                         }
                     }
-                } else if (has_bionic("bio_reactor")) {
+                } else if (has_bionic( bio_reactor )) {
                     if ((reactor_plut * 0.025) > 500){
                         power_gen = 500;
                     } else {
@@ -8308,7 +8441,7 @@ void player::suffer()
     }
 
     // Negative bionics effects
-    if (has_bionic("bio_dis_shock") && one_in(1200)) {
+    if (has_bionic( bio_dis_shock ) && one_in(1200)) {
         add_msg_if_player(m_bad, _("You suffer a painful electrical discharge!"));
         mod_pain(1);
         moves -= 150;
@@ -8322,15 +8455,15 @@ void player::suffer()
             add_msg_if_player(m_good, _("The %s seems to be affected by the discharge."), weapon.tname().c_str());
         }
     }
-    if (has_bionic("bio_dis_acid") && one_in(1500)) {
+    if (has_bionic( bio_dis_acid ) && one_in(1500)) {
         add_msg_if_player(m_bad, _("You suffer a burning acidic discharge!"));
         hurtall(1, nullptr);
     }
-    if (has_bionic("bio_drain") && power_level > 24 && one_in(600)) {
+    if (has_bionic( bio_drain ) && power_level > 24 && one_in(600)) {
         add_msg_if_player(m_bad, _("Your batteries discharge slightly."));
         charge_power(-25);
     }
-    if (has_bionic("bio_noise") && one_in(500)) {
+    if (has_bionic( bio_noise ) && one_in(500)) {
         // TODO: NPCs with said bionic
         if(!is_deaf()) {
             add_msg(m_bad, _("A bionic emits a crackle of noise!"));
@@ -8339,32 +8472,32 @@ void player::suffer()
         }
         sounds::sound( pos(), 60, "");
     }
-    if (has_bionic("bio_power_weakness") && max_power_level > 0 &&
+    if (has_bionic( bio_power_weakness ) && max_power_level > 0 &&
         power_level >= max_power_level * .75) {
         mod_str_bonus(-3);
     }
-    if (has_bionic("bio_trip") && one_in(500) && !has_effect( effect_visuals )) {
+    if (has_bionic( bio_trip ) && one_in(500) && !has_effect( effect_visuals )) {
         add_msg_if_player(m_bad, _("Your vision pixelates!"));
         add_effect( effect_visuals, 100 );
     }
-    if (has_bionic("bio_spasm") && one_in(3000) && !has_effect( effect_downed )) {
+    if (has_bionic( bio_spasm ) && one_in(3000) && !has_effect( effect_downed )) {
         add_msg_if_player(m_bad, _("Your malfunctioning bionic causes you to spasm and fall to the floor!"));
         mod_pain(1);
         add_effect( effect_stunned, 1);
         add_effect( effect_downed, 1, num_bp, false, 0, true );
     }
-    if (has_bionic("bio_shakes") && power_level > 24 && one_in(1200)) {
+    if (has_bionic( bio_shakes ) && power_level > 24 && one_in(1200)) {
         add_msg_if_player(m_bad, _("Your bionics short-circuit, causing you to tremble and shiver."));
         charge_power(-25);
         add_effect( effect_shakes, 50 );
     }
-    if (has_bionic("bio_leaky") && one_in(500)) {
+    if (has_bionic( bio_leaky ) && one_in(500)) {
         mod_healthy_mod(-50, -200);
     }
-    if (has_bionic("bio_sleepy") && one_in(500) && !in_sleep_state()) {
+    if (has_bionic( bio_sleepy ) && one_in(500) && !in_sleep_state()) {
         mod_fatigue(1);
     }
-    if (has_bionic("bio_itchy") && one_in(500) && !has_effect( effect_formication )) {
+    if (has_bionic( bio_itchy ) && one_in(500) && !has_effect( effect_formication )) {
         add_msg_if_player(m_bad, _("Your malfunctioning bionic itches!"));
         body_part bp = random_body_part(true);
         add_effect( effect_formication, 100, bp );
@@ -8401,7 +8534,7 @@ void player::mend( int rate_multiplier )
         healing_factor *= 0.5;
     }
 
-    if( radiation > 0 && !has_trait( "RADIOGENIC" ) ) {
+    if( radiation > 0 && !has_trait( trait_RADIOGENIC ) ) {
         healing_factor *= std::max( 0.0f, (1000.0f - radiation) / 1000.0f );
     }
 
@@ -8426,17 +8559,17 @@ void player::mend( int rate_multiplier )
     }
 
     // Mutagenic healing factor!
-    if( has_trait("REGEN") ) {
+    if( has_trait( trait_REGEN ) ) {
         healing_factor *= 16.0;
-    } else if( has_trait("FASTHEALER2") ) {
+    } else if( has_trait( trait_FASTHEALER2 ) ) {
         healing_factor *= 4.0;
-    } else if( has_trait("FASTHEALER") ) {
+    } else if( has_trait( trait_FASTHEALER ) ) {
         healing_factor *= 2.0;
-    } else if( has_trait("SLOWHEALER") ) {
+    } else if( has_trait( trait_SLOWHEALER ) ) {
         healing_factor *= 0.5;
     }
 
-    if( has_trait("REGEN_LIZ") ) {
+    if( has_trait( trait_REGEN_LIZ ) ) {
         healing_factor = 20.0;
     }
 
@@ -8473,7 +8606,7 @@ void player::mend( int rate_multiplier )
                     // No mending for you!
                     continue;
             }
-            if( mended == false && has_trait("REGEN_LIZ") ) {
+            if( mended == false && has_trait( trait_REGEN_LIZ ) ) {
                 // Splints aren't *strictly* necessary for your anatomy
                 mended = x_in_y(healing_factor * 0.2, mending_odds);
             }
@@ -8527,16 +8660,13 @@ void player::vomit()
     }
 
     moves -= 100;
-    for( auto &elem : effects ) {
-        for( auto &_effect_it : elem.second ) {
-            auto &it = _effect_it.second;
-            if( it.get_id() == effect_foodpoison ) {
-                it.mod_duration(-300);
-            } else if( it.get_id() == effect_drunk ) {
-                it.mod_duration(rng(-100, -500));
-            }
+    effects.for_each( []( effect & it ) {
+        if( it.get_id() == effect_foodpoison ) {
+            it.mod_duration(-300);
+        } else if( it.get_id() == effect_drunk ) {
+            it.mod_duration(rng(-100, -500));
         }
-    }
+    } );
     remove_effect( effect_pkill1 );
     remove_effect( effect_pkill2 );
     remove_effect( effect_pkill3 );
@@ -8802,12 +8932,9 @@ void player::check_and_recover_morale()
         test_morale.on_mutation_gain( mut.first );
     }
 
-    for( auto &elem : effects ) {
-        for( auto &_effect_it : elem.second ) {
-            const effect &e = _effect_it.second;
-            test_morale.on_effect_int_change( e.get_id(), e.get_intensity(), e.get_bp() );
-        }
-    }
+    effects.for_each( [&test_morale]( const effect & e ) {
+        test_morale.on_effect_int_change( e.get_id(), e.get_intensity(), e.get_bp() );
+    } );
 
     test_morale.on_stat_change( "hunger", get_hunger() );
     test_morale.on_stat_change( "thirst", get_thirst() );
@@ -8820,7 +8947,7 @@ void player::check_and_recover_morale()
 
     if( !morale->consistent_with( test_morale ) ) {
         morale.reset( new player_morale( test_morale ) ); // Recover consistency
-        add_msg( m_debug, "%s morale was recovered.", disp_name( true ).c_str() );
+        add_msg_debug( "%s morale was recovered.", disp_name( true ).c_str() );
     }
 }
 
@@ -11020,18 +11147,12 @@ bool player::invoke_item( item* used, const tripoint &pt )
     // Same for meds
     if( used->is_food() || used->is_food_container() ||
         used->is_medication() || used->is_medication_container() ) {
-        bool med = used->is_medication() || used->is_medication_container();
-        bool in_container = used->is_food_container() || used->is_medication_container();
-        bool consumed = med ? consume_med( *used, pt ) : consume_item( *used );
-        if( consumed ) {
-            i_rem( in_container ? &used->contents.front() : used );
-        }
-
-        return consumed;
+        return invoke_consumable( *used, pt );
     }
 
 
     if( used->type->use_methods.size() < 2 ) {
+        lua_hook_item_use( *this, *used, pt );
         const long charges_used = used->type->invoke( this, used, pt );
         return used->is_tool() && consume_charges( *used, charges_used );
     }
@@ -11051,11 +11172,26 @@ bool player::invoke_item( item* used, const tripoint &pt )
     }
 
     const std::string &method = std::next( used->type->use_methods.begin(), choice )->first;
+    lua_hook_item_use( *this, *used, pt );
     long charges_used = used->type->invoke( this, used, pt, method );
 
     return used->is_tool() && consume_charges( *used, charges_used );
 }
 
+bool player::invoke_consumable( item &used, const tripoint &pt )
+{
+    bool med = used.is_medication() || used.is_medication_container();
+    bool in_container = used.is_food_container() || used.is_medication_container();
+    bool consumed = med ? consume_med( used, pt ) : consume_item( used );
+    if( consumed ) {
+        // Only reported once it worked, and while the item still exists
+        lua_hook_item_use( *this, used, pt );
+        i_rem( in_container ? &used.contents.front() : &used );
+    }
+
+    return consumed;
+}
+
 bool player::invoke_item( item* used, const std::string &method )
 {
     return invoke_item( used, method, pos() );
@@ -11071,22 +11207,17 @@ bool player::invoke_item( item* used, const std::string &method, const tripoint
     if( actually_used == nullptr ) {
         debugmsg( "Tried to invoke a method %s on item %s, which doesn't have this method",
                   method.c_str(), used->tname().c_str() );
+        return false;
     }
 
     // Food can't be invoked here - it is already invoked as a part of consumption
     // Same for meds
     if( used->is_food() || used->is_food_container() ||
         used->is_medication() || used->is_medication_container() ) {
-        bool med = used->is_medication() || used->is_medication_container();
-        bool in_container = used->is_food_container() || used->is_medication_container();
-        bool consumed = med ? consume_med( *used, pt ) : consume_item( *used );
-        if( consumed ) {
-            i_rem( in_container ? &used->contents.front() : used );
-        }
-
-        return consumed;
+        return invoke_consumable( *used, pt );
     }
 
+    lua_hook_item_use( *this, *actually_used, pt );
     long charges_used = actually_used->type->invoke( this, actually_used, pt, method );
     return used->is_tool() && consume_charges( *actually_used, charges_used );
 }
@@ -11389,7 +11520,7 @@ bool player::read( int inventory_position, const bool continuous )
     }
     const int time_taken = time_to_read( it, *reader );
 
-    add_msg( m_debug, "player::read: time_taken = %d", time_taken );
+    add_msg_debug( "player::read: time_taken = %d", time_taken );
     player_activity act( ACT_READ, time_taken, continuous ? activity.index : 0, reader->getID() );
     act.targets.push_back( item_location( *this, &it ) );
 
@@ -12905,6 +13036,7 @@ int player::has_recipe( const recipe *r, const inventory &crafting_inv,
 void player::learn_recipe( const recipe * const rec )
 {
     learned_recipes[rec->ident()] = rec;
+    recipe_changes++;
 }
 
 void player::assign_activity(activity_type type, int moves, int index, int pos, std::string name)
@@ -13580,28 +13712,28 @@ float player::hearing_ability() const
     float volume_multiplier = 1.0;
 
     // Mutation/Bionic volume modifiers
-    if( has_active_bionic("bio_ears") && !has_active_bionic("bio_earplugs") ) {
+    if( has_active_bionic( bio_ears ) && !has_active_bionic( bio_earplugs ) ) {
         volume_multiplier *= 3.5;
     }
-    if( has_trait("PER_SLIME") ) {
+    if( has_trait( trait_PER_SLIME ) ) {
         // Random hearing :-/
         // (when it's working at all, see player.cpp)
         // changed from 0.5 to fix Mac compiling error
         volume_multiplier *= (rng(1, 2));
     }
-    if( has_trait("BADHEARING") ) {
+    if( has_trait( trait_BADHEARING ) ) {
         volume_multiplier *= .5;
     }
-    if( has_trait("GOODHEARING") ) {
+    if( has_trait( trait_GOODHEARING ) ) {
         volume_multiplier *= 1.25;
     }
-    if( has_trait("CANINE_EARS") ) {
+    if( has_trait( trait_CANINE_EARS ) ) {
         volume_multiplier *= 1.5;
     }
-    if( has_trait("URSINE_EARS") || has_trait("FELINE_EARS") ) {
+    if( has_trait( trait_URSINE_EARS ) || has_trait( trait_FELINE_EARS ) ) {
         volume_multiplier *= 1.25;
     }
-    if( has_trait("LUPINE_EARS") ) {
+    if( has_trait( trait_LUPINE_EARS ) ) {
         volume_multiplier *= 1.75;
     }
 
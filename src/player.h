@@ -1144,6 +1144,10 @@ class player : public Character, public JsonSerializer, public JsonDeserializer
                         const std::vector<npc *> &helpers ) const;
         bool knows_recipe( const recipe *rec ) const;
         void learn_recipe( const recipe *rec );
+        /** Changes whenever a recipe is learned or the known recipes are loaded. */
+        unsigned long recipes_revision() const {
+            return recipe_changes;
+        }
         int exceeds_recipe_requirements( const recipe &rec ) const;
         bool has_recipe_requirements( const recipe &rec ) const;
         bool has_recipe_autolearned( const recipe &rec ) const;
@@ -1453,6 +1457,8 @@ class player : public Character, public JsonSerializer, public JsonDeserializer
     private:
         // Items the player has identified.
         std::unordered_set<std::string> items_identified;
+        /** See @ref recipes_revision */
+        unsigned long recipe_changes = 0;
         /** Check if an area-of-effect technique has valid targets */
         bool valid_aoe_technique( Creature &t, const ma_technique &technique );
         bool valid_aoe_technique( Creature &t, const ma_technique &technique,
@@ -1463,6 +1469,8 @@ class player : public Character, public JsonSerializer, public JsonDeserializer
          * are included.
          */
         bool is_visible_in_range( const Creature &critter, int range ) const;
+        /** Eats or applies food or medicine for @ref invoke_item, removing it if it was used up. */
+        bool invoke_consumable( item &used, const tripoint &pt );
 
         /** Can the player lie down and cover self with blankets etc. **/
         bool can_use_floor_warmth() const;
@@ -0,0 +1,65 @@
+#include "pool_allocator.h"
+
+#include <algorithm>
+
+namespace
+{
+
+size_t aligned_block_size( size_t size )
+{
+    // Every block must be able to hold the free list link and keep the alignment
+    // operator new would have given it.
+    const size_t align = alignof( std::max_align_t );
+    size = std::max( size, sizeof( void * ) );
+    return ( size + align - 1 ) / align * align;
+}
+
+} // namespace
+
+slab_pool::slab_pool( size_t block_size, size_t blocks_per_slab ) :
+    block_size( aligned_block_size( block_size ) ), blocks_per_slab( blocks_per_slab )
+{
+}
+
+void *slab_pool::allocate()
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    if( free_list == nullptr ) {
+        slabs.emplace_back( new char[block_size * blocks_per_slab] );
+        char *const slab = slabs.back().get();
+        // Thread the new blocks in address order so consecutive allocations are adjacent.
+        for( size_t i = blocks_per_slab; i-- > 0; ) {
+            free_block *const block = reinterpret_cast<free_block *>( slab + i * block_size );
+            block->next = free_list;
+            free_list = block;
+        }
+    }
+    free_block *const block = free_list;
+    free_list = block->next;
+    in_use++;
+    return block;
+}
+
+void slab_pool::deallocate( void *p )
+{
+    if( p == nullptr ) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock( mutex );
+    free_block *const block = static_cast<free_block *>( p );
+    block->next = free_list;
+    free_list = block;
+    in_use--;
+}
+
+size_t slab_pool::allocated() const
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    return in_use;
+}
+
+size_t slab_pool::capacity() const
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    return slabs.size() * blocks_per_slab;
+}
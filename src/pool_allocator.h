@@ -0,0 +1,101 @@
+#ifndef POOL_ALLOCATOR_H
+#define POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+/**
+ * Hands out blocks of one fixed size, carved from large slabs.
+ * Freed blocks go onto a free list and are handed out again by the next allocation,
+ * so churning through many small objects of the same size reuses the same few slabs
+ * instead of scattering allocations over the general heap. Slabs are kept for the
+ * lifetime of the pool and are never returned to the system.
+ */
+class slab_pool
+{
+    public:
+        slab_pool( size_t block_size, size_t blocks_per_slab = 256 );
+        slab_pool( const slab_pool & ) = delete;
+        slab_pool &operator=( const slab_pool & ) = delete;
+
+        void *allocate();
+        void deallocate( void *p );
+
+        /** Number of blocks currently handed out. */
+        size_t allocated() const;
+        /** Number of blocks in all slabs, whether handed out or free. */
+        size_t capacity() const;
+
+    private:
+        struct free_block {
+            free_block *next;
+        };
+
+        const size_t block_size;
+        const size_t blocks_per_slab;
+        free_block *free_list = nullptr;
+        size_t in_use = 0;
+        std::vector<std::unique_ptr<char[]>> slabs;
+        mutable std::mutex mutex;
+};
+
+/**
+ * Stateless allocator that takes single objects from a @ref slab_pool shared by all
+ * allocators of the same type. Because every instance uses the same pool, instances
+ * compare equal and nodes can be spliced freely between containers using it.
+ * Array allocations (n != 1) are not pooled and go to the global operator new.
+ */
+template<typename T>
+class pool_allocator
+{
+    public:
+        typedef T value_type;
+
+        pool_allocator() = default;
+        template<typename U>
+        pool_allocator( const pool_allocator<U> & ) {}
+
+        T *allocate( size_t n ) {
+            if( n != 1 ) {
+                return static_cast<T *>( ::operator new( n * sizeof( T ) ) );
+            }
+            return static_cast<T *>( pool().allocate() );
+        }
+        void deallocate( T *p, size_t n ) {
+            if( n != 1 ) {
+                ::operator delete( p );
+                return;
+            }
+            pool().deallocate( p );
+        }
+
+        template<typename U>
+        struct rebind {
+            typedef pool_allocator<U> other;
+        };
+
+        /** The pool backing all allocators of this type. */
+        static slab_pool &pool() {
+            // Never destroyed: containers with static storage duration may still
+            // release their nodes after function-local statics have been torn down.
+            static slab_pool *instance = new slab_pool( sizeof( T ) );
+            return *instance;
+        }
+};
+
+template<typename T, typename U>
+bool operator==( const pool_allocator<T> &, const pool_allocator<U> & )
+{
+    return true;
+}
+
+template<typename T, typename U>
+bool operator!=( const pool_allocator<T> &, const pool_allocator<U> & )
+{
+    return false;
+}
+
+#endif
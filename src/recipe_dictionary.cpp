@@ -376,6 +376,7 @@ void recipe_dictionary::finalize()
 
 void recipe_dictionary::reset()
 {
+    recipe_availability::get_instance().clear();
     recipe_dict.component.clear();
     recipe_dict.category.clear();
     recipe_dict.recipes.clear();
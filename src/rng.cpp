@@ -1,10 +1,24 @@
 #include "output.h"
 #include "rng.h"
+#include "enums.h"
+
+#include <array>
 #include <stdlib.h>
 #include <random>
 
+namespace
+{
+
+/** Stream of the innermost @ref rng_stream_scope of this thread, if any. */
+thread_local rng_stream *scoped_stream = nullptr;
+
+} // namespace
+
 long rng( long val1, long val2 )
 {
+    if( scoped_stream != nullptr ) {
+        return scoped_stream->rng( val1, val2 );
+    }
     long minVal = ( val1 < val2 ) ? val1 : val2;
     long maxVal = ( val1 < val2 ) ? val2 : val1;
     return minVal + long( ( maxVal - minVal + 1 ) * double( rand() / double( RAND_MAX + 1.0 ) ) );
@@ -12,6 +26,9 @@ long rng( long val1, long val2 )
 
 double rng_float( double val1, double val2 )
 {
+    if( scoped_stream != nullptr ) {
+        return scoped_stream->rng_float( val1, val2 );
+    }
     double minVal = ( val1 < val2 ) ? val1 : val2;
     double maxVal = ( val1 < val2 ) ? val2 : val1;
     return minVal + ( maxVal - minVal ) * double( rand() ) / double( RAND_MAX + 1.0 );
@@ -30,6 +47,9 @@ bool one_in_improved( double chance )
 
 bool x_in_y( double x, double y )
 {
+    if( scoped_stream != nullptr ) {
+        return scoped_stream->x_in_y( x, y );
+    }
     return ( ( double )rand() / RAND_MAX ) <= ( ( double )x / y );
 }
 
@@ -88,3 +108,80 @@ double rng_normal( double lo, double hi )
     double val = std::normal_distribution<double>( ( hi + lo ) / 2, range )( eng );
     return std::max( std::min( val, hi ), lo );
 }
+
+namespace
+{
+
+// http://xoshiro.di.unimi.it/splitmix64.c
+// Used to expand seeds and keys, never for the random values themselves.
+uint64_t splitmix64( uint64_t &x )
+{
+    uint64_t z = ( x += 0x9E3779B97F4A7C15ULL );
+    z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+    z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL;
+    return z ^ ( z >> 31 );
+}
+
+std::array<rng_stream, static_cast<size_t>( rng_subsystem::num_subsystems )> &subsystem_roots()
+{
+    static std::array<rng_stream, static_cast<size_t>( rng_subsystem::num_subsystems )> roots;
+    return roots;
+}
+
+} // namespace
+
+rng_stream::rng_stream( uint64_t seed ) : seed( seed )
+{
+    uint64_t x = seed;
+    const uint64_t a = splitmix64( x );
+    const uint64_t b = splitmix64( x );
+    state[0] = uint32_t( a );
+    state[1] = uint32_t( a >> 32 );
+    state[2] = uint32_t( b );
+    state[3] = uint32_t( b >> 32 );
+    // All-zero state is the only invalid one for xoshiro.
+    if( ( state[0] | state[1] | state[2] | state[3] ) == 0 ) {
+        state[0] = 1;
+    }
+}
+
+rng_stream rng_stream::derive( uint64_t key ) const
+{
+    uint64_t x = key;
+    // Mixed once more after combining: a plain xor would be symmetric, so the child
+    // of one subsystem root could be the same stream as a child of another root.
+    uint64_t combined = seed ^ splitmix64( x );
+    return rng_stream( splitmix64( combined ) );
+}
+
+rng_stream rng_stream::derive( const tripoint &p ) const
+{
+    // 21 bits per coordinate is plenty for global submap coordinates.
+    const uint64_t key = ( uint64_t( p.x ) & 0x1FFFFF ) |
+                         ( ( uint64_t( p.y ) & 0x1FFFFF ) << 21 ) |
+                         ( ( uint64_t( p.z ) & 0x1FFFFF ) << 42 );
+    return derive( key );
+}
+
+rng_stream_scope::rng_stream_scope( rng_stream &stream ) : previous( scoped_stream )
+{
+    scoped_stream = &stream;
+}
+
+rng_stream_scope::~rng_stream_scope()
+{
+    scoped_stream = previous;
+}
+
+void rng_set_world_seed( uint64_t seed )
+{
+    auto &roots = subsystem_roots();
+    for( size_t i = 0; i < roots.size(); i++ ) {
+        roots[i] = rng_stream( seed ).derive( i );
+    }
+}
+
+const rng_stream &rng_root( rng_subsystem sys )
+{
+    return subsystem_roots()[static_cast<size_t>( sys )];
+}
@@ -3,8 +3,11 @@
 
 #include "compatibility.h"
 
+#include <cstdint>
 #include <functional>
 
+struct tripoint;
+
 long rng( long val1, long val2 );
 double rng_float( double val1, double val2 );
 bool one_in( int chance );
@@ -26,6 +29,135 @@ inline double rng_normal( double hi )
     return rng_normal( 0.0, hi );
 }
 
+/**
+ * Small, fast, explicitly seeded pseudo random generator (xoshiro128**).
+ *
+ * The free functions above all share one global generator, so the values a
+ * subsystem gets depend on everything else that drew numbers before it. An
+ * rng_stream is independent of that: the same seed always yields the same
+ * sequence, and @ref derive creates child streams (e.g. one per submap or per
+ * monster) that only depend on the parent seed and the key, not on how many
+ * numbers were drawn so far. Deriving is const, so several threads can derive
+ * from a shared root stream at the same time.
+ *
+ * It also satisfies the UniformRandomBitGenerator requirements and can be
+ * handed to `<random>` distributions and `std::shuffle`.
+ */
+class rng_stream
+{
+    public:
+        typedef uint32_t result_type;
+
+        explicit rng_stream( uint64_t seed = 0 );
+
+        /** Returns an independent child stream for the given key. */
+        rng_stream derive( uint64_t key ) const;
+        rng_stream derive( const tripoint &p ) const;
+
+        static constexpr result_type min() {
+            return 0;
+        }
+        static constexpr result_type max() {
+            return UINT32_MAX;
+        }
+        result_type operator()() {
+            const uint32_t result = rotl( state[1] * 5, 7 ) * 9;
+            const uint32_t t = state[1] << 9;
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = rotl( state[3], 11 );
+            return result;
+        }
+
+        /** Same semantics as the free function @ref ::rng, bounds are inclusive. */
+        long rng( long val1, long val2 ) {
+            const long lo = val1 < val2 ? val1 : val2;
+            const long hi = val1 < val2 ? val2 : val1;
+            const uint64_t span = uint64_t( hi ) - uint64_t( lo ) + 1;
+            if( span - 1 <= UINT32_MAX ) {
+                // Multiply-shift range reduction, avoids the division of a modulo.
+                return lo + long( ( uint64_t( ( *this )() ) * span ) >> 32 );
+            }
+            const uint64_t wide = ( uint64_t( ( *this )() ) << 32 ) | ( *this )();
+            return span == 0 ? long( wide ) : lo + long( wide % span );
+        }
+        /** Uniform value in [val1, val2). */
+        double rng_float( double val1, double val2 ) {
+            const double lo = val1 < val2 ? val1 : val2;
+            const double hi = val1 < val2 ? val2 : val1;
+            return lo + ( hi - lo ) * unit();
+        }
+        bool one_in( int chance ) {
+            return chance <= 1 || rng( 0, chance - 1 ) == 0;
+        }
+        bool x_in_y( double x, double y ) {
+            return unit() < x / y;
+        }
+        int dice( int number, int sides ) {
+            int ret = 0;
+            for( int i = 0; i < number; i++ ) {
+                ret += rng( 1, sides );
+            }
+            return ret;
+        }
+
+    private:
+        static uint32_t rotl( uint32_t x, int k ) {
+            return ( x << k ) | ( x >> ( 32 - k ) );
+        }
+        /** Uniform value in [0, 1). */
+        double unit() {
+            return ( *this )() * ( 1.0 / 4294967296.0 );
+        }
+
+        uint64_t seed;
+        uint32_t state[4];
+};
+
+/**
+ * While alive, makes the free functions above (and everything built on them, like
+ * @ref random_entry) draw from the given stream instead of the global generator,
+ * on the current thread only. Code written against the free functions can so be
+ * run deterministically and off the main thread. Scopes can be nested, the stream
+ * must outlive the scope.
+ */
+class rng_stream_scope
+{
+    public:
+        explicit rng_stream_scope( rng_stream &stream );
+        ~rng_stream_scope();
+
+        rng_stream_scope( const rng_stream_scope & ) = delete;
+        rng_stream_scope &operator=( const rng_stream_scope & ) = delete;
+
+    private:
+        rng_stream *previous;
+};
+
+/**
+ * Subsystems that draw from their own @ref rng_stream instead of the global
+ * generator, so that their results don't depend on each other.
+ */
+enum class rng_subsystem : int {
+    mapgen,
+    overmap,
+    monster_ai,
+    sound,
+    weather,
+    num_subsystems
+};
+
+/**
+ * Reseeds the root stream of every subsystem from the world seed. Called
+ * whenever a game is started or loaded.
+ */
+void rng_set_world_seed( uint64_t seed );
+/** Root stream of a subsystem, derive from it for per-object streams. */
+const rng_stream &rng_root( rng_subsystem sys );
+
 /**
  * Returns a random entry in the container.
  * The container must have a `size()` function and must support iterators as usual.
@@ -22,6 +22,7 @@
 #include "translations.h"
 #include "mongroup.h"
 #include "scent_map.h"
+#include "rng.h"
 
 #include <map>
 #include <set>
@@ -294,6 +295,7 @@ void game::load_weather(std::istream & fin) {
         std::stringstream liness(line);
         liness >> label >> seed;
     }
+    rng_set_world_seed( seed );
 }
 
 void game::save_weather(std::ostream &fout) {
@@ -833,9 +835,9 @@ void overmap::serialize( std::ostream &fout ) const
 
     json.member("mongroups");
     json.start_array();
-    for( const auto &group : zg ) {
-        json.write(group.second);
-    }
+    zg.for_each( [&json]( const mongroup &group ) {
+        json.write( group );
+    } );
     json.end_array();
     fout << std::endl;
 
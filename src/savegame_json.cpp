@@ -32,6 +32,7 @@
 #include "mutation.h"
 #include "io.h"
 #include "mtype.h"
+#include "monstergenerator.h"
 #include "item_factory.h"
 #include "recipe_dictionary.h"
 
@@ -42,7 +43,7 @@
 #include "json.h"
 
 #include "debug.h"
-#define dbg(x) DebugLog((DebugLevel)(x),D_GAME) << __FILE__ << ":" << __LINE__ << ": "
+#define dbg(x) DebugLogLazy((DebugLevel)(x),D_GAME) << __FILE__ << ":" << __LINE__ << ": "
 
 const std::string obj_type_name[11]={ "OBJECT_NONE", "OBJECT_ITEM", "OBJECT_ACTOR", "OBJECT_PLAYER",
     "OBJECT_NPC", "OBJECT_MONSTER", "OBJECT_VEHICLE", "OBJECT_TRAP", "OBJECT_FIELD",
@@ -297,6 +298,7 @@ void Character::load(JsonObject &data)
     } else {
         data.read( "mutations", my_mutations );
     }
+    update_trait_bits();
     for( auto it = my_mutations.begin(); it != my_mutations.end(); ) {
         const auto &mid = it->first;
         if( mutation_branch::has( mid ) ) {
@@ -304,11 +306,13 @@ void Character::load(JsonObject &data)
             ++it;
         } else {
             debugmsg( "character %s has invalid mutation %s, it will be ignored", name.c_str(), mid.c_str() );
+            set_trait_bit( mid, false );
             my_mutations.erase( it++ );
         }
     }
 
     data.read( "my_bionics", my_bionics );
+    update_bionic_slots();
 
     for( auto &w : worn ) {
         w.on_takeoff( *this );
@@ -748,6 +752,7 @@ void player::deserialize(JsonIn &jsin)
     if ( !parray.empty() ) {
         std::string pstr = "";
         learned_recipes.clear();
+        recipe_changes++;
         while ( parray.has_more() ) {
             if ( parray.read_next(pstr) ) {
                 learned_recipes[ pstr ] = &recipe_dict[ pstr ];
@@ -1255,6 +1260,7 @@ void monster::load(JsonObject &data)
     // load->str->int
     data.read("typeid", sidtmp);
     type = &mtype_id( sidtmp ).obj();
+    ai = &MonsterGenerator::generator().get_ai( *type );
 
     data.read( "unique_name", unique_name );
     data.read("posx", position.x);
@@ -1990,13 +1996,11 @@ void Creature::store( JsonOut &jsout ) const
 
     // Because JSON requires string keys we need to convert our int keys
     std::unordered_map<std::string, std::unordered_map<std::string, effect>> tmp_map;
-    for (auto maps : effects) {
-        for (auto i : maps.second) {
-            std::ostringstream convert;
-            convert << i.first;
-            tmp_map[maps.first.str()][convert.str()] = i.second;
-        }
-    }
+    effects.for_each( [&tmp_map]( const effect & e ) {
+        std::ostringstream convert;
+        convert << e.get_bp();
+        tmp_map[e.get_id().str()][convert.str()] = e;
+    } );
     jsout.member( "effects", tmp_map );
 
 
@@ -2057,7 +2061,7 @@ void Creature::load( JsonObject &jsin )
                     const body_part bp = static_cast<body_part>( key_num );
                     effect &e = i.second;
 
-                    effects[id][bp] = e;
+                    effects.set( id, bp, e );
                     on_effect_int_change( id, e.get_intensity(), bp );
                 }
             }
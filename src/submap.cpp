@@ -13,7 +13,6 @@ submap::submap()
     std::uninitialized_fill_n( &frn[0][0], elements, f_null );
     std::uninitialized_fill_n( &lum[0][0], elements, 0 );
     std::uninitialized_fill_n( &trp[0][0], elements, tr_null );
-    std::uninitialized_fill_n( &rad[0][0], elements, 0 );
 
     is_uniform = false;
 }
@@ -31,17 +30,62 @@ void submap::delete_vehicles()
     vehicles.clear();
 }
 
+bool submap::is_blank_uniform() const
+{
+    if( field_count != 0 || !spawns.empty() || !vehicles.empty() || !active_items.empty() ||
+        !comp.name.empty() || camp.is_valid() ) {
+        return false;
+    }
+    if( !cosmetics.empty() ) {
+        return false;
+    }
+    const ter_id fill = ter[0][0];
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            if( ter[x][y] != fill || frn[x][y] != f_null || trp[x][y] != tr_null ||
+                lum[x][y] != 0 || get_radiation( x, y ) != 0 || !get_items( x, y ).empty() ||
+                get_field( x, y ).fieldCount() != 0 ) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 static const std::string COSMETICS_GRAFFITI( "GRAFFITI" );
 
+const std::map<std::string, std::string> &submap::get_cosmetics( const int x, const int y ) const
+{
+    const auto it = cosmetics.find( point( x, y ) );
+    if( it == cosmetics.end() ) {
+        static const std::map<std::string, std::string> no_cosmetics;
+        return no_cosmetics;
+    }
+    return it->second;
+}
+
+void submap::erase_cosmetic( const int x, const int y, const std::string &type )
+{
+    const auto it = cosmetics.find( point( x, y ) );
+    if( it == cosmetics.end() ) {
+        return;
+    }
+    it->second.erase( type );
+    if( it->second.empty() ) {
+        cosmetics.erase( it );
+    }
+}
+
 bool submap::has_graffiti( int x, int y ) const
 {
-    return cosmetics[x][y].count( COSMETICS_GRAFFITI ) > 0;
+    return get_cosmetics( x, y ).count( COSMETICS_GRAFFITI ) > 0;
 }
 
 const std::string &submap::get_graffiti( int x, int y ) const
 {
-    const auto it = cosmetics[x][y].find( COSMETICS_GRAFFITI );
-    if( it == cosmetics[x][y].end() ) {
+    const auto &cosm = get_cosmetics( x, y );
+    const auto it = cosm.find( COSMETICS_GRAFFITI );
+    if( it == cosm.end() ) {
         static const std::string empty_string;
         return empty_string;
     }
@@ -51,11 +95,11 @@ const std::string &submap::get_graffiti( int x, int y ) const
 void submap::set_graffiti( int x, int y, const std::string &new_graffiti )
 {
     is_uniform = false;
-    cosmetics[x][y][COSMETICS_GRAFFITI] = new_graffiti;
+    get_cosmetics( x, y )[COSMETICS_GRAFFITI] = new_graffiti;
 }
 
 void submap::delete_graffiti( int x, int y )
 {
     is_uniform = false;
-    cosmetics[x][y].erase( COSMETICS_GRAFFITI );
+    erase_cosmetic( x, y, COSMETICS_GRAFFITI );
 }
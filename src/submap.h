@@ -10,10 +10,13 @@
 #include "int_id.h"
 #include "string_id.h"
 #include "active_item_cache.h"
+#include "enums.h"
 
+#include <array>
 #include <vector>
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
 
 class map;
@@ -44,6 +47,39 @@ struct spawn_point {
              mission_id (MIS), friendly (F), name (N) {}
 };
 
+/**
+ * One value of T for each square of a submap. The values are only allocated once
+ * something asks for a writable one, until then all of them read as T().
+ * Once allocated they stay at their place until the layer is destroyed.
+ */
+template<typename T>
+class submap_layer
+{
+    public:
+        bool is_allocated() const {
+            return data != nullptr;
+        }
+
+        T &get( const int x, const int y ) {
+            if( !data ) {
+                data.reset( new block() );
+            }
+            return ( *data )[x][y];
+        }
+
+        const T &get( const int x, const int y ) const {
+            if( !data ) {
+                static const T empty{};
+                return empty;
+            }
+            return ( *data )[x][y];
+        }
+
+    private:
+        using block = std::array<std::array<T, SEEY>, SEEX>;
+        std::unique_ptr<block> data;
+};
+
 struct submap {
     trap_id get_trap( const int x, const int y ) const {
         return trp[x][y];
@@ -73,14 +109,38 @@ struct submap {
     }
 
     int get_radiation( const int x, const int y ) const {
-        return rad[x][y];
+        return rad.get( x, y );
     }
 
     void set_radiation( const int x, const int y, const int radiation ) {
         is_uniform = false;
-        rad[x][y] = radiation;
+        if( radiation != 0 || rad.is_allocated() ) {
+            rad.get( x, y ) = radiation;
+        }
+    }
+
+    item_list &get_items( const int x, const int y ) {
+        return itm.get( x, y );
     }
 
+    const item_list &get_items( const int x, const int y ) const {
+        return itm.get( x, y );
+    }
+
+    field &get_field( const int x, const int y ) {
+        return fld.get( x, y );
+    }
+
+    const field &get_field( const int x, const int y ) const {
+        return fld.get( x, y );
+    }
+
+    std::map<std::string, std::string> &get_cosmetics( const int x, const int y ) {
+        return cosmetics[point( x, y )];
+    }
+
+    const std::map<std::string, std::string> &get_cosmetics( const int x, const int y ) const;
+
     void update_lum_add( item const &i, int const x, int const y ) {
         is_uniform = false;
         if (i.is_emissive() && lum[x][y] < 255) {
@@ -100,7 +160,7 @@ struct submap {
         // Have to scan through all items to be sure removing i will actally lower
         // the count below 255.
         int count = 0;
-        for (auto const &it : itm[x][y]) {
+        for (auto const &it : itm.get( x, y )) {
             if (it.is_emissive()) {
                 count++;
             }
@@ -121,7 +181,7 @@ struct submap {
     // Its effect is meant to be cosmetic and atmospheric only.
     bool has_signage( const int x, const int y) const {
         if( frn[x][y] == furn_id( "f_sign" ) ) {
-            return cosmetics[x][y].find("SIGNAGE") != cosmetics[x][y].end();
+            return get_cosmetics( x, y ).count( "SIGNAGE" ) > 0;
         }
 
         return false;
@@ -129,8 +189,9 @@ struct submap {
     // Dependent on furniture + cosmetics.
     const std::string get_signage( const int x, const int y ) const {
         if( frn[x][y] == furn_id( "f_sign" ) ) {
-            auto iter = cosmetics[x][y].find("SIGNAGE");
-            if( iter != cosmetics[x][y].end() ) {
+            const auto &cosm = get_cosmetics( x, y );
+            auto iter = cosm.find("SIGNAGE");
+            if( iter != cosm.end() ) {
                 return iter->second;
             }
         }
@@ -140,28 +201,34 @@ struct submap {
     // Can be used anytime (prevents code from needing to place sign first.)
     void set_signage( const int x, const int y, std::string s) {
         is_uniform = false;
-        cosmetics[x][y]["SIGNAGE"] = s;
+        get_cosmetics( x, y )["SIGNAGE"] = s;
     }
     // Can be used anytime (prevents code from needing to place sign first.)
     void delete_signage( const int x, const int y) {
         is_uniform = false;
-        cosmetics[x][y].erase("SIGNAGE");
+        erase_cosmetic( x, y, "SIGNAGE" );
     }
+    /** Removes one entry of the cosmetics of the square, and the square's entry if it is empty then. */
+    void erase_cosmetic( int x, int y, const std::string &type );
 
     // TODO: make trp private once the horrible hack known as editmap is resolved
+    // What every scan of the map looks at is kept in tight arrays next to each other.
     ter_id          ter[SEEX][SEEY];  // Terrain on each square
     furn_id         frn[SEEX][SEEY];  // Furniture on each square
-    std::uint8_t    lum[SEEX][SEEY];  // Number of items emitting light on each square
-    std::list<item> itm[SEEX][SEEY];  // Items on each square
-    field           fld[SEEX][SEEY];  // Field on each square
     trap_id         trp[SEEX][SEEY];  // Trap on each square
-    int             rad[SEEX][SEEY];  // Irradiation of each square
+    std::uint8_t    lum[SEEX][SEEY];  // Number of items emitting light on each square
 
     // If is_uniform is true, this submap is a solid block of terrain
     // Uniform submaps aren't saved/loaded, because regenerating them is faster
     bool is_uniform;
 
-    std::map<std::string, std::string> cosmetics[SEEX][SEEY]; // Textual "visuals" for each square.
+    // Most submaps have no items, fields or radiation at all, those layers are allocated on
+    // demand, use the get_* functions above to access them.
+    submap_layer<item_list> itm; // Items on each square
+    submap_layer<field> fld;           // Field on each square
+    submap_layer<int> rad;             // Irradiation of each square
+    // Textual "visuals", only of the squares that have any.
+    std::map<point, std::map<std::string, std::string>> cosmetics;
 
     active_item_cache active_items;
 
@@ -183,6 +250,12 @@ struct submap {
     ~submap();
     // delete vehicles and clear the vehicles vector
     void delete_vehicles();
+    /**
+     * Whether this is a solid block of a single terrain with nothing else (no furniture,
+     * items, fields, traps, vehicles, ...) on it. Such a submap can be rebuilt from its
+     * terrain alone, see @ref mapbuffer.
+     */
+    bool is_blank_uniform() const;
 };
 
 /**
@@ -232,17 +305,20 @@ public:
 
     const field &get_field() const
     {
-        return sm->fld[x][y];
+        return static_cast<const submap *>( sm )->get_field( x, y );
     }
 
     field_entry* find_field( const field_id field_to_find )
     {
-        return sm->fld[x][y].findField( field_to_find );
+        if( !sm->fld.is_allocated() ) {
+            return nullptr;
+        }
+        return sm->get_field( x, y ).findField( field_to_find );
     }
 
     bool add_field( const field_id field_to_add, const int new_density, const int new_age )
     {
-        const bool ret = sm->fld[x][y].addField( field_to_add, new_density, new_age );
+        const bool ret = sm->get_field( x, y ).addField( field_to_add, new_density, new_age );
         if( ret ) {
             sm->field_count++;
         }
@@ -278,12 +354,12 @@ public:
     // For map::draw_maptile
     size_t get_item_count() const
     {
-        return sm->itm[x][y].size();
+        return static_cast<const submap *>( sm )->get_items( x, y ).size();
     }
 
     const item &get_uppermost_item() const
     {
-        return sm->itm[x][y].back();
+        return static_cast<const submap *>( sm )->get_items( x, y ).back();
     }
 };
 
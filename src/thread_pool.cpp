@@ -0,0 +1,145 @@
+#include "thread_pool.h"
+
+#include "debug.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+thread_local bool inside_parallel_for = false;
+
+/** Worker threads that sleep until @ref run hands them a job. */
+class thread_pool
+{
+    public:
+        thread_pool() {
+            const unsigned cores = std::max( 1u, std::thread::hardware_concurrency() );
+            for( unsigned i = 1; i < cores; i++ ) {
+                workers.emplace_back( [this]() {
+                    work();
+                } );
+            }
+        }
+        ~thread_pool() {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                stopping = true;
+            }
+            wake.notify_all();
+            for( std::thread &t : workers ) {
+                t.join();
+            }
+        }
+
+        size_t size() const {
+            return workers.size() + 1;
+        }
+
+        /** Runs the job on all threads, returns false without doing anything if the pool is busy. */
+        bool run( size_t count, const std::function<void( size_t )> &func ) {
+            std::unique_lock<std::mutex> busy( run_mutex, std::try_to_lock );
+            if( !busy.owns_lock() ) {
+                return false;
+            }
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                job = &func;
+                job_size = count;
+                next = 0;
+                pending = workers.size();
+                generation++;
+            }
+            wake.notify_all();
+            process();
+            std::unique_lock<std::mutex> lock( mutex );
+            done.wait( lock, [this]() {
+                return pending == 0;
+            } );
+            job = nullptr;
+            return true;
+        }
+
+    private:
+        std::vector<std::thread> workers;
+        /** Held while a job runs, so only one thread at a time hands out jobs. */
+        std::mutex run_mutex;
+        /** Guards everything below except @ref next. */
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        const std::function<void( size_t )> *job = nullptr;
+        size_t job_size = 0;
+        /** Workers that have not finished the current job yet. */
+        size_t pending = 0;
+        /** Counts jobs, so workers can tell a new job from a spurious wakeup. */
+        unsigned long generation = 0;
+        bool stopping = false;
+        /** Next index of the current job that nobody has taken yet. */
+        std::atomic<size_t> next{ 0 };
+
+        void process() {
+            for( size_t i = next++; i < job_size; i = next++ ) {
+                ( *job )( i );
+            }
+        }
+
+        void work() {
+            inside_parallel_for = true;
+            unsigned long seen = 0;
+            std::unique_lock<std::mutex> lock( mutex );
+            while( true ) {
+                wake.wait( lock, [this, &seen]() {
+                    return stopping || generation != seen;
+                } );
+                if( stopping ) {
+                    return;
+                }
+                seen = generation;
+                lock.unlock();
+                process();
+                lock.lock();
+                if( --pending == 0 ) {
+                    done.notify_one();
+                }
+            }
+        }
+};
+
+thread_pool &pool()
+{
+    static thread_pool instance;
+    return instance;
+}
+
+} // namespace
+
+void parallel_for( size_t count, const std::function<void( size_t )> &func )
+{
+    const bool was_inside = inside_parallel_for;
+    inside_parallel_for = true;
+    if( was_inside || count < 2 || pool().size() < 2 || !pool().run( count, func ) ) {
+        for( size_t i = 0; i < count; i++ ) {
+            func( i );
+        }
+    }
+    inside_parallel_for = was_inside;
+    if( !was_inside ) {
+        flush_deferred_debugmsgs();
+    }
+}
+
+size_t parallel_for_threads()
+{
+    return pool().size();
+}
+
+bool in_parallel_for()
+{
+    return inside_parallel_for;
+}
@@ -0,0 +1,27 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <cstddef>
+#include <functional>
+
+/**
+ * Calls func( i ) for every i in [0, count), spread over the calling thread and a pool
+ * of worker threads (one for each further core), and returns once all calls are done.
+ * The calls run in no particular order, so @p func may only read shared state and write
+ * to state of its own, like the i-th element of a result vector.
+ * The workers are started on first use and kept for later calls. If they are busy with
+ * a call from another thread (or this is called from within @p func), everything runs on
+ * the calling thread.
+ */
+void parallel_for( size_t count, const std::function<void( size_t )> &func );
+
+/** Number of threads @ref parallel_for spreads work over, including the calling thread. */
+size_t parallel_for_threads();
+
+/**
+ * Whether the calling thread is running the body of a @ref parallel_for. Lazily filled
+ * caches that other threads may read at the same time must not be written then.
+ */
+bool in_parallel_for();
+
+#endif
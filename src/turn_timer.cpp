@@ -0,0 +1,33 @@
+#include "turn_timer.h"
+
+bool turn_timer::enabled = false;
+
+turn_timer::turn_timer()
+{
+    if( enabled ) {
+        last = clock::now();
+    }
+}
+
+void turn_timer::lap( const char *phase )
+{
+    if( !enabled ) {
+        return;
+    }
+    const clock::time_point now = clock::now();
+    phase_stats &ps = stats()[phase];
+    ps.seconds += std::chrono::duration<double>( now - last ).count();
+    ps.calls++;
+    last = now;
+}
+
+std::map<std::string, turn_timer::phase_stats> &turn_timer::stats()
+{
+    static std::map<std::string, phase_stats> all_stats;
+    return all_stats;
+}
+
+void turn_timer::reset()
+{
+    stats().clear();
+}
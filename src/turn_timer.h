@@ -0,0 +1,41 @@
+#ifndef TURN_TIMER_H
+#define TURN_TIMER_H
+
+#include <chrono>
+#include <map>
+#include <string>
+
+/**
+ * Splits the wall-clock time of a single @ref game::do_turn into named phases.
+ *
+ * Timing is off by default, in which case @ref lap is a single branch. The
+ * benchmark harness switches it on and reads the accumulated @ref stats
+ * afterwards.
+ */
+class turn_timer
+{
+    public:
+        typedef std::chrono::steady_clock clock;
+
+        struct phase_stats {
+            /** Total time spent in this phase, in seconds. */
+            double seconds = 0.0;
+            /** Number of times the phase was entered. */
+            long calls = 0;
+        };
+
+        turn_timer();
+
+        /** Attributes the time since the previous lap (or construction) to @p phase. */
+        void lap( const char *phase );
+
+        static bool enabled;
+        /** Accumulated timings since the last @ref reset, keyed by phase name. */
+        static std::map<std::string, phase_stats> &stats();
+        static void reset();
+
+    private:
+        clock::time_point last;
+};
+
+#endif
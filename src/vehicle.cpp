@@ -103,7 +103,7 @@ bool vehicle_stack::empty() const
     return mystack->empty();
 }
 
-std::list<item>::iterator vehicle_stack::erase( std::list<item>::iterator it )
+item_list::iterator vehicle_stack::erase( item_list::iterator it )
 {
     return myorigin->remove_item(part_num, it);
 }
@@ -113,48 +113,48 @@ void vehicle_stack::push_back( const item &newitem )
     myorigin->add_item(part_num, newitem);
 }
 
-void vehicle_stack::insert_at( std::list<item>::iterator index,
+void vehicle_stack::insert_at( item_list::iterator index,
                                    const item &newitem )
 {
     myorigin->add_item_at(part_num, index, newitem);
 }
 
-std::list<item>::iterator vehicle_stack::begin()
+item_list::iterator vehicle_stack::begin()
 {
     return mystack->begin();
 }
 
-std::list<item>::iterator vehicle_stack::end()
+item_list::iterator vehicle_stack::end()
 {
     return mystack->end();
 }
 
-std::list<item>::const_iterator vehicle_stack::begin() const
+item_list::const_iterator vehicle_stack::begin() const
 {
     return mystack->cbegin();
 }
 
-std::list<item>::const_iterator vehicle_stack::end() const
+item_list::const_iterator vehicle_stack::end() const
 {
     return mystack->cend();
 }
 
-std::list<item>::reverse_iterator vehicle_stack::rbegin()
+item_list::reverse_iterator vehicle_stack::rbegin()
 {
     return mystack->rbegin();
 }
 
-std::list<item>::reverse_iterator vehicle_stack::rend()
+item_list::reverse_iterator vehicle_stack::rend()
 {
     return mystack->rend();
 }
 
-std::list<item>::const_reverse_iterator vehicle_stack::rbegin() const
+item_list::const_reverse_iterator vehicle_stack::rbegin() const
 {
     return mystack->crbegin();
 }
 
-std::list<item>::const_reverse_iterator vehicle_stack::rend() const
+item_list::const_reverse_iterator vehicle_stack::rend() const
 {
     return mystack->crend();
 }
@@ -2297,9 +2297,9 @@ int vehicle::next_part_to_open(int p, bool outside) const
 /**
  * Returns all parts in the vehicle with the given flag, optionally checking
  * to only return unbroken parts.
- * If performance becomes an issue, certain lists (such as wheels) could be
- * cached and fast-returned here, but this is currently linear-time with
- * respect to the number of parts in the vehicle.
+ * This is linear-time with respect to the number of parts in the vehicle,
+ * flags that have a vpart_bitflags value are looked up in the part index
+ * built by refresh() when passed as such.
  * @param feature The flag (such as "WHEEL" or "CONE_LIGHT") to find.
  * @param unbroken true if only unbroken parts should be returned, false to
  *        return all matching parts.
@@ -2319,11 +2319,17 @@ std::vector<int> vehicle::all_parts_with_feature(const std::string& feature, boo
 
 std::vector<int> vehicle::all_parts_with_feature(vpart_bitflags feature, bool const unbroken) const
 {
+    if( size_t( feature ) >= feature_parts.size() ) {
+        return std::vector<int>();
+    }
+    const std::vector<int> &with_feature = feature_parts[feature];
+    if( !unbroken ) {
+        return with_feature;
+    }
     std::vector<int> parts_found;
-    for( size_t part_index = 0; part_index < parts.size(); ++part_index ) {
-        if(part_info(part_index).has_flag(feature) &&
-                ( !unbroken || !parts[ part_index ].is_broken() ) ) {
-            parts_found.push_back(part_index);
+    for( const int part_index : with_feature ) {
+        if( !parts[ part_index ].is_broken() ) {
+            parts_found.push_back( part_index );
         }
     }
     return parts_found;
@@ -2337,13 +2343,11 @@ std::vector<int> vehicle::all_parts_with_feature(vpart_bitflags feature, bool co
  */
 std::vector<int> vehicle::all_parts_at_location(const std::string& location) const
 {
-    std::vector<int> parts_found;
-    for( size_t part_index = 0; part_index < parts.size(); ++part_index ) {
-        if(part_info(part_index).location == location && !parts[part_index].removed) {
-            parts_found.push_back(part_index);
-        }
+    const auto iter = location_parts.find( location );
+    if( iter == location_parts.end() ) {
+        return std::vector<int>();
     }
-    return parts_found;
+    return iter->second;
 }
 
 bool vehicle::part_flag (int part, const std::string &flag) const
@@ -2366,12 +2370,8 @@ bool vehicle::part_flag( int part, const vpart_bitflags flag) const
 
 int vehicle::part_at(int const dx, int const dy) const
 {
-    for (size_t p = 0; p < parts.size(); p++) {
-        if (parts[p].precalc[0].x == dx && parts[p].precalc[0].y == dy && !parts[p].removed) {
-            return (int)p;
-        }
-    }
-    return -1;
+    const auto iter = precalc_parts.find( point( dx, dy ) );
+    return iter != precalc_parts.end() ? iter->second : -1;
 }
 
 int vehicle::global_part_at(int const x, int const y) const
@@ -2772,6 +2772,20 @@ void vehicle::precalc_mounts (int idir, int dir, const point &pivot)
     }
     pivot_anchor[idir] = pivot;
     pivot_rotation[idir] = dir;
+    if( idir == 0 ) {
+        refresh_precalc_parts();
+    }
+}
+
+void vehicle::refresh_precalc_parts()
+{
+    precalc_parts.clear();
+    for( size_t p = 0; p < parts.size(); p++ ) {
+        if( !parts[p].removed ) {
+            // emplace keeps the lowest index, like the linear search in part_at did
+            precalc_parts.emplace( parts[p].precalc[0], p );
+        }
+    }
 }
 
 std::vector<int> vehicle::boarded_parts() const
@@ -3316,7 +3330,7 @@ float vehicle::k_traction( float wheel_traction_area ) const
     const float mass_penalty = ( 1.0f - wheel_traction_area / wheel_area( !floating.empty() ) ) * total_mass();
 
     float traction = std::min( 1.0f, wheel_traction_area / mass_penalty );
-    add_msg( m_debug, "%s has traction %.2f", name.c_str(), traction );
+    add_msg_debug( "%s has traction %.2f", name.c_str(), traction );
     // For now make it easy until it gets properly balanced: add a low cap of 0.1
     return std::max( 0.1f, traction );
 }
@@ -4325,7 +4339,7 @@ bool vehicle::collision( std::vector<veh_collision> &colls,
         colls.push_back( fake_coll );
         velocity = 0;
         vertical_velocity = 0;
-        add_msg( m_debug, "Collision check on a dirty vehicle %s", name.c_str() );
+        add_msg_debug( "Collision check on a dirty vehicle %s", name.c_str() );
         return true;
     }
 
@@ -4390,6 +4404,13 @@ veh_collision vehicle::part_collision( int part, const tripoint &p,
         return ret;
     }
 
+    // Most tiles hold nothing to hit, leave before looking up our own parts.
+    // The checks below would find nothing here either.
+    if( !is_body_collision && !bash_floor &&
+        !g->m.impassable_ter_furn( p ) && !g->m.is_bashable_ter_furn( p, false ) ) {
+        return ret;
+    }
+
     // Damage armor before damaging any other parts
     // Actually target, not just damage - spiked plating will "hit back", for example
     const int armor_part = part_with_feature( ret.part, VPFLAG_ARMOR );
@@ -4527,7 +4548,7 @@ veh_collision vehicle::part_collision( int part, const tripoint &p,
             continue;
         }
 
-        add_msg( m_debug, "Deformation energy: %.2f", d_E );
+        add_msg_debug( "Deformation energy: %.2f", d_E );
         // Damage calculation
         // Damage dealt overall
         dmg += d_E / 400;
@@ -4535,7 +4556,7 @@ veh_collision vehicle::part_collision( int part, const tripoint &p,
         // Always if no critters, otherwise if critter is real
         if( critter == nullptr || !critter->is_hallucination() ) {
             part_dmg = dmg * k / 100;
-            add_msg( m_debug, "Part collision damage: %.2f", part_dmg );
+            add_msg_debug( "Part collision damage: %.2f", part_dmg );
         }
         // Damage for object
         const float obj_dmg = dmg * (100-k)/100;
@@ -4592,7 +4613,7 @@ veh_collision vehicle::part_collision( int part, const tripoint &p,
                     critter->get_armor_bash( bp_torso );
                 dam = std::max( 0, dam - armor );
                 critter->apply_damage( driver, bp_torso, dam );
-                add_msg( m_debug, "Critter collision damage: %d", dam );
+                add_msg_debug( "Critter collision damage: %d", dam );
             }
 
             // Don't fling if vertical - critter got smashed into the ground
@@ -4859,7 +4880,7 @@ bool vehicle::add_item( vehicle_part &pt, const item &obj )
     return add_item( idx, obj );
 }
 
-bool vehicle::add_item_at(int part, std::list<item>::iterator index, item itm)
+bool vehicle::add_item_at(int part, item_list::iterator index, item itm)
 {
     if( itm.is_bucket_nonempty() ) {
         for( auto &elem : itm.contents ) {
@@ -4891,7 +4912,7 @@ bool vehicle::remove_item( int part, int itemdex )
 bool vehicle::remove_item( int part, const item *it )
 {
     bool rc = false;
-    std::list<item>& veh_items = parts[part].items;
+    item_list &veh_items = parts[part].items;
 
     for( auto iter = veh_items.begin(); iter != veh_items.end(); iter++ ) {
         //delete the item if the pointer memory addresses are the same
@@ -4904,9 +4925,9 @@ bool vehicle::remove_item( int part, const item *it )
     return rc;
 }
 
-std::list<item>::iterator vehicle::remove_item( int part, std::list<item>::iterator it )
+item_list::iterator vehicle::remove_item( int part, item_list::iterator it )
 {
-    std::list<item>& veh_items = parts[part].items;
+    item_list &veh_items = parts[part].items;
 
     if( active_items.has( it, parts[part].mount ) ) {
         active_items.remove( it, parts[part].mount );
@@ -5046,6 +5067,8 @@ void vehicle::refresh()
     solar_panels.clear();
     funnels.clear();
     relative_parts.clear();
+    feature_parts.assign( NUM_VPFLAGS, std::vector<int>() );
+    location_parts.clear();
     loose_parts.clear();
     wheelcache.clear();
     steering.clear();
@@ -5120,6 +5143,12 @@ void vehicle::refresh()
                 extra_drag += vpi.power;
             }
         }
+        for( size_t f = 0; f < feature_parts.size(); f++ ) {
+            if( vpi.has_flag( vpart_bitflags( f ) ) ) {
+                feature_parts[f].push_back( p );
+            }
+        }
+        location_parts[vpi.location].push_back( p );
         // Build map of point -> all parts in that point
         const point pt = parts[p].mount;
         // This will keep the parts at point pt sorted
@@ -5975,7 +6004,7 @@ void vehicle::update_time( const calendar &update_to )
         const int rain_val = divide_roll_remainder( rain_amount, 1.0 );
         if( rain_val > 0 ) {
             refill( "water", rain_val );
-            add_msg( m_debug, "%s got %d water from funnels", name.c_str(), rain_val );
+            add_msg_debug( "%s got %d water from funnels", name.c_str(), rain_val );
         }
     }
 
@@ -5995,7 +6024,7 @@ void vehicle::update_time( const calendar &update_to )
         }
 
         if( epower > 0 ) {
-            add_msg( m_debug, "%s got %d epower from solars", name.c_str(), epower );
+            add_msg_debug( "%s got %d epower from solars", name.c_str(), epower );
             charge_battery( epower_to_power( epower ) );
         }
     }
@@ -19,6 +19,7 @@
 #include <map>
 #include <list>
 #include <string>
+#include <unordered_map>
 #include <iosfwd>
 
 class map;
@@ -76,26 +77,26 @@ struct veh_collision {
 
 class vehicle_stack : public item_stack {
 private:
-    std::list<item> *mystack;
+    item_list *mystack;
     point location;
     vehicle *myorigin;
     int part_num;
 public:
-vehicle_stack( std::list<item> *newstack, point newloc, vehicle *neworigin, int part ) :
+vehicle_stack( item_list *newstack, point newloc, vehicle *neworigin, int part ) :
     mystack(newstack), location(newloc), myorigin(neworigin), part_num(part) {};
     size_t size() const override;
     bool empty() const override;
-    std::list<item>::iterator erase( std::list<item>::iterator it ) override;
+    item_list::iterator erase( item_list::iterator it ) override;
     void push_back( const item &newitem ) override;
-    void insert_at( std::list<item>::iterator index, const item &newitem ) override;
-    std::list<item>::iterator begin();
-    std::list<item>::iterator end();
-    std::list<item>::const_iterator begin() const;
-    std::list<item>::const_iterator end() const;
-    std::list<item>::reverse_iterator rbegin();
-    std::list<item>::reverse_iterator rend();
-    std::list<item>::const_reverse_iterator rbegin() const;
-    std::list<item>::const_reverse_iterator rend() const;
+    void insert_at( item_list::iterator index, const item &newitem ) override;
+    item_list::iterator begin();
+    item_list::iterator end();
+    item_list::const_iterator begin() const;
+    item_list::const_iterator end() const;
+    item_list::reverse_iterator rbegin();
+    item_list::reverse_iterator rend();
+    item_list::const_reverse_iterator rbegin() const;
+    item_list::const_reverse_iterator rend() const;
     item &front() override;
     item &operator[]( size_t index ) override;
 };
@@ -233,7 +234,7 @@ public:
 private:
     vpart_id id;         // id in map of parts (vehicle_part_types key)
     item base;
-    std::list<item> items; // inventory
+    item_list items; // inventory
 
 public:
     const vpart_str_id &get_id() const;
@@ -703,6 +704,8 @@ public:
 
     // Precalculate mount points for (idir=0) - current direction or (idir=1) - next turn direction
     void precalc_mounts (int idir, int dir, const point &pivot);
+    // Rebuild the part_at index after precalc[0] of the parts has changed
+    void refresh_precalc_parts();
 
     // get a list of part indeces where is a passenger inside
     std::vector<int> boarded_parts() const;
@@ -940,12 +943,12 @@ public:
 
     // Position specific item insertion that skips a bunch of safety checks
     // since it should only ever be used by item processing code.
-    bool add_item_at( int part, std::list<item>::iterator index, item itm );
+    bool add_item_at( int part, item_list::iterator index, item itm );
 
     // remove item from part's cargo
     bool remove_item( int part, int itemdex );
     bool remove_item( int part, const item *it );
-    std::list<item>::iterator remove_item (int part, std::list<item>::iterator it);
+    item_list::iterator remove_item (int part, item_list::iterator it);
 
     vehicle_stack get_items( int part ) const;
     vehicle_stack get_items( int part );
@@ -1098,6 +1101,9 @@ public:
     std::vector<vehicle_part> parts;   // Parts which occupy different tiles
     int removed_part_count;            // Subtract from parts.size() to get the real part count.
     std::map<point, std::vector<int> > relative_parts;    // parts_at_relative(x,y) is used alot (to put it mildly)
+    std::unordered_map<point, int> precalc_parts;         // part_at(x,y), first part at each precalc[0] point
+    std::vector<std::vector<int>> feature_parts;          // parts with each vpart_bitflags, see all_parts_with_feature
+    std::map<std::string, std::vector<int>> location_parts; // all_parts_at_location(location)
     std::set<label> labels;            // stores labels
     std::vector<int> alternators;      // List of alternator indices
     std::vector<int> fuel;             // List of fuel tank indices
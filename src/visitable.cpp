@@ -13,12 +13,13 @@
 #include "game.h"
 #include "itype.h"
 #include "player.h"
+#include "visitable_inline.h"
 
 template <typename T>
 item *visitable<T>::find_parent( const item &it )
 {
     item *res = nullptr;
-    if( visit_items( [&]( item * node, item * parent ) {
+    if( visit_inline( [&]( item * node, item * parent ) {
     if( node == &it ) {
             res = parent;
             return VisitResponse::ABORT;
@@ -59,7 +60,7 @@ std::vector<const item *> visitable<T>::parents( const item &it ) const
 template <typename T>
 bool visitable<T>::has_item( const item &it ) const
 {
-    return visit_items( [&it]( const item * node ) {
+    return visit_inline( [&it]( const item * node ) {
         return node == &it ? VisitResponse::ABORT : VisitResponse::NEXT;
     } ) == VisitResponse::ABORT;
 }
@@ -67,7 +68,7 @@ bool visitable<T>::has_item( const item &it ) const
 template <typename T>
 bool visitable<T>::has_item_with( const std::function<bool( const item & )> &filter ) const
 {
-    return visit_items( [&filter]( const item * node ) {
+    return visit_inline( [&filter]( const item * node ) {
         return filter( *node ) ? VisitResponse::ABORT : VisitResponse::NEXT;
     } ) == VisitResponse::ABORT;
 }
@@ -77,7 +78,7 @@ static int has_quality_internal( const T& self, const quality_id &qual, int leve
 {
     int qty = 0;
 
-    self.visit_items( [&qual, level, &limit, &qty]( const item *e ) {
+    self.visit_inline( [&qual, level, &limit, &qty]( const item *e ) {
         if( e->get_quality( qual ) >= level ) {
             qty += e->count_by_charges() ? e->charges : 1;
             if( qty >= limit ) {
@@ -118,6 +119,16 @@ bool visitable<T>::has_quality( const quality_id &qual, int level, int qty ) con
     return has_quality_internal( *this, qual, level, qty ) == qty;
 }
 
+template <>
+bool visitable<inventory>::has_quality( const quality_id &qual, int level, int qty ) const
+{
+    const inventory_index *index = static_cast<const inventory *>( this )->get_index();
+    if( index != nullptr ) {
+        return index->has_quality( qual, level, qty );
+    }
+    return has_quality_internal( *this, qual, level, qty ) == qty;
+}
+
 template <>
 bool visitable<vehicle_selector>::has_quality( const quality_id &qual, int level, int qty ) const
 {
@@ -161,7 +172,7 @@ template <typename T>
 static int max_quality_internal( const T& self, const quality_id &qual )
 {
     int res = INT_MIN;
-    self.visit_items( [&res,&qual]( const item *e ) {
+    self.visit_inline( [&res,&qual]( const item *e ) {
         res = std::max( res, e->get_quality( qual ) );
         return VisitResponse::NEXT;
     } );
@@ -242,7 +253,7 @@ template <typename T>
 std::vector<item *> visitable<T>::items_with( const std::function<bool( const item & )> &filter )
 {
     std::vector<item *> res;
-    visit_items( [&res,&filter]( item * node, item * ) {
+    visit_inline( [&res,&filter]( item * node ) {
         if( filter( *node ) ) {
             res.push_back( node );
         }
@@ -255,7 +266,7 @@ template <typename T>
 std::vector<const item *> visitable<T>::items_with( const std::function<bool( const item & )> &filter ) const
 {
     std::vector<const item *> res;
-    visit_items( [&res,&filter]( const item * node, const item * ) {
+    visit_inline( [&res,&filter]( const item * node ) {
         if( filter( *node ) ) {
             res.push_back( node );
         }
@@ -268,152 +279,26 @@ template <typename T>
 VisitResponse visitable<T>::visit_items(
     const std::function<VisitResponse( const item *, const item * )> &func ) const
 {
-    return const_cast<visitable<T> *>( this )->visit_items(
-               static_cast<const std::function<VisitResponse( item *, item * )>&>( func ) );
+    return visit_inline( func );
 }
 
 template <typename T>
 VisitResponse visitable<T>::visit_items( const std::function<VisitResponse( const item * )> &func ) const
 {
-    return const_cast<visitable<T> *>( this )->visit_items(
-               static_cast<const std::function<VisitResponse( item * )>&>( func ) );
+    return visit_inline( func );
 }
 
 template <typename T>
 VisitResponse visitable<T>::visit_items( const std::function<VisitResponse( item * )> &func )
 {
-    return visit_items( [&func]( item * it, item * ) {
-        return func( it );
-    } );
-}
-
-// Specialize visitable<T>::visit_items() for each class that will implement the visitable interface
-
-static VisitResponse visit_internal( const std::function<VisitResponse( item *, item * )> &func,
-                                     item *node, item *parent = nullptr )
-{
-    switch( func( node, parent ) ) {
-        case VisitResponse::ABORT:
-            return VisitResponse::ABORT;
-
-        case VisitResponse::NEXT:
-            if( node->is_gun() || node->is_magazine() || node->is_non_resealable_container() ) {
-                // Content of guns and magazines are accessible only via their specific accessors
-                // Accessing content of nonsealable container requires altering it (unsealing).
-                return VisitResponse::NEXT;
-            }
-
-            for( auto &e : node->contents ) {
-                if( visit_internal( func, &e, node ) == VisitResponse::ABORT ) {
-                    return VisitResponse::ABORT;
-                }
-            }
-        /* intentional fallthrough */
-
-        case VisitResponse::SKIP:
-            return VisitResponse::NEXT;
-    }
-
-    /* never reached but suppresses GCC warning */
-    return VisitResponse::ABORT;
+    return visit_inline( func );
 }
 
-template <>
-VisitResponse visitable<item>::visit_items(
-    const std::function<VisitResponse( item *, item * )> &func )
-{
-    auto it = static_cast<item *>( this );
-    return visit_internal( func, it );
-}
-
-template <>
-VisitResponse visitable<inventory>::visit_items(
-    const std::function<VisitResponse( item *, item * )> &func )
-{
-    auto inv = static_cast<inventory *>( this );
-    for( auto &stack : inv->items ) {
-        for( auto &it : stack ) {
-            if( visit_internal( func, &it ) == VisitResponse::ABORT ) {
-                return VisitResponse::ABORT;
-            }
-        }
-    }
-    return VisitResponse::NEXT;
-}
-
-template <>
-VisitResponse visitable<Character>::visit_items(
-    const std::function<VisitResponse( item *, item * )> &func )
-{
-    auto ch = static_cast<Character *>( this );
-
-    if( !ch->weapon.is_null() &&
-        visit_internal( func, &ch->weapon ) == VisitResponse::ABORT ) {
-        return VisitResponse::ABORT;
-    }
-
-    for( auto &e : ch->worn ) {
-        if( visit_internal( func, &e ) == VisitResponse::ABORT ) {
-            return VisitResponse::ABORT;
-        }
-    }
-
-    return ch->inv.visit_items( func );
-}
-
-template <>
-VisitResponse visitable<map_cursor>::visit_items(
-    const std::function<VisitResponse( item *, item * )> &func )
-{
-    auto cur = static_cast<map_cursor *>( this );
-
-    for( auto &e : g->m.i_at( *cur ) ) {
-        if( visit_internal( func, &e ) == VisitResponse::ABORT ) {
-            return VisitResponse::ABORT;
-        }
-    }
-    return VisitResponse::NEXT;
-}
-
-template <>
-VisitResponse visitable<map_selector>::visit_items(
-    const std::function<VisitResponse( item *, item * )> &func )
-{
-    for( auto &cursor : static_cast<map_selector &>( *this ) ) {
-        if( cursor.visit_items( func ) == VisitResponse::ABORT ) {
-            return VisitResponse::ABORT;
-        }
-    }
-    return VisitResponse::NEXT;
-}
-
-template <>
-VisitResponse visitable<vehicle_cursor>::visit_items(
-    const std::function<VisitResponse( item *, item * )> &func )
-{
-    auto self = static_cast<vehicle_cursor *>( this );
-
-    int idx = self->veh.part_with_feature( self->part, "CARGO" );
-    if( idx >= 0 ) {
-        for( auto &e : self->veh.get_items( idx ) ) {
-            if( visit_internal( func, &e ) == VisitResponse::ABORT ) {
-                return VisitResponse::ABORT;
-            }
-        }
-    }
-    return VisitResponse::NEXT;
-}
-
-template <>
-VisitResponse visitable<vehicle_selector>::visit_items(
+template <typename T>
+VisitResponse visitable<T>::visit_items(
     const std::function<VisitResponse( item *, item * )> &func )
 {
-    for( auto &cursor : static_cast<vehicle_selector &>( *this ) ) {
-        if( cursor.visit_items( func ) == VisitResponse::ABORT ) {
-            return VisitResponse::ABORT;
-        }
-    }
-    return VisitResponse::NEXT;
+    return visit_inline( func );
 }
 
 // Specialize visitable<T>::remove_items_with() for each class that will implement the visitable interface
@@ -430,8 +315,8 @@ item visitable<T>::remove_item( item& it ) {
     }
 }
 
-static void remove_internal( const std::function<bool( item & )> &filter, item &node, int &count,
-                             std::list<item> &res )
+template <typename Filter>
+static void remove_internal( const Filter &filter, item &node, int &count, std::list<item> &res )
 {
     for( auto it = node.contents.begin(); it != node.contents.end(); ) {
         if( filter( *it ) ) {
@@ -467,6 +352,7 @@ std::list<item> visitable<inventory>::remove_items_with( const
         std::function<bool( const item &e )> &filter, int count )
 {
     auto inv = static_cast<inventory *>( this );
+    inv->index.reset();
     std::list<item> res;
 
     if( count <= 0 ) {
@@ -565,12 +451,16 @@ std::list<item> visitable<map_cursor>::remove_items_with( const
         debugmsg( "cannot remove items from map: cursor out-of-bounds" );
         return res;
     }
+    if( !g->m.has_items( *cur ) ) {
+        return res;
+    }
 
     // fetch the appropriate item stack
     int x, y;
     submap *sub = g->m.get_submap_at( *cur, x, y );
 
-    for( auto iter = sub->itm[ x ][ y ].begin(); iter != sub->itm[ x ][ y ].end(); ) {
+    auto &items = sub->get_items( x, y );
+    for( auto iter = items.begin(); iter != items.end(); ) {
         if( filter( *iter ) ) {
             // check for presence in the active items cache
             if( sub->active_items.has( iter, point( x, y ) ) ) {
@@ -581,7 +471,8 @@ std::list<item> visitable<map_cursor>::remove_items_with( const
             sub->update_lum_rem( *iter, x, y );
 
             // finally remove the item
-            res.splice( res.end(), sub->itm[ x ][ y ], iter++ );
+            res.push_back( std::move( *iter ) );
+            iter = items.erase( iter );
 
             if( --count == 0 ) {
                 return res;
@@ -635,7 +526,8 @@ std::list<item> visitable<vehicle_cursor>::remove_items_with( const
             if( cur->veh.active_items.has( iter, part.mount ) ) {
                 cur->veh.active_items.remove( iter, part.mount );
             }
-            res.splice( res.end(), part.items, iter++ );
+            res.push_back( std::move( *iter ) );
+            iter = part.items.erase( iter );
             if( --count == 0 ) {
                 return res;
             }
@@ -676,7 +568,7 @@ static long charges_of_internal( const T& self, const itype_id& id, int limit )
 {
     long qty = 0;
 
-    self.visit_items( [&]( const item *e ) {
+    self.visit_inline( [&]( const item *e ) {
         if( e->is_tool() ) {
             // for tools we also need to check if this item is a subtype of the required id
             if( e->typeId() == id || ( e->is_tool() && e->type->tool->subtype == id ) ) {
@@ -736,7 +628,7 @@ template <typename T>
 static int amount_of_internal( const T& self, const itype_id& id, bool pseudo, int limit )
 {
     int qty = 0;
-    self.visit_items( [&qty, &id, &pseudo, &limit] ( const item *e ) {
+    self.visit_inline( [&qty, &id, &pseudo, &limit] ( const item *e ) {
         qty += ( e->typeId() == id && e->allow_crafting_component() && ( pseudo || !e->has_flag( "PSEUDO" ) ) );
         return qty != limit ? VisitResponse::NEXT : VisitResponse::ABORT;
     } );
@@ -760,7 +652,7 @@ int visitable<Character>::amount_of( const std::string& what, bool pseudo, int l
 
     if( what == "apparatus" && pseudo ) {
         int qty = 0;
-        visit_items( [&qty, &limit] ( const item *e ) {
+        visit_inline( [&qty, &limit] ( const item *e ) {
             qty += e->get_quality( quality_id( "SMOKE_PIPE" ) ) >= 1;
             return qty < limit ? VisitResponse::SKIP : VisitResponse::ABORT;
         } );
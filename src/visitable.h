@@ -42,6 +42,16 @@ class visitable
         VisitResponse visit_items( const std::function<VisitResponse( item * )> &func );
         VisitResponse visit_items( const std::function<VisitResponse( const item * )> &func ) const;
 
+        /**
+         * Same as @ref visit_items, but the visitor (taking either the node and its parent
+         * or only the node) is a template parameter and is called directly, so it can be
+         * inlined. Prefer this for searches that run often, it is defined in visitable_inline.h.
+         */
+        template<typename Func>
+        VisitResponse visit_inline( Func &&func );
+        template<typename Func>
+        VisitResponse visit_inline( Func &&func ) const;
+
         /**
          * Determine the immediate parent container (if any) for an item.
          * @param it item to search for which must be contained (at any depth) by this object
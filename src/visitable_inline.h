@@ -0,0 +1,172 @@
+#ifndef VISITABLE_INLINE_H
+#define VISITABLE_INLINE_H
+
+#include "character.h"
+#include "game.h"
+#include "inventory.h"
+#include "item.h"
+#include "map.h"
+#include "map_selector.h"
+#include "vehicle.h"
+#include "vehicle_selector.h"
+#include "visitable.h"
+
+#include <utility>
+
+/**
+ * The traversal behind @ref visitable::visit_items and @ref visitable::visit_inline.
+ * Everything is templated on the visitor, which is therefore called directly and can
+ * be inlined, unlike a std::function that costs an indirect call per visited item.
+ * Only include this where the traversal is needed, it pulls in the headers of all
+ * visitable types.
+ */
+struct item_visitor {
+    /** Calls a visitor that takes the node and its parent... */
+    template<typename Func>
+    static auto call( Func &func, item *node, item *parent, int ) -> decltype( func( node,
+            parent ) ) {
+        return func( node, parent );
+    }
+    /** ...or only the node. */
+    template<typename Func>
+    static auto call( Func &func, item *node, item *, long ) -> decltype( func( node ) ) {
+        return func( node );
+    }
+
+    /** Visits @p node and, if the visitor asks for it, everything it contains. */
+    template<typename Func>
+    static VisitResponse visit( Func &func, item *node, item *parent = nullptr ) {
+        switch( call( func, node, parent, 0 ) ) {
+            case VisitResponse::ABORT:
+                return VisitResponse::ABORT;
+
+            case VisitResponse::NEXT:
+                if( node->is_gun() || node->is_magazine() || node->is_non_resealable_container() ) {
+                    // Content of guns and magazines are accessible only via their specific accessors
+                    // Accessing content of nonsealable container requires altering it (unsealing).
+                    return VisitResponse::NEXT;
+                }
+
+                for( auto &e : node->contents ) {
+                    if( visit( func, &e, node ) == VisitResponse::ABORT ) {
+                        return VisitResponse::ABORT;
+                    }
+                }
+            /* intentional fallthrough */
+
+            case VisitResponse::SKIP:
+                return VisitResponse::NEXT;
+        }
+
+        /* never reached but suppresses GCC warning */
+        return VisitResponse::ABORT;
+    }
+
+    /** Visits each item of @p items, which can be any range of items. */
+    template<typename Func, typename Items>
+    static VisitResponse visit_range( Func &func, Items &&items ) {
+        for( auto &e : items ) {
+            if( visit( func, &e ) == VisitResponse::ABORT ) {
+                return VisitResponse::ABORT;
+            }
+        }
+        return VisitResponse::NEXT;
+    }
+
+    /** Called before the visitor gets non-const access to the items of @p obj. */
+    template<typename T>
+    static void on_mutable_visit( T & ) {}
+
+    /** The visitor may change the items, which the index would not notice. */
+    static void on_mutable_visit( inventory &inv ) {
+        inv.index.reset();
+    }
+
+    static void on_mutable_visit( Character &ch ) {
+        on_mutable_visit( ch.inv );
+    }
+
+    // One overload for each class that implements the visitable interface
+
+    template<typename Func>
+    static VisitResponse visit_roots( Func &func, item &it ) {
+        return visit( func, &it );
+    }
+
+    template<typename Func>
+    static VisitResponse visit_roots( Func &func, inventory &inv ) {
+        for( auto &stack : inv.items ) {
+            if( visit_range( func, stack ) == VisitResponse::ABORT ) {
+                return VisitResponse::ABORT;
+            }
+        }
+        return VisitResponse::NEXT;
+    }
+
+    template<typename Func>
+    static VisitResponse visit_roots( Func &func, Character &ch ) {
+        if( !ch.weapon.is_null() && visit( func, &ch.weapon ) == VisitResponse::ABORT ) {
+            return VisitResponse::ABORT;
+        }
+        if( visit_range( func, ch.worn ) == VisitResponse::ABORT ) {
+            return VisitResponse::ABORT;
+        }
+        return visit_roots( func, ch.inv );
+    }
+
+    template<typename Func>
+    static VisitResponse visit_roots( Func &func, map_cursor &cur ) {
+        // Don't allocate the item layer of submaps just to find out they have no items
+        if( !g->m.has_items( cur ) ) {
+            return VisitResponse::NEXT;
+        }
+        return visit_range( func, g->m.i_at( cur ) );
+    }
+
+    template<typename Func>
+    static VisitResponse visit_roots( Func &func, map_selector &sel ) {
+        for( auto &cursor : sel ) {
+            if( visit_roots( func, cursor ) == VisitResponse::ABORT ) {
+                return VisitResponse::ABORT;
+            }
+        }
+        return VisitResponse::NEXT;
+    }
+
+    template<typename Func>
+    static VisitResponse visit_roots( Func &func, vehicle_cursor &cur ) {
+        const int idx = cur.veh.part_with_feature( cur.part, "CARGO" );
+        if( idx < 0 ) {
+            return VisitResponse::NEXT;
+        }
+        return visit_range( func, cur.veh.get_items( idx ) );
+    }
+
+    template<typename Func>
+    static VisitResponse visit_roots( Func &func, vehicle_selector &sel ) {
+        for( auto &cursor : sel ) {
+            if( visit_roots( func, cursor ) == VisitResponse::ABORT ) {
+                return VisitResponse::ABORT;
+            }
+        }
+        return VisitResponse::NEXT;
+    }
+};
+
+template <typename T>
+template <typename Func>
+VisitResponse visitable<T>::visit_inline( Func &&func )
+{
+    item_visitor::on_mutable_visit( static_cast<T &>( *this ) );
+    return item_visitor::visit_roots( func, static_cast<T &>( *this ) );
+}
+
+template <typename T>
+template <typename Func>
+VisitResponse visitable<T>::visit_inline( Func &&func ) const
+{
+    // The traversal is shared, but this visitor only gets const access to the items.
+    return item_visitor::visit_roots( func, const_cast<T &>( static_cast<const T &>( *this ) ) );
+}
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Minimal registry for the cata_bench harness.
+ *
+ * Each benchmark registers itself through a static @ref bench_registrar
+ * and is run by name (or all of them when no name is given) from
+ * bench_main.cpp after the game data has been loaded.
+ */
+struct bench_options {
+    /** Number of game turns (or iterations) each benchmark should run. */
+    int turns = 1000;
+    /** Seed string, hashed the same way as the game's --seed argument. */
+    std::string seed = "cata_bench";
+    /** Names of the benchmarks to run, empty means all of them. */
+    std::vector<std::string> filter;
+};
+
+struct bench_case {
+    std::string name;
+    std::string description;
+    std::function<void( const bench_options & )> run;
+};
+
+std::vector<bench_case> &all_benchmarks();
+
+struct bench_registrar {
+    bench_registrar( const std::string &name, const std::string &description,
+                     std::function<void( const bench_options & )> run ) {
+        all_benchmarks().push_back( bench_case{ name, description, run } );
+    }
+};
+
+/** Reseeds the global RNG from @ref bench_options::seed. */
+void bench_reseed( const bench_options &opts );
+
+/** Peak resident set size of the process in kilobytes, 0 where unsupported. */
+long bench_peak_rss_kb();
+
+#endif
@@ -0,0 +1,173 @@
+#include "bench.h"
+
+#include "game.h"
+#include "filesystem.h"
+#include "map.h"
+#include "options.h"
+#include "path_info.h"
+#include "player.h"
+#include "rng.h"
+#include "worldfactory.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+#if !(defined _WIN32 || defined WINDOWS)
+#include <sys/resource.h>
+#endif
+
+std::vector<bench_case> &all_benchmarks()
+{
+    static std::vector<bench_case> benchmarks;
+    return benchmarks;
+}
+
+void bench_reseed( const bench_options &opts )
+{
+    srand( djb2_hash( reinterpret_cast<const unsigned char *>( opts.seed.c_str() ) ) );
+}
+
+long bench_peak_rss_kb()
+{
+#if !(defined _WIN32 || defined WINDOWS)
+    struct rusage usage;
+    if( getrusage( RUSAGE_SELF, &usage ) == 0 ) {
+        // Linux reports kilobytes, OS X reports bytes.
+#ifdef __APPLE__
+        return usage.ru_maxrss / 1024;
+#else
+        return usage.ru_maxrss;
+#endif
+    }
+#endif
+    return 0;
+}
+
+static std::vector<std::string> split_mods( const std::string &mod_string )
+{
+    std::vector<std::string> ret;
+    size_t start = 0;
+    while( start < mod_string.size() ) {
+        size_t end = mod_string.find( ',', start );
+        if( end == std::string::npos ) {
+            end = mod_string.size();
+        }
+        if( end > start ) {
+            ret.push_back( mod_string.substr( start, end - start ) );
+        }
+        start = end + 1;
+    }
+    return ret;
+}
+
+static void init_bench_game_state( const std::vector<std::string> &mods )
+{
+    PATH_INFO::init_base_path( "" );
+    PATH_INFO::init_user_dir( "./" );
+    PATH_INFO::set_standard_filenames();
+
+    if( !assure_dir_exist( FILENAMES["config_dir"] ) ||
+        !assure_dir_exist( FILENAMES["savedir"] ) ||
+        !assure_dir_exist( FILENAMES["templatedir"] ) ) {
+        throw std::runtime_error( "Unable to create user directories. Check permissions." );
+    }
+
+    get_options().init();
+    get_options().load();
+    init_colors();
+
+    g = new game;
+    g->load_static_data();
+
+    world_generator->set_active_world( NULL );
+    world_generator->get_all_worlds();
+    WORLDPTR bench_world = world_generator->make_new_world( mods );
+    if( bench_world == NULL ) {
+        throw std::runtime_error( "Unable to create the benchmark world." );
+    }
+    world_generator->set_active_world( bench_world );
+
+    g->load_core_data();
+    g->load_world_modfiles( world_generator->active_world );
+
+    g->u = player();
+    g->u.create( PLTYPE_NOW );
+
+    g->m = map( get_world_option<bool>( "ZLEVELS" ) );
+    g->m.load( g->get_levx(), g->get_levy(), g->get_levz(), false );
+}
+
+static void print_usage( const char *exe )
+{
+    printf( "Usage: %s [--turns=N] [--seed=STRING] [--mods=a,b,...] [--list] [benchmark...]\n",
+            exe );
+}
+
+int main( int argc, const char *argv[] )
+{
+    bench_options opts;
+    std::vector<std::string> mods;
+    bool list_only = false;
+
+    for( int i = 1; i < argc; ++i ) {
+        const std::string arg = argv[i];
+        if( arg.compare( 0, 8, "--turns=" ) == 0 ) {
+            opts.turns = std::max( 1, atoi( arg.c_str() + 8 ) );
+        } else if( arg.compare( 0, 7, "--seed=" ) == 0 ) {
+            opts.seed = arg.substr( 7 );
+        } else if( arg.compare( 0, 7, "--mods=" ) == 0 ) {
+            mods = split_mods( arg.substr( 7 ) );
+        } else if( arg == "--list" ) {
+            list_only = true;
+        } else if( arg == "--help" || arg == "-h" ) {
+            print_usage( argv[0] );
+            return EXIT_SUCCESS;
+        } else if( !arg.empty() && arg[0] != '-' ) {
+            opts.filter.push_back( arg );
+        } else {
+            print_usage( argv[0] );
+            return EXIT_FAILURE;
+        }
+    }
+
+    if( list_only ) {
+        for( const bench_case &bc : all_benchmarks() ) {
+            printf( "%-20s %s\n", bc.name.c_str(), bc.description.c_str() );
+        }
+        return EXIT_SUCCESS;
+    }
+
+    test_mode = true;
+    // World generation happens on demand, seed before any of it runs.
+    bench_reseed( opts );
+
+    try {
+        init_bench_game_state( mods );
+    } catch( const std::exception &err ) {
+        fprintf( stderr, "Terminated: %s\n", err.what() );
+        fprintf( stderr, "Make sure that you're in the correct working directory and your data isn't corrupted.\n" );
+        return EXIT_FAILURE;
+    }
+
+    int ran = 0;
+    for( const bench_case &bc : all_benchmarks() ) {
+        if( !opts.filter.empty() &&
+            std::find( opts.filter.begin(), opts.filter.end(), bc.name ) == opts.filter.end() ) {
+            continue;
+        }
+        printf( "== %s: %s\n", bc.name.c_str(), bc.description.c_str() );
+        fflush( stdout );
+        bc.run( opts );
+        ran++;
+    }
+
+    g->delete_world( world_generator->active_world->world_name, true );
+
+    if( ran == 0 ) {
+        fprintf( stderr, "No benchmark matched, use --list to see the available ones.\n" );
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,76 @@
+#include "bench.h"
+
+#include "calendar.h"
+#include "game.h"
+#include "map.h"
+#include "omdata.h"
+#include "overmapbuffer.h"
+#include "player.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct mapgen_stats {
+    double seconds = 0;
+    int calls = 0;
+};
+
+/** Overmap terrains in each row of the area the benchmark generates in. */
+const int bench_row_length = 64;
+
+/**
+ * Generates every overmap terrain type in turn, each at its own spot outside of the
+ * reality bubble, the way the game generates new areas. One turn is one mapgen call.
+ * The generated submaps stay in the map buffer, so they count towards the peak RSS.
+ */
+void run_mapgen_bench( const bench_options &opts )
+{
+    bench_reseed( opts );
+    const tripoint origin = g->u.global_omt_location() + tripoint( 20, 20, 0 );
+
+    std::map<std::string, mapgen_stats> per_type;
+    double elapsed = 0;
+    for( int turn = 0; turn < opts.turns; turn++ ) {
+        const tripoint omt = origin + tripoint( turn % bench_row_length, turn / bench_row_length, 0 );
+        // Index 0 is the null terrain.
+        const oter_id type( 1 + turn % ( int( oter_t::count() ) - 1 ) );
+        // Not timed, this may have to generate the overmap first.
+        overmap_buffer.ter_set( omt, type );
+        const auto type_start = std::chrono::steady_clock::now();
+        tinymap tmp_map;
+        tmp_map.generate( omt.x * 2, omt.y * 2, omt.z, calendar::turn );
+        const double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() -
+                               type_start ).count();
+        mapgen_stats &stats = per_type[type->id_base];
+        stats.seconds += seconds;
+        stats.calls++;
+        elapsed += seconds;
+    }
+
+    printf( "mapgen calls: %d  types: %zu  elapsed: %.3f s  mapgen/s: %.1f\n", opts.turns,
+            oter_t::count() - 1, elapsed, opts.turns / std::max( elapsed, 1e-9 ) );
+    std::vector<std::pair<std::string, mapgen_stats>> slowest( per_type.begin(), per_type.end() );
+    std::sort( slowest.begin(), slowest.end(), []( const std::pair<std::string, mapgen_stats> &lhs,
+    const std::pair<std::string, mapgen_stats> &rhs ) {
+        return lhs.second.seconds / lhs.second.calls > rhs.second.seconds / rhs.second.calls;
+    } );
+    slowest.resize( std::min<size_t>( slowest.size(), 10 ) );
+    for( const auto &entry : slowest ) {
+        printf( "  %-24s %8.3f ms/call\n", entry.first.c_str(),
+                1000.0 * entry.second.seconds / entry.second.calls );
+    }
+    printf( "peak RSS: %ld kB\n\n", bench_peak_rss_kb() );
+    fflush( stdout );
+}
+
+bench_registrar mapgen_bench( "mapgen", "generates every overmap terrain type in turn",
+                              run_mapgen_bench );
+
+} // namespace
@@ -0,0 +1,68 @@
+#include "bench.h"
+
+#include "rng.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace
+{
+
+/** Keeps the compiler from dropping the loops below. */
+volatile long sink;
+
+template<typename F>
+void time_draws( const char *label, long iterations, F draw )
+{
+    const auto start = std::chrono::steady_clock::now();
+    long acc = 0;
+    for( long i = 0; i < iterations; i++ ) {
+        acc += draw();
+    }
+    sink = acc;
+    const double elapsed = std::chrono::duration<double>( std::chrono::steady_clock::now() -
+                           start ).count();
+    printf( "  %-28s %8.2f ns/call %10.1f M/s\n", label, 1e9 * elapsed / iterations,
+            iterations / std::max( elapsed, 1e-9 ) / 1e6 );
+}
+
+void run_rng_bench( const bench_options &opts )
+{
+    const long iterations = long( opts.turns ) * 10000;
+    bench_reseed( opts );
+    rng_stream stream( rand() );
+
+    printf( "%ld draws each\n", iterations );
+    time_draws( "rng( 0, 99 )", iterations, []() {
+        return rng( 0, 99 );
+    } );
+    time_draws( "rng_stream::rng( 0, 99 )", iterations, [&stream]() {
+        return stream.rng( 0, 99 );
+    } );
+    time_draws( "one_in( 10 )", iterations, []() {
+        return long( one_in( 10 ) );
+    } );
+    time_draws( "rng_stream::one_in( 10 )", iterations, [&stream]() {
+        return long( stream.one_in( 10 ) );
+    } );
+    time_draws( "x_in_y( 1, 3 )", iterations, []() {
+        return long( x_in_y( 1, 3 ) );
+    } );
+    time_draws( "rng_stream::x_in_y( 1, 3 )", iterations, [&stream]() {
+        return long( stream.x_in_y( 1, 3 ) );
+    } );
+    time_draws( "rng_float( 0, 1 )", iterations, []() {
+        return long( rng_float( 0, 1 ) * 1000 );
+    } );
+    time_draws( "rng_stream::rng_float( 0, 1 )", iterations, [&stream]() {
+        return long( stream.rng_float( 0, 1 ) * 1000 );
+    } );
+    time_draws( "rng_stream::derive( key )", iterations / 10, [&stream]() {
+        return long( stream.derive( uint64_t( sink ) )() );
+    } );
+    printf( "\n" );
+}
+
+bench_registrar rng_bench( "rng", "global rng() against rng_stream", run_rng_bench );
+
+} // namespace
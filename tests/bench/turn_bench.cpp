@@ -0,0 +1,193 @@
+#include "bench.h"
+
+#include "coordinate_conversions.h"
+#include "field.h"
+#include "game.h"
+#include "map.h"
+#include "map_iterator.h"
+#include "mapdata.h"
+#include "mtype.h"
+#include "overmap.h"
+#include "overmapbuffer.h"
+#include "player.h"
+#include "rng.h"
+#include "turn_timer.h"
+#include "vehicle.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+
+const mtype_id mon_zombie( "mon_zombie" );
+const vproto_id veh_car( "car" );
+
+/**
+ * Moves the reality bubble so that the player stands in the middle of the
+ * given overmap terrain, dropping all monsters and vehicles of the old bubble.
+ */
+void relocate_player( const tripoint &omt )
+{
+    g->clear_zombies();
+    if( g->u.in_vehicle ) {
+        g->m.unboard_vehicle( g->u.pos() );
+    }
+    const int minz = g->m.has_zlevels() ? -OVERMAP_DEPTH : g->get_levz();
+    const int maxz = g->m.has_zlevels() ? OVERMAP_HEIGHT : g->get_levz();
+    for( int z = minz; z <= maxz; z++ ) {
+        g->m.clear_vehicle_cache( z );
+        g->m.clear_vehicle_list( z );
+    }
+    // load_map expects the top left submap, the target is placed in the center.
+    g->load_map( tripoint( omt.x * 2 - int( MAPSIZE / 2 ), omt.y * 2 - int( MAPSIZE / 2 ), omt.z ) );
+    g->u.setpos( tripoint( SEEX * int( MAPSIZE / 2 ) + SEEX / 2,
+                           SEEY * int( MAPSIZE / 2 ) + SEEY / 2, omt.z ) );
+    g->m.spawn_monsters( true );
+    g->m.build_map_cache( omt.z );
+}
+
+void relocate_player( const std::string &omt_type )
+{
+    const tripoint origin = g->u.global_omt_location();
+    const tripoint target = overmap_buffer.find_closest( origin, omt_type, OMAPX, false );
+    relocate_player( target == overmap::invalid_tripoint ? origin : target );
+}
+
+/** Points within the reality bubble at the player's z-level, distance [min_dist, max_dist]. */
+std::vector<tripoint> free_points_around_player( int min_dist, int max_dist )
+{
+    std::vector<tripoint> result;
+    const tripoint center = g->u.pos();
+    for( const tripoint &p : g->m.points_in_radius( center, max_dist ) ) {
+        if( rl_dist( center, p ) >= min_dist && g->m.passable( p ) && g->is_empty( p ) ) {
+            result.push_back( p );
+        }
+    }
+    return result;
+}
+
+void setup_dense_city()
+{
+    const city_reference city = overmap_buffer.closest_city( g->u.global_sm_location() );
+    if( city ) {
+        relocate_player( sm_to_omt_copy( city.abs_sm_pos ) );
+    } else {
+        relocate_player( "house" );
+    }
+}
+
+void setup_horde_siege()
+{
+    relocate_player( "field" );
+    std::vector<tripoint> spots = free_points_around_player( 8, 30 );
+    for( int i = 0; i < 200 && !spots.empty(); i++ ) {
+        g->summon_mon( mon_zombie, random_entry_removed( spots ) );
+    }
+}
+
+void setup_burning_building()
+{
+    relocate_player( "house" );
+    const tripoint center = g->u.pos();
+    for( const tripoint &p : g->m.points_in_radius( center, SEEX ) ) {
+        if( g->m.has_flag( TFLAG_FLAMMABLE, p ) || g->m.has_flag( TFLAG_FLAMMABLE_ASH, p ) ) {
+            if( one_in( 3 ) ) {
+                g->m.add_field( p, fd_fire, 3 );
+            }
+        }
+    }
+    // Watch from the doorstep rather than from inside the fire.
+    g->u.setpos( center + tripoint( SEEX, SEEY, 0 ) );
+}
+
+void setup_vehicle_convoy()
+{
+    relocate_player( "road" );
+    const tripoint center = g->u.pos();
+    for( int i = 0; i < 12; i++ ) {
+        const tripoint p = center + tripoint( -30 + ( i % 4 ) * 16, -20 + ( i / 4 ) * 16, 0 );
+        vehicle *veh = g->m.add_vehicle( veh_car, p, 90 * ( i % 4 ), 100, 0 );
+        if( veh == nullptr ) {
+            continue;
+        }
+        veh->engine_on = true;
+        veh->cruise_velocity = 2000;
+        veh->velocity = veh->cruise_velocity;
+    }
+}
+
+/** Keeps the convoy at speed and steering in circles around the bubble. */
+void drive_vehicle_convoy( int turn )
+{
+    for( auto &wrapped : g->m.get_vehicles() ) {
+        vehicle &veh = *wrapped.v;
+        if( !veh.engine_on ) {
+            continue;
+        }
+        veh.skidding = false;
+        veh.velocity = veh.cruise_velocity;
+        if( turn % 4 == 0 ) {
+            veh.turn( 15 );
+        }
+    }
+}
+
+void run_turn_scenario( const bench_options &opts, const std::function<void()> &setup,
+                        const std::function<void( int )> &per_turn )
+{
+    bench_reseed( opts );
+    setup();
+    if( !g->u.has_trait( "DEBUG_NODMG" ) ) {
+        g->u.toggle_trait( "DEBUG_NODMG" );
+    }
+
+    turn_timer::reset();
+    turn_timer::enabled = true;
+    const auto start = std::chrono::steady_clock::now();
+    for( int turn = 0; turn < opts.turns; turn++ ) {
+        if( per_turn ) {
+            per_turn( turn );
+        }
+        // The player waits, so do_turn never asks for input.
+        g->u.moves = 0;
+        g->do_turn();
+    }
+    const double elapsed = std::chrono::duration<double>( std::chrono::steady_clock::now() -
+                           start ).count();
+    turn_timer::enabled = false;
+
+    printf( "turns: %d  elapsed: %.3f s  turns/s: %.1f  monsters: %zu  vehicles: %zu\n",
+            opts.turns, elapsed, opts.turns / std::max( elapsed, 1e-9 ), g->num_zombies(),
+            g->m.get_vehicles().size() );
+    for( const auto &phase : turn_timer::stats() ) {
+        printf( "  %-16s %10.3f ms/turn %6.1f%%\n", phase.first.c_str(),
+                1000.0 * phase.second.seconds / opts.turns,
+                100.0 * phase.second.seconds / std::max( elapsed, 1e-9 ) );
+    }
+    printf( "peak RSS: %ld kB\n\n", bench_peak_rss_kb() );
+    fflush( stdout );
+}
+
+bench_registrar city_bench( "turns_city", "player idles in the center of the closest city",
+[]( const bench_options & opts ) {
+    run_turn_scenario( opts, setup_dense_city, nullptr );
+} );
+
+bench_registrar horde_bench( "turns_horde", "200 zombies besieging the player in a field",
+[]( const bench_options & opts ) {
+    run_turn_scenario( opts, setup_horde_siege, nullptr );
+} );
+
+bench_registrar fire_bench( "turns_fire", "a house burning down next to the player",
+[]( const bench_options & opts ) {
+    run_turn_scenario( opts, setup_burning_building, nullptr );
+} );
+
+bench_registrar convoy_bench( "turns_convoy", "a dozen unmanned cars circling the player",
+[]( const bench_options & opts ) {
+    run_turn_scenario( opts, setup_vehicle_convoy, drive_vehicle_convoy );
+} );
+
+} // namespace
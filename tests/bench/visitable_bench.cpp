@@ -0,0 +1,148 @@
+#include "bench.h"
+
+#include "game.h"
+#include "inventory.h"
+#include "item.h"
+#include "map.h"
+#include "player.h"
+#include "vehicle.h"
+#include "vehicle_selector.h"
+#include "visitable_inline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const vproto_id veh_car( "car" );
+
+/** A mix of tools, containers with contents and plain items, most of which do not stack. */
+std::vector<item> cargo_items()
+{
+    item bottle( "bottle_plastic" );
+    bottle.contents.emplace_back( "water_clean", 0, 2 );
+    item box( "box_small" );
+    box.contents.push_back( item( "screwdriver" ) );
+    box.contents.push_back( item( "rag" ) );
+    return {{
+            item( "hammer" ), item( "screwdriver" ), item( "flashlight" ), item( "knife_butcher" ),
+            bottle, box, item( "rag" ), item( "rock" ), item( "stick" ), item( "battery", 0, 50 )
+        }
+    };
+}
+
+/** Runs @p query @p turns times and prints how long one call took. */
+template<typename Query>
+void time_query( const char *name, int turns, int items, Query query )
+{
+    long sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for( int turn = 0; turn < turns; turn++ ) {
+        sink += query();
+    }
+    const double elapsed = std::chrono::duration<double>( std::chrono::steady_clock::now() -
+                           start ).count();
+    printf( "  %-24s %10.2f us/call %8.2f ns/item  (%ld)\n", name, 1e6 * elapsed / turns,
+            1e9 * elapsed / turns / std::max( items, 1 ), sink / turns );
+}
+
+/** The same searches over anything visitable, once through std::function and once inlined. */
+template<typename T>
+void time_searches( const char *what, T &obj, int turns )
+{
+    int items = 0;
+    obj.visit_inline( [&items]( const item * ) {
+        items++;
+        return VisitResponse::NEXT;
+    } );
+    printf( "%s: %d items\n", what, items );
+
+    time_query( "visit std::function", turns, items, [&obj]() {
+        int count = 0;
+        const std::function<VisitResponse( item * )> func = [&count]( item * ) {
+            count++;
+            return VisitResponse::NEXT;
+        };
+        obj.visit_items( func );
+        return count;
+    } );
+    time_query( "visit inline", turns, items, [&obj]() {
+        int count = 0;
+        obj.visit_inline( [&count]( const item * ) {
+            count++;
+            return VisitResponse::NEXT;
+        } );
+        return count;
+    } );
+    time_query( "amount_of", turns, items, [&obj]() {
+        return obj.amount_of( "rock" );
+    } );
+    time_query( "charges_of", turns, items, [&obj]() {
+        return obj.charges_of( "battery" );
+    } );
+    time_query( "has_quality (all)", turns, items, [&obj]() {
+        // Asking for more than there is visits everything.
+        return obj.has_quality( quality_id( "HAMMER" ), 1, INT_MAX ) ? 1 : 0;
+    } );
+    time_query( "has_item_with (miss)", turns, items, [&obj]() {
+        return obj.has_item_with( []( const item & it ) {
+            return it.typeId() == "null";
+        } ) ? 1 : 0;
+    } );
+    time_query( "items_with", turns, items, [&obj]() {
+        return obj.items_with( []( const item & it ) {
+            return it.is_tool();
+        } ).size();
+    } );
+}
+
+/**
+ * Searches the items of a character carrying a few hundred items and of a car with
+ * full cargo space, which is what crafting and NPC item scoring do all the time.
+ */
+void run_visitable_bench( const bench_options &opts )
+{
+    bench_reseed( opts );
+    const std::vector<item> cargo = cargo_items();
+
+    const inventory original = g->u.inv;
+    for( int i = 0; i < 400; i++ ) {
+        g->u.inv.add_item( cargo[i % cargo.size()], false, false );
+    }
+    time_searches( "character", static_cast<Character &>( g->u ), opts.turns );
+    g->u.inv = original;
+
+    // The car needs open ground, try spots around the player until one fits.
+    vehicle *veh = nullptr;
+    for( int i = 0; i < 100 && veh == nullptr; i++ ) {
+        const tripoint pos = g->u.pos() + tripoint( -30 + ( i % 10 ) * 6, -30 + ( i / 10 ) * 6, 0 );
+        if( g->m.inbounds( pos ) ) {
+            veh = g->m.add_vehicle( veh_car, pos, 0, 100, 0, false );
+        }
+    }
+    if( veh == nullptr ) {
+        printf( "vehicle: could not place a car\n\n" );
+        return;
+    }
+    for( const int part : veh->all_parts_with_feature( "CARGO" ) ) {
+        for( size_t i = 0; veh->add_item( part, cargo[i % cargo.size()] ); i++ ) {
+        }
+    }
+    vehicle_selector sel( veh->global_pos3(), 4, false );
+    time_searches( "vehicle", sel, opts.turns );
+    g->m.destroy_vehicle( veh );
+
+    printf( "peak RSS: %ld kB\n\n", bench_peak_rss_kb() );
+    fflush( stdout );
+}
+
+bench_registrar visitable_bench( "visitable", "item searches over a loaded character and car",
+                                 run_visitable_bench );
+
+} // namespace
@@ -0,0 +1,74 @@
+#include "catch/catch.hpp"
+
+#include "debug.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern bool test_dirty;
+
+TEST_CASE( "lazy_debug_log_evaluates_only_logged_messages" )
+{
+    int evaluated = 0;
+    const auto count = [&evaluated]() {
+        return ++evaluated;
+    };
+    const bool logged = debugLogEnabled( D_PEDANTIC_INFO, D_SDL, __FILE__, __LINE__ );
+    DebugLogLazy( D_PEDANTIC_INFO, D_SDL ) << "evaluated " << count();
+    CHECK( evaluated == ( logged ? 1 : 0 ) );
+
+    // Errors are always logged.
+    DebugLogLazy( D_ERROR, D_SDL ) << "evaluated " << count();
+    CHECK( evaluated == ( logged ? 2 : 1 ) );
+}
+
+TEST_CASE( "debug_trace_records_reached_statements" )
+{
+    const std::string filename = "debug_trace_test.bin";
+    REQUIRE( startDebugTrace( filename ) );
+    for( int i = 0; i < 2; i++ ) {
+        DebugLogLazy( D_WARNING, D_SDL ) << "traced";
+    }
+    stopDebugTrace();
+
+    std::vector<char> data;
+    FILE *file = fopen( filename.c_str(), "rb" );
+    REQUIRE( file != nullptr );
+    char buffer[256];
+    size_t read;
+    while( ( read = fread( buffer, 1, sizeof( buffer ), file ) ) > 0 ) {
+        data.insert( data.end(), buffer, buffer + read );
+    }
+    fclose( file );
+    remove( filename.c_str() );
+
+    const size_t name_length = strlen( __FILE__ );
+    const size_t event_size = 1 + 8 + 4 * 4 + 1;
+    REQUIRE( data.size() == 8 + ( 1 + 4 + 4 + name_length ) + 2 * event_size );
+    CHECK( std::string( data.data(), 8 ) == "CDDATRC1" );
+    CHECK( data[8] == 'F' );
+    CHECK( std::string( data.data() + 8 + 9, name_length ) == __FILE__ );
+    const size_t first_event = 8 + 9 + name_length;
+    CHECK( data[first_event] == 'E' );
+    CHECK( data[first_event + event_size] == 'E' );
+    uint32_t level;
+    memcpy( &level, data.data() + first_event + 1 + 8 + 4 + 4, sizeof( level ) );
+    CHECK( level == D_WARNING );
+}
+
+TEST_CASE( "debugmsg_from_other_threads_waits_for_the_main_thread" )
+{
+    const bool was_dirty = test_dirty;
+    test_dirty = false;
+    std::thread( []() {
+        debugmsg( "raised on a worker thread" );
+    } ).join();
+    CHECK_FALSE( test_dirty );
+    flush_deferred_debugmsgs();
+    CHECK( test_dirty );
+    test_dirty = was_dirty;
+}
@@ -0,0 +1,76 @@
+#include "catch/catch.hpp"
+
+#include "effect.h"
+
+#include <vector>
+
+static const efftype_id effect_bite( "bite" );
+static const efftype_id effect_downed( "downed" );
+static const efftype_id effect_infected( "infected" );
+
+static effect make_effect( const efftype_id &id, body_part bp )
+{
+    return effect( &id.obj(), 10, bp, false, 1, 0 );
+}
+
+TEST_CASE( "effect_storage_finds_effects_by_type_and_body_part" )
+{
+    effect_storage effects;
+    CHECK( effects.empty() );
+    CHECK_FALSE( effects.has( effect_bite ) );
+
+    effects.set( effect_bite, bp_arm_l, make_effect( effect_bite, bp_arm_l ) );
+    effects.set( effect_bite, bp_leg_r, make_effect( effect_bite, bp_leg_r ) );
+    effects.set( effect_downed, num_bp, make_effect( effect_downed, num_bp ) );
+    CHECK( effects.size() == 3 );
+    CHECK( effects.has( effect_bite ) );
+    CHECK( effects.has( effect_downed ) );
+    CHECK_FALSE( effects.has( effect_infected ) );
+    REQUIRE( effects.find( effect_bite, bp_leg_r ) != nullptr );
+    CHECK( effects.find( effect_bite, bp_leg_r )->get_bp() == bp_leg_r );
+    CHECK( effects.find( effect_bite, bp_head ) == nullptr );
+    CHECK( effects.find( effect_downed, bp_head ) == nullptr );
+
+    // Setting an existing one replaces it in place.
+    effect &stored = *effects.find( effect_bite, bp_arm_l );
+    effect longer = make_effect( effect_bite, bp_arm_l );
+    longer.set_duration( 50 );
+    effects.set( effect_bite, bp_arm_l, longer );
+    CHECK( effects.size() == 3 );
+    CHECK( stored.get_duration() == 50 );
+
+    CHECK( effects.erase( effect_bite, bp_arm_l ) );
+    CHECK( effects.has( effect_bite ) );
+    CHECK_FALSE( effects.erase( effect_bite, bp_arm_l ) );
+    CHECK( effects.erase( effect_bite ) );
+    CHECK_FALSE( effects.has( effect_bite ) );
+    CHECK( effects.has( effect_downed ) );
+
+    const effect_storage copy = effects;
+    effects.clear();
+    CHECK( effects.empty() );
+    CHECK( copy.has( effect_downed ) );
+}
+
+TEST_CASE( "effect_storage_iterates_while_effects_change" )
+{
+    effect_storage effects;
+    effects.set( effect_bite, bp_arm_l, make_effect( effect_bite, bp_arm_l ) );
+    effects.set( effect_bite, bp_leg_r, make_effect( effect_bite, bp_leg_r ) );
+    effect &kept = effects.set( effect_downed, num_bp, make_effect( effect_downed, num_bp ) );
+
+    // Like a bite turning into an infection: other effects are added and removed
+    // while visiting, and references to the remaining ones stay valid.
+    std::vector<body_part> visited;
+    effects.for_each( [&]( effect & e ) {
+        if( e.get_id() == effect_bite ) {
+            visited.push_back( e.get_bp() );
+            effects.set( effect_infected, e.get_bp(), make_effect( effect_infected, e.get_bp() ) );
+            effects.erase( effect_bite, bp_leg_r );
+        }
+    } );
+    CHECK( visited == std::vector<body_part>( { bp_arm_l } ) );
+    CHECK( kept.get_id() == effect_downed );
+    CHECK( effects.has( effect_infected ) );
+    CHECK( effects.size() == 3 );
+}
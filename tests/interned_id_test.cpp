@@ -0,0 +1,53 @@
+#include "catch/catch.hpp"
+
+#include "interned_id.h"
+#include "thread_pool.h"
+
+#include <string>
+#include <vector>
+
+TEST_CASE( "interning_while_frozen_keeps_ids_dense" )
+{
+    string_interner interner;
+    CHECK( interner.intern( "first" ) == 0 );
+    CHECK( interner.intern( "second" ) == 1 );
+    interner.freeze();
+
+    CHECK( interner.intern( "second" ) == 1 );
+    CHECK( interner.find( "late" ) == -1 );
+    CHECK( interner.intern( "late" ) == 2 );
+    CHECK( interner.intern( "late" ) == 2 );
+    CHECK( interner.find( "late" ) == 2 );
+    CHECK( interner.str( 2 ) == "late" );
+    CHECK( interner.str( 0 ) == "first" );
+    CHECK( interner.size() == 3 );
+
+    interner.thaw();
+    CHECK( interner.find( "late" ) == 2 );
+    CHECK( interner.str( 2 ) == "late" );
+    CHECK( interner.intern( "after" ) == 3 );
+    CHECK( interner.size() == 4 );
+}
+
+TEST_CASE( "frozen_lookups_see_the_same_ids_while_strings_are_interned" )
+{
+    string_interner interner;
+    std::vector<std::string> known;
+    for( int i = 0; i < 100; i++ ) {
+        known.push_back( "known_" + std::to_string( i ) );
+        interner.intern( known.back() );
+    }
+    interner.freeze();
+
+    std::vector<int> found( 1000, -2 );
+    parallel_for( found.size(), [&]( size_t i ) {
+        if( i % 10 == 0 ) {
+            interner.intern( "new_" + std::to_string( i ) );
+        }
+        found[i] = interner.find( known[i % known.size()] );
+    } );
+    for( size_t i = 0; i < found.size(); i++ ) {
+        CHECK( found[i] == int( i % known.size() ) );
+    }
+    CHECK( interner.size() == known.size() + found.size() / 10 );
+}
@@ -0,0 +1,79 @@
+#include "catch/catch.hpp"
+
+#include "inventory.h"
+#include "item.h"
+#include "itype.h"
+
+#include <string>
+#include <vector>
+
+static std::vector<item> index_test_items()
+{
+    item bottle( "bottle_plastic" );
+    bottle.contents.emplace_back( "water_clean", 0, 2 );
+    item pot( "pot" );
+    pot.contents.push_back( item( "hammer" ) );
+    return {{
+            item( "hammer" ), item( "hammer" ), bottle, pot, item( "flashlight" ),
+            item( "nail", 0, 40 ), item( "toolset", 0, 20 ), item( "mess_kit", 0, 10 )
+        }
+    };
+}
+
+TEST_CASE( "inventory_index_answers_like_a_scan" )
+{
+    inventory scanned;
+    inventory indexed;
+    for( const item &it : index_test_items() ) {
+        scanned.add_item( it, false, false );
+        indexed.add_item( it, false, false );
+    }
+    indexed.build_index();
+    REQUIRE( indexed.get_index() != nullptr );
+
+    const std::vector<std::string> ids = {{
+            "hammer", "water_clean", "bottle_plastic", "pot", "flashlight", "battery", "nail",
+            "toolset", "hotplate", "soldering_iron", "rock"
+        }
+    };
+    for( const std::string &id : ids ) {
+        for( int qty : { 1, 2, 3, 40, 41 } ) {
+            INFO( id << " x" << qty );
+            CHECK( indexed.has_tools( id, qty ) == scanned.has_tools( id, qty ) );
+            CHECK( indexed.has_components( id, qty ) == scanned.has_components( id, qty ) );
+            CHECK( indexed.has_charges( id, qty ) == scanned.has_charges( id, qty ) );
+        }
+    }
+    const std::vector<std::string> qualities = {{ "HAMMER", "BOIL", "COOK", "CUT", "CONTAIN", "SCREW" }};
+    for( const std::string &qual : qualities ) {
+        for( int level = 0; level <= 3; level++ ) {
+            for( int qty : { 0, 1, 2, 3, 4 } ) {
+                INFO( qual << " level " << level << " x" << qty );
+                CHECK( indexed.has_quality( quality_id( qual ), level, qty ) ==
+                       scanned.has_quality( quality_id( qual ), level, qty ) );
+            }
+        }
+    }
+
+    // Changing the inventory drops the index.
+    indexed.add_item( item( "rock" ), false, false );
+    CHECK( indexed.get_index() == nullptr );
+    CHECK( indexed.has_components( "rock", 1 ) );
+
+    // So does visiting the items with non-const access, but const visitors keep it.
+    indexed.build_index();
+    const inventory &const_indexed = indexed;
+    const_indexed.visit_items( []( const item * ) {
+        return VisitResponse::NEXT;
+    } );
+    CHECK( indexed.get_index() != nullptr );
+    CHECK( indexed.has_charges( "nail", 40 ) );
+    indexed.visit_items( []( item * e ) {
+        if( e->typeId() == "nail" ) {
+            e->charges = 1;
+        }
+        return VisitResponse::NEXT;
+    } );
+    CHECK( indexed.get_index() == nullptr );
+    CHECK_FALSE( indexed.has_charges( "nail", 40 ) );
+}
@@ -88,3 +88,27 @@ TEST_CASE( "use_manhack" ) {
     REQUIRE( new_manhack->type->id == mtype_id( "mon_manhack" ) );
     g->clear_zombies();
 }
+
+extern bool test_dirty;
+
+TEST_CASE( "invoking_a_missing_method_leaves_the_item_alone" ) {
+    player &dummy = get_sanitized_player();
+
+    item &test_item = dummy.i_add( item( "saline", 0, item::default_charges_tag{} ) );
+    REQUIRE( test_item.charges == 5 );
+
+    const bool was_dirty = test_dirty;
+    // Reports the bad method instead of using the item or firing the item use hook
+    CHECK_FALSE( dummy.invoke_item( &test_item, "NOT_A_USE_METHOD" ) );
+    CHECK( test_dirty );
+    test_dirty = was_dirty;
+
+    REQUIRE( dummy.inv.position_by_item( &test_item ) != INT_MIN );
+    CHECK( test_item.charges == 5 );
+
+    // The real method still works, and reaches the (no-op without Lua) hook
+    dummy.add_env_effect( efftype_id( "boomered" ), bp_eyes, 3, 12 );
+    dummy.invoke_item( &test_item, "EYEDROPS" );
+    CHECK( test_item.charges == 4 );
+    CHECK_FALSE( dummy.has_effect( efftype_id( "boomered" ) ) );
+}
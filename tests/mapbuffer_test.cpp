@@ -0,0 +1,84 @@
+#include "catch/catch.hpp"
+
+#include "coordinate_conversions.h"
+#include "item.h"
+#include "map.h"
+#include "mapbuffer.h"
+#include "mapdata.h"
+#include "submap.h"
+
+#include <memory>
+
+static tripoint add_rock_quad( const tripoint &om_addr )
+{
+    const tripoint base = omt_to_sm_copy( om_addr );
+    for( int x = 0; x <= 1; x++ ) {
+        for( int y = 0; y <= 1; y++ ) {
+            std::unique_ptr<submap> sm( new submap() );
+            sm->is_uniform = true;
+            std::uninitialized_fill_n( &sm->ter[0][0], SEEX * SEEY, t_rock );
+            sm->turn_last_touched = 1234;
+            REQUIRE( MAPBUFFER.add_submap( base.x + x, base.y + y, base.z, sm ) );
+        }
+    }
+    return base;
+}
+
+// The positions are far away from anything the other tests generate
+TEST_CASE( "blank_uniform_submaps_are_compacted_and_restored" )
+{
+    const tripoint base = add_rock_quad( tripoint( 5000, 5000, -5 ) );
+
+    CHECK( MAPBUFFER.compact_uniform( tripoint( 5000, 5000, -5 ) ) );
+    // Already compacted, there are no submaps left to compact
+    CHECK_FALSE( MAPBUFFER.compact_uniform( tripoint( 5000, 5000, -5 ) ) );
+
+    submap *const sm = MAPBUFFER.lookup_submap( base.x + 1, base.y, base.z );
+    REQUIRE( sm != nullptr );
+    CHECK( sm->is_uniform );
+    CHECK( sm->is_blank_uniform() );
+    CHECK( sm->get_ter( SEEX - 1, SEEY - 1 ) == t_rock );
+    CHECK( sm->turn_last_touched == 1234 );
+    // The restored submap is kept, not built again on each lookup
+    CHECK( MAPBUFFER.lookup_submap( base.x + 1, base.y, base.z ) == sm );
+}
+
+TEST_CASE( "submaps_with_content_are_not_compacted" )
+{
+    const tripoint base = add_rock_quad( tripoint( 5001, 5000, -5 ) );
+    submap *const sm = MAPBUFFER.lookup_submap( base.x, base.y + 1, base.z );
+    REQUIRE( sm != nullptr );
+    sm->get_items( 3, 3 ).push_back( item( "rock" ) );
+
+    CHECK_FALSE( sm->is_blank_uniform() );
+    CHECK_FALSE( MAPBUFFER.compact_uniform( tripoint( 5001, 5000, -5 ) ) );
+    CHECK( MAPBUFFER.lookup_submap( base.x, base.y + 1, base.z ) == sm );
+}
+
+TEST_CASE( "changes_to_restored_submaps_are_saved" )
+{
+    const tripoint om_addr( 5002, 5000, -5 );
+    const tripoint base = add_rock_quad( om_addr );
+    REQUIRE( MAPBUFFER.compact_uniform( om_addr ) );
+
+    // Loading the map restores the submaps, digging out a tile makes them worth saving
+    tinymap tm;
+    tm.load( base.x, base.y, base.z, false );
+    tm.ter_set( tripoint( 3, 3, base.z ), t_dirt );
+    submap *const sm = MAPBUFFER.lookup_submap( base );
+    REQUIRE( sm != nullptr );
+    CHECK_FALSE( sm->is_uniform );
+
+    // Blank again, but it differs from what would be generated now
+    tm.ter_set( tripoint( 3, 3, base.z ), t_rock );
+    CHECK( sm->is_blank_uniform() );
+    CHECK_FALSE( MAPBUFFER.compact_uniform( om_addr ) );
+    tm.ter_set( tripoint( 3, 3, base.z ), t_dirt );
+
+    // Only this quad is saved, and dropped from the buffer so it is read back from disk
+    MAPBUFFER.save_quad( om_addr, true );
+    submap *const loaded = MAPBUFFER.lookup_submap( base );
+    REQUIRE( loaded != nullptr );
+    CHECK( loaded->get_ter( 3, 3 ) == t_dirt );
+    CHECK( loaded->get_ter( 4, 4 ) == t_rock );
+}
@@ -2,13 +2,18 @@
 
 #include "creature.h"
 #include "creature_tracker.h"
+#include "field.h"
 #include "game.h"
 #include "map.h"
+#include "map_iterator.h"
 #include "mapdata.h"
 #include "monster.h"
 #include "mtype.h"
 #include "options.h"
 #include "player.h"
+#include "rng.h"
+#include "scent_map.h"
+#include "sounds.h"
 
 #include <fstream>
 #include <sstream>
@@ -374,3 +379,70 @@ TEST_CASE("monster_speed_trig") {
     trigdist = true;
     monster_check();
 }
+
+/**
+ * Runs a few monster turns of a fixed-seed mix of zombies, animals and friendly monsters
+ * fighting each other, and describes where everyone ended up and how they fared.
+ */
+static std::vector<std::string> monmove_outcome( const bool first_plans )
+{
+    clear_map();
+    rng_stream dice( 4321 );
+    const rng_stream_scope scope( dice );
+    const tripoint center( 60, 60, 0 );
+    const map &here = g->m;
+    // Blood, corpses, scent and noise of the previous run
+    for( const tripoint &p : g->m.points_in_radius( center, 30 ) ) {
+        for( int f = fd_null + 1; f < num_fields; f++ ) {
+            if( here.field_at( p ).findField( field_id( f ) ) != nullptr ) {
+                g->m.remove_field( p, field_id( f ) );
+            }
+        }
+        g->m.i_clear( p );
+    }
+    g->scent.reset();
+    sounds::reset_sounds();
+    // Herbivores, predators and zombies, some close enough to change their anger and morale.
+    static const std::vector<std::string> types = {
+        "mon_zombie", "mon_zombie_dog", "mon_pig", "mon_deer", "mon_wolf", "mon_bee"
+    };
+    rng_stream positions( 1234 );
+    for( int i = 0; i < 60; i++ ) {
+        const tripoint p = center + tripoint( positions.rng( -15, 15 ), positions.rng( -15, 15 ), 0 );
+        if( p != center && g->critter_at( p ) == nullptr ) {
+            monster mon( mtype_id( types[i % types.size()] ), p );
+            mon.friendly = i % 7 == 0 ? -1 : 0;
+            g->critter_tracker->add( mon );
+        }
+    }
+    REQUIRE( g->num_zombies() > 40 );
+    g->m.build_map_cache( center.z );
+    for( int turn = 0; turn < 10; turn++ ) {
+        g->monmove( first_plans );
+    }
+
+    std::vector<std::string> res;
+    for( size_t i = 0; i < g->num_zombies(); i++ ) {
+        const monster &critter = g->zombie( i );
+        std::ostringstream desc;
+        desc << critter.type->id.str() << " at " << critter.pos() << " hp " << critter.get_hp() <<
+             " anger " << critter.anger << " morale " << critter.morale << " friendly " <<
+             critter.friendly << ( critter.is_dead() ? " dead" : "" );
+        res.push_back( desc.str() );
+    }
+    std::ostringstream player_desc;
+    player_desc << "player at " << g->u.pos() << " hp " << g->u.get_hp( num_hp_parts );
+    res.push_back( player_desc.str() );
+    clear_map();
+    return res;
+}
+
+TEST_CASE( "monster_turns_with_first_plans_match_planning_on_each_turn" )
+{
+    const std::vector<std::string> serial = monmove_outcome( false );
+    const std::vector<std::string> planned = monmove_outcome( true );
+    REQUIRE( serial.size() == planned.size() );
+    for( size_t i = 0; i < serial.size(); i++ ) {
+        CHECK( planned[i] == serial[i] );
+    }
+}
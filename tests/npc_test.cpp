@@ -5,9 +5,13 @@
 #include "npc_class.h"
 #include "game.h"
 #include "map.h"
+#include "monster.h"
+#include "creature_tracker.h"
+#include "line.h"
 #include "text_snippets.h"
 
 #include <string>
+#include <vector>
 
 void on_load_test( npc &who, calendar from, calendar to )
 {
@@ -178,3 +182,59 @@ TEST_CASE("snippet-tag-test")
     CHECK( SNIPPET.all_ids_from_category( "<mywp>" ).empty() );
     CHECK( SNIPPET.all_ids_from_category( "<ammo>" ).empty() );
 }
+
+TEST_CASE("threat_map_finds_the_same_monsters_as_a_full_scan")
+{
+    while( g->num_zombies() ) {
+        g->remove_zombie( 0 );
+    }
+    const std::vector<tripoint> positions = {{
+        { 5, 5, 0 }, { 30, 31, 0 }, { 60, 60, 0 }, { 61, 66, 1 },
+        { 70, 40, -1 }, { 130, 2, 0 }, { -3, 20, 0 }, { 65, 70, 0 }
+    }};
+    for( const tripoint &p : positions ) {
+        monster zombie( mtype_id( "mon_zombie" ), p );
+        g->critter_tracker->add( zombie );
+    }
+
+    const auto full_scan = []( const tripoint &center, int range ) {
+        std::vector<size_t> result;
+        for( size_t i = 0; i < g->num_zombies(); i++ ) {
+            if( square_dist( center, g->zombie( i ).pos() ) <= range ) {
+                result.push_back( i );
+            }
+        }
+        return result;
+    };
+
+    npc_threat_map threat_map;
+    threat_map.build();
+    const std::vector<std::pair<tripoint, int>> queries = {{
+        { { 60, 60, 0 }, 6 }, { { 60, 60, 0 }, 60 }, { { 0, 0, 0 }, 25 },
+        { { 131, 131, 0 }, 3 }, { { 65, 65, 1 }, 10 }, { { 20, 20, 0 }, 200 }
+    }};
+    for( const auto &q : queries ) {
+        CHECK( threat_map.monsters_near( q.first, q.second ) == full_scan( q.first, q.second ) );
+    }
+
+    // Monsters spawned after building are found too.
+    monster late_zombie( mtype_id( "mon_zombie" ), tripoint( 62, 62, 0 ) );
+    g->critter_tracker->add( late_zombie );
+    CHECK( threat_map.monsters_near( { 60, 60, 0 }, 6 ) == full_scan( { 60, 60, 0 }, 6 ) );
+
+    // So are monsters that moved into range, and monsters that died are not.
+    g->zombie( 0 ).setpos( { 59, 58, 0 } );
+    CHECK( threat_map.monsters_near( { 60, 60, 0 }, 6 ) == full_scan( { 60, 60, 0 }, 6 ) );
+    g->zombie( 1 ).setpos( { 58, 63, 0 } );
+    g->remove_zombie( 0 );
+    const std::vector<size_t> after_removal = threat_map.monsters_near( { 60, 60, 0 }, 6 );
+    CHECK( after_removal == full_scan( { 60, 60, 0 }, 6 ) );
+    CHECK( after_removal.size() == 4 );
+
+    threat_map.clear();
+    CHECK( threat_map.monsters_near( { 60, 60, 0 }, 60 ) == full_scan( { 60, 60, 0 }, 60 ) );
+
+    while( g->num_zombies() ) {
+        g->remove_zombie( 0 );
+    }
+}
@@ -1,6 +1,12 @@
 #include "catch/catch.hpp"
 
+#include "line.h"
 #include "overmap.h"
+#include "overmapbuffer.h"
+#include "rng.h"
+
+#include <algorithm>
+#include <vector>
 
 TEST_CASE( "set_and_get_overmap_scents" ) {
     overmap test_overmap;
@@ -19,3 +25,56 @@ TEST_CASE( "set_and_get_overmap_scents" ) {
     REQUIRE( test_overmap.scent_at( { 75, 85, 0} ).creation_turn == 50 );
     REQUIRE( test_overmap.scent_at( { 75, 85, 0} ).initial_strength == 90 );
 }
+
+TEST_CASE( "indexed_terrain_search_matches_scan" ) {
+    const tripoint origin( 20, 30, 0 );
+    const int radius = 40;
+    for( const std::string type : { "house", "road", "field", "s_gas" } ) {
+        std::vector<tripoint> expected;
+        int closest = radius + 1;
+        for( int x = origin.x - radius; x <= origin.x + radius; x++ ) {
+            for( int y = origin.y - radius; y <= origin.y + radius; y++ ) {
+                if( overmap_buffer.check_ot_type( type, x, y, origin.z ) ) {
+                    expected.push_back( tripoint( x, y, origin.z ) );
+                    closest = std::min( closest, square_dist( origin.x, origin.y, x, y ) );
+                }
+            }
+        }
+        INFO( "type: " << type );
+        CHECK( overmap_buffer.find_all( origin, type, radius, false ) == expected );
+
+        const tripoint found = overmap_buffer.find_closest( origin, type, radius, false );
+        if( expected.empty() ) {
+            CHECK( found == overmap::invalid_tripoint );
+        } else {
+            REQUIRE( found != overmap::invalid_tripoint );
+            CHECK( overmap_buffer.check_ot_type( type, found.x, found.y, found.z ) );
+            CHECK( square_dist( origin, found ) == closest );
+        }
+    }
+}
+
+TEST_CASE( "pregenerated_overmaps_are_seeded_by_position" ) {
+    // Far away from the overmaps the other tests use.
+    const point center( 40, 40 );
+    overmap_buffer.pregenerate( center, 1 );
+    // These have an even parity, so they are generated in the first wave, without neighbors.
+    for( const point &p : { center, point( 39, 39 ), point( 41, 39 ) } ) {
+        rng_stream stream = overmap::generation_stream( p );
+        const overmap expected( p.x, p.y, stream, overmap_generation_options::from_world(),
+                                nullptr, nullptr, nullptr, nullptr );
+        const overmap &om = overmap_buffer.get( p.x, p.y );
+        int mismatches = 0;
+        for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+            for( int x = 0; x < OMAPX; x++ ) {
+                for( int y = 0; y < OMAPY; y++ ) {
+                    if( om.get_ter( x, y, z ) != expected.get_ter( x, y, z ) ) {
+                        mismatches++;
+                    }
+                }
+            }
+        }
+        INFO( "overmap: " << p.x << "," << p.y );
+        CHECK( mismatches == 0 );
+    }
+}
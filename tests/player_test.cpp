@@ -132,3 +132,30 @@ TEST_CASE("Player body temperatures converge on expected values.") {
         test_temperature_spread( &dummy, {{ -115, -87, -54, -6, 36, 64, 80 }} );
     }
 }
+
+TEST_CASE( "interned_trait_and_bionic_lookups_follow_changes" ) {
+    player &dummy = g->u;
+    const trait_iid trait_hunter( "PRED2" );
+    const bionic_iid bio_mem( "bio_memory" );
+
+    dummy.empty_traits();
+    CHECK_FALSE( dummy.has_trait( trait_hunter ) );
+    dummy.toggle_trait( "PRED2" );
+    CHECK( dummy.has_trait( trait_hunter ) );
+    CHECK( dummy.has_trait( "PRED2" ) );
+    dummy.toggle_trait( "PRED2" );
+    CHECK_FALSE( dummy.has_trait( trait_hunter ) );
+    CHECK_FALSE( dummy.has_trait( "PRED2" ) );
+
+    // Unknown ids never match and are not interned by the string lookups.
+    const size_t known = trait_iid::count();
+    CHECK_FALSE( dummy.has_trait( "not_a_trait" ) );
+    CHECK( trait_iid::count() == known );
+
+    CHECK_FALSE( dummy.has_bionic( bio_mem ) );
+    dummy.add_bionic( "bio_memory" );
+    CHECK( dummy.has_bionic( bio_mem ) );
+    CHECK( dummy.has_bionic( "bio_memory" ) );
+    dummy.remove_bionic( "bio_memory" );
+    CHECK_FALSE( dummy.has_bionic( bio_mem ) );
+}
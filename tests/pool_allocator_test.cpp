@@ -0,0 +1,49 @@
+#include "catch/catch.hpp"
+
+#include "item.h"
+#include "item_stack.h"
+#include "pool_allocator.h"
+
+#include <iterator>
+
+TEST_CASE( "slab_pool_reuses_freed_blocks" )
+{
+    slab_pool pool( 24, 4 );
+    void *const first = pool.allocate();
+    void *const second = pool.allocate();
+    CHECK( first != second );
+    CHECK( pool.allocated() == 2 );
+    CHECK( pool.capacity() == 4 );
+
+    pool.deallocate( first );
+    CHECK( pool.allocated() == 1 );
+    CHECK( pool.allocate() == first );
+
+    // Running out of blocks adds a new slab without moving the old blocks.
+    for( int i = 0; i < 3; i++ ) {
+        pool.allocate();
+    }
+    CHECK( pool.capacity() == 8 );
+    CHECK( pool.allocated() == 5 );
+}
+
+TEST_CASE( "item_list_iterators_stay_valid" )
+{
+    item_list items;
+    items.push_back( item( "rock" ) );
+    items.push_back( item( "stick" ) );
+    const auto stick = std::prev( items.end() );
+    const item *const stick_address = &*stick;
+
+    // Removing and adding other items leaves the iterator valid.
+    items.erase( items.begin() );
+    items.push_front( item( "rock" ) );
+    CHECK( stick->typeId() == "stick" );
+
+    // All lists share one pool, so nodes can move between them.
+    item_list other;
+    other.splice( other.end(), items, stick );
+    CHECK( items.size() == 1 );
+    REQUIRE( other.size() == 1 );
+    CHECK( &other.front() == stick_address );
+}
@@ -0,0 +1,164 @@
+#include "catch/catch.hpp"
+
+#include "crafting.h"
+#include "game.h"
+#include "inventory.h"
+#include "item.h"
+#include "npc.h"
+#include "player.h"
+#include "recipe_dictionary.h"
+#include "skill.h"
+
+#include <climits>
+#include <string>
+#include <vector>
+
+static void check_against_scan( recipe_availability &availability, const inventory &inv )
+{
+    const std::vector<npc *> helpers;
+    for( const auto &e : recipe_dict ) {
+        const recipe &r = e.second;
+        int expected = 0;
+        while( expected < recipe_availability::max_batch &&
+               r.can_make_with_inventory( inv, helpers, expected + 1 ) ) {
+            expected++;
+        }
+        INFO( r.ident() );
+        CHECK( availability.max_batch_size( r, inv, helpers ) == expected );
+    }
+}
+
+static bool uses( const recipe &r, const std::string &id )
+{
+    for( const auto &opts : r.requirements().get_components() ) {
+        for( const item_comp &comp : opts ) {
+            if( comp.type == id ) {
+                return true;
+            }
+        }
+    }
+    for( const auto &opts : r.requirements().get_tools() ) {
+        for( const tool_comp &tool : opts ) {
+            if( tool.type == id ) {
+                return true;
+            }
+        }
+    }
+    for( const auto &opts : r.requirements().get_qualities() ) {
+        for( const quality_requirement &qual : opts ) {
+            if( item( id ).get_quality( qual.type ) != INT_MIN ) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+TEST_CASE( "recipe_availability_only_rechecks_affected_recipes" )
+{
+    const auto learned = g->u.learned_recipes;
+    for( const auto &e : recipe_dict ) {
+        g->u.learn_recipe( &e.second );
+    }
+    recipe_availability &availability = recipe_availability::get_instance();
+    availability.clear();
+
+    inventory inv;
+    inv.add_item( item( "hammer" ), false, false );
+    inv.add_item( item( "pot" ), false, false );
+    inv.add_item( item( "knife_butcher" ), false, false );
+    inv.add_item( item( "stick" ), false, false );
+    inv.add_item( item( "rag" ), false, false );
+    inv.add_item( item( "nail", 0, 40 ), false, false );
+    inv.build_index();
+    check_against_scan( availability, inv );
+
+    // Nothing changed, nothing is checked again.
+    const std::vector<npc *> helpers;
+    const size_t before = availability.evaluations();
+    for( const auto &e : recipe_dict ) {
+        availability.max_batch_size( e.second, inv, helpers );
+    }
+    CHECK( availability.evaluations() == before );
+
+    // Adding rocks only affects recipes that use rocks or a quality they provide.
+    inventory more = inv;
+    for( int i = 0; i < 5; i++ ) {
+        more.add_item( item( "rock" ), false, false );
+    }
+    more.build_index();
+    size_t affected = 0;
+    for( const auto &e : recipe_dict ) {
+        affected += uses( e.second, "rock" ) ? 1 : 0;
+    }
+    check_against_scan( availability, more );
+    CHECK( availability.evaluations() - before <= affected );
+    CHECK( affected < recipe_dict.size() );
+
+    g->u.learned_recipes = learned;
+    availability.clear();
+}
+
+TEST_CASE( "recipe_availability_notices_learned_recipes_and_skills" )
+{
+    const auto learned = g->u.learned_recipes;
+    g->u.learned_recipes.clear();
+    std::map<skill_id, int> levels;
+    for( const Skill &sk : Skill::skills ) {
+        levels[sk.ident()] = g->u.get_skill_level( sk.ident() );
+        g->u.set_skill_level( sk.ident(), 0 );
+    }
+    recipe_availability &availability = recipe_availability::get_instance();
+    availability.clear();
+
+    inventory inv;
+    inv.add_item( item( "hammer" ), false, false );
+    inv.add_item( item( "pot" ), false, false );
+    inv.add_item( item( "knife_butcher" ), false, false );
+    inv.add_item( item( "stick" ), false, false );
+    inv.add_item( item( "rag" ), false, false );
+    inv.add_item( item( "nail", 0, 40 ), false, false );
+    inv.build_index();
+    const std::vector<npc *> helpers;
+
+    // Recipes the inventory suffices for, but which are not known yet.
+    const recipe *unknown = nullptr;
+    const recipe *autolearned = nullptr;
+    for( const auto &e : recipe_dict ) {
+        const recipe &r = e.second;
+        if( !r.requirements().can_make_with_inventory( inv ) || g->u.knows_recipe( &r ) ||
+            g->u.has_recipe( &r, inv, helpers ) != -1 ) {
+            continue;
+        }
+        if( r.autolearn_requirements.empty() ) {
+            unknown = unknown == nullptr ? &r : unknown;
+        } else {
+            autolearned = autolearned == nullptr ? &r : autolearned;
+        }
+    }
+    REQUIRE( unknown != nullptr );
+    REQUIRE( autolearned != nullptr );
+
+    // The crafting inventory and its index stay the same while learning.
+    CHECK( availability.max_batch_size( *unknown, inv, helpers ) == 0 );
+    g->u.learn_recipe( unknown );
+    CHECK( availability.max_batch_size( *unknown, inv, helpers ) > 0 );
+
+    CHECK( availability.max_batch_size( *autolearned, inv, helpers ) == 0 );
+    for( const auto &req : autolearned->autolearn_requirements ) {
+        g->u.set_skill_level( req.first, req.second );
+    }
+    CHECK( availability.max_batch_size( *autolearned, inv, helpers ) > 0 );
+
+    // NPCs check their own recipes.
+    npc guy;
+    CHECK_FALSE( autolearned->can_make_with_inventory( guy, inv, helpers ) );
+    guy.learn_recipe( autolearned );
+    CHECK( autolearned->can_make_with_inventory( guy, inv, helpers ) );
+
+    g->u.learned_recipes = learned;
+    for( const auto &e : levels ) {
+        g->u.set_skill_level( e.first, e.second );
+    }
+    availability.clear();
+}
@@ -0,0 +1,91 @@
+#include "catch/catch.hpp"
+
+#include "enums.h"
+#include "rng.h"
+
+#include <vector>
+
+static std::vector<long> draw( rng_stream stream, int count )
+{
+    std::vector<long> result;
+    for( int i = 0; i < count; i++ ) {
+        result.push_back( stream.rng( 0, 1000000 ) );
+    }
+    return result;
+}
+
+TEST_CASE( "rng_stream_is_deterministic", "[rng]" ) {
+    CHECK( draw( rng_stream( 42 ), 100 ) == draw( rng_stream( 42 ), 100 ) );
+    CHECK( draw( rng_stream( 42 ), 100 ) != draw( rng_stream( 43 ), 100 ) );
+}
+
+TEST_CASE( "derived_streams_ignore_parent_position", "[rng]" ) {
+    rng_stream parent( 1234 );
+    const rng_stream fresh_child = parent.derive( tripoint( 10, -3, 0 ) );
+    for( int i = 0; i < 50; i++ ) {
+        parent();
+    }
+    CHECK( draw( parent.derive( tripoint( 10, -3, 0 ) ), 100 ) == draw( fresh_child, 100 ) );
+    CHECK( draw( parent.derive( tripoint( 10, -3, 0 ) ), 100 ) !=
+           draw( parent.derive( tripoint( 10, -3, 1 ) ), 100 ) );
+    CHECK( draw( parent.derive( 7 ), 100 ) != draw( parent.derive( 8 ), 100 ) );
+}
+
+TEST_CASE( "rng_stream_respects_bounds", "[rng]" ) {
+    rng_stream stream( 99 );
+    std::vector<int> hits( 11, 0 );
+    for( int i = 0; i < 11000; i++ ) {
+        const long val = stream.rng( 5, -5 );
+        REQUIRE( val >= -5 );
+        REQUIRE( val <= 5 );
+        hits[val + 5]++;
+    }
+    for( int count : hits ) {
+        CHECK( count > 800 );
+        CHECK( count < 1200 );
+    }
+
+    for( int i = 0; i < 1000; i++ ) {
+        const double val = stream.rng_float( 1.5, 2.5 );
+        REQUIRE( val >= 1.5 );
+        REQUIRE( val < 2.5 );
+        CHECK( stream.one_in( 1 ) );
+        CHECK( stream.x_in_y( 3, 3 ) );
+        CHECK_FALSE( stream.x_in_y( 0, 3 ) );
+        CHECK( stream.dice( 2, 1 ) == 2 );
+    }
+}
+
+TEST_CASE( "subsystem_streams_follow_world_seed", "[rng]" ) {
+    rng_set_world_seed( 5 );
+    const std::vector<long> mapgen = draw( rng_root( rng_subsystem::mapgen ), 20 );
+    CHECK( mapgen != draw( rng_root( rng_subsystem::monster_ai ), 20 ) );
+    rng_set_world_seed( 6 );
+    CHECK( mapgen != draw( rng_root( rng_subsystem::mapgen ), 20 ) );
+    rng_set_world_seed( 5 );
+    CHECK( mapgen == draw( rng_root( rng_subsystem::mapgen ), 20 ) );
+}
+
+TEST_CASE( "subsystem_streams_stay_separate", "[rng]" ) {
+    rng_set_world_seed( 5 );
+    const rng_stream &mapgen = rng_root( rng_subsystem::mapgen );
+    const rng_stream &overmap = rng_root( rng_subsystem::overmap );
+    CHECK( draw( mapgen.derive( tripoint( 1, 0, 0 ) ), 20 ) !=
+           draw( overmap.derive( tripoint( 0, 0, 0 ) ), 20 ) );
+
+    // Roots and children of all subsystems, no two of them may be the same stream.
+    std::vector<std::vector<long>> streams;
+    for( int sys = 0; sys < static_cast<int>( rng_subsystem::num_subsystems ); sys++ ) {
+        const rng_stream &root = rng_root( static_cast<rng_subsystem>( sys ) );
+        streams.push_back( draw( root, 20 ) );
+        for( int key = 0; key < 4; key++ ) {
+            streams.push_back( draw( root.derive( key ), 20 ) );
+            streams.push_back( draw( root.derive( tripoint( key, 1, -1 ) ), 20 ) );
+        }
+    }
+    for( size_t i = 0; i < streams.size(); i++ ) {
+        for( size_t j = i + 1; j < streams.size(); j++ ) {
+            CHECK( streams[i] != streams[j] );
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#include "catch/catch.hpp"
+
+#include "game.h"
+#include "item.h"
+#include "map.h"
+#include "mapdata.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+typedef std::vector<std::pair<std::string, long>> tile_contents;
+
+static void clear_area( const tripoint &center )
+{
+    for( int dx = -2; dx <= 2; dx++ ) {
+        for( int dy = -2; dy <= 2; dy++ ) {
+            const tripoint p = center + tripoint( dx, dy, 0 );
+            g->m.furn_set( p, f_null );
+            g->m.ter_set( p, t_floor );
+            g->m.i_clear( p );
+        }
+    }
+}
+
+static std::vector<tile_contents> area_contents( const tripoint &center )
+{
+    std::vector<tile_contents> res;
+    for( int dx = -2; dx <= 2; dx++ ) {
+        for( int dy = -2; dy <= 2; dy++ ) {
+            tile_contents tile;
+            for( const item &it : g->m.i_at( center + tripoint( dx, dy, 0 ) ) ) {
+                tile.emplace_back( it.typeId(), it.charges );
+            }
+            res.push_back( tile );
+        }
+    }
+    return res;
+}
+
+TEST_CASE( "spawn_items_places_like_adding_items_one_by_one" )
+{
+    // Enough planks to fill the square and spill over, with charges to merge in between.
+    std::vector<item> items;
+    for( int i = 0; i < 900; i++ ) {
+        items.emplace_back( "2x4", 0 );
+        if( i % 100 == 0 ) {
+            items.emplace_back( "nail", 0, 20 );
+            items.emplace_back( "battery", 0, 50 );
+        }
+    }
+
+    const tripoint one_by_one( 30, 30, 0 );
+    const tripoint batch( 42, 30, 0 );
+    clear_area( one_by_one );
+    clear_area( batch );
+
+    for( const item &it : items ) {
+        g->m.add_item_or_charges( one_by_one, it );
+    }
+    const std::vector<item *> placed = g->m.spawn_items( batch, items );
+
+    const std::vector<tile_contents> contents = area_contents( batch );
+    CHECK( contents == area_contents( one_by_one ) );
+    CHECK( std::count_if( contents.begin(), contents.end(), []( const tile_contents & tile ) {
+        return !tile.empty();
+    } ) > 1 );
+    CHECK( placed.size() == items.size() );
+
+    clear_area( one_by_one );
+    clear_area( batch );
+}
@@ -0,0 +1,103 @@
+#include "catch/catch.hpp"
+
+#include "coordinate_conversions.h"
+#include "game.h"
+#include "inventory.h"
+#include "item.h"
+#include "map.h"
+#include "map_selector.h"
+#include "mapbuffer.h"
+#include "mapdata.h"
+#include "submap.h"
+
+#include <memory>
+
+TEST_CASE( "submap_layers_are_allocated_on_first_write" )
+{
+    submap sm;
+    const submap &csm = sm;
+    CHECK( csm.get_items( 3, 3 ).empty() );
+    CHECK( csm.get_field( 3, 3 ).fieldCount() == 0 );
+    CHECK( csm.get_radiation( 3, 3 ) == 0 );
+    sm.set_radiation( 3, 3, 0 );
+    CHECK_FALSE( sm.itm.is_allocated() );
+    CHECK_FALSE( sm.fld.is_allocated() );
+    CHECK_FALSE( sm.rad.is_allocated() );
+
+    sm.get_items( 3, 3 ).push_back( item( "rock" ) );
+    CHECK( sm.itm.is_allocated() );
+    CHECK( csm.get_items( 3, 3 ).size() == 1 );
+    CHECK( csm.get_items( 4, 4 ).empty() );
+    sm.set_radiation( 4, 4, 10 );
+    CHECK( sm.rad.is_allocated() );
+    CHECK( sm.get_radiation( 4, 4 ) == 10 );
+    CHECK_FALSE( sm.fld.is_allocated() );
+}
+
+TEST_CASE( "reading_items_does_not_allocate_them" )
+{
+    // A square of the reality bubble on a submap that has no items at all
+    tripoint pos = tripoint_min;
+    submap *sm = nullptr;
+    const tripoint abs_sub = g->m.get_abs_sub();
+    for( int gx = 0; gx < g->m.getmapsize() && sm == nullptr; gx++ ) {
+        for( int gy = 0; gy < g->m.getmapsize() && sm == nullptr; gy++ ) {
+            submap *const candidate = MAPBUFFER.lookup_submap( abs_sub + tripoint( gx, gy, 0 ) );
+            if( candidate != nullptr && !candidate->itm.is_allocated() ) {
+                sm = candidate;
+                pos = tripoint( gx * SEEX + SEEX / 2, gy * SEEY + SEEY / 2, abs_sub.z );
+            }
+        }
+    }
+    REQUIRE( sm != nullptr );
+
+    const map &here = g->m;
+    CHECK( here.i_at( pos ).empty() );
+    CHECK_FALSE( g->m.has_items( pos ) );
+    map_selector sel( pos, 1, false );
+    CHECK( sel.amount_of( "rock" ) == 0 );
+    inventory inv;
+    inv.form_from_map( pos, 1 );
+    CHECK_FALSE( sm->itm.is_allocated() );
+
+    g->m.add_item( pos, item( "rock" ) );
+    CHECK( sm->itm.is_allocated() );
+    CHECK( here.i_at( pos ).size() == 1 );
+    CHECK( sel.amount_of( "rock" ) == 1 );
+    g->m.i_clear( pos );
+}
+
+TEST_CASE( "submaps_without_layers_are_saved_and_loaded" )
+{
+    // Far away from anything the other tests generate
+    const tripoint om_addr( 5003, 5000, -5 );
+    const tripoint base = omt_to_sm_copy( om_addr );
+    for( int x = 0; x <= 1; x++ ) {
+        for( int y = 0; y <= 1; y++ ) {
+            std::unique_ptr<submap> sm( new submap() );
+            std::uninitialized_fill_n( &sm->ter[0][0], SEEX * SEEY, t_rock );
+            sm->set_ter( 3, 3, t_dirt );
+            REQUIRE( MAPBUFFER.add_submap( base.x + x, base.y + y, base.z, sm ) );
+        }
+    }
+    MAPBUFFER.lookup_submap( base.x + 1, base.y, base.z )->get_items( 5, 5 ).push_back(
+        item( "rock" ) );
+
+    MAPBUFFER.save_quad( om_addr, true );
+
+    submap *const plain = MAPBUFFER.lookup_submap( base );
+    REQUIRE( plain != nullptr );
+    CHECK( plain->get_ter( 3, 3 ) == t_dirt );
+    CHECK( plain->get_ter( 4, 4 ) == t_rock );
+    CHECK_FALSE( plain->itm.is_allocated() );
+    CHECK_FALSE( plain->fld.is_allocated() );
+    CHECK_FALSE( plain->rad.is_allocated() );
+
+    submap *const with_items = MAPBUFFER.lookup_submap( base.x + 1, base.y, base.z );
+    REQUIRE( with_items != nullptr );
+    REQUIRE( with_items->itm.is_allocated() );
+    const submap &items_sm = *with_items;
+    REQUIRE( items_sm.get_items( 5, 5 ).size() == 1 );
+    CHECK( items_sm.get_items( 5, 5 ).front().typeId() == "rock" );
+    CHECK_FALSE( with_items->fld.is_allocated() );
+}
@@ -0,0 +1,33 @@
+#include "catch/catch.hpp"
+
+#include "thread_pool.h"
+
+#include <atomic>
+#include <vector>
+
+TEST_CASE( "parallel_for_calls_each_index_once" )
+{
+    CHECK_FALSE( in_parallel_for() );
+    CHECK( parallel_for_threads() >= 1 );
+
+    std::vector<int> calls( 1000, 0 );
+    std::atomic<int> outside( 0 );
+    parallel_for( calls.size(), [&]( size_t i ) {
+        calls[i]++;
+        if( !in_parallel_for() ) {
+            outside++;
+        }
+    } );
+    CHECK( calls == std::vector<int>( 1000, 1 ) );
+    CHECK( outside == 0 );
+    CHECK_FALSE( in_parallel_for() );
+
+    // Nested calls run on the thread that makes them.
+    std::vector<int> nested( 10, 0 );
+    parallel_for( nested.size(), [&]( size_t i ) {
+        parallel_for( 10, [&]( size_t ) {
+            nested[i]++;
+        } );
+    } );
+    CHECK( nested == std::vector<int>( 10, 10 ) );
+}
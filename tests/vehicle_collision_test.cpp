@@ -0,0 +1,81 @@
+#include "catch/catch.hpp"
+
+#include "game.h"
+#include "map.h"
+#include "mapdata.h"
+#include "monster.h"
+#include "mtype.h"
+#include "vehicle.h"
+
+#include <algorithm>
+#include <vector>
+
+/** What vehicle::collision should find: the first part that hits something. */
+static veh_collision first_part_collision( vehicle &veh, const tripoint &dp )
+{
+    const tripoint pos = veh.global_pos3() + dp;
+    for( const int p : veh.all_parts_at_location( "structure" ) ) {
+        const veh_collision coll = veh.part_collision( p, pos + veh.parts[p].precalc[1], true, false );
+        if( coll.type != veh_coll_nothing ) {
+            return coll;
+        }
+    }
+    return veh_collision();
+}
+
+static void check_collisions_in_all_directions( vehicle &veh )
+{
+    for( int dx = -1; dx <= 1; dx++ ) {
+        for( int dy = -1; dy <= 1; dy++ ) {
+            const tripoint dp( dx, dy, 0 );
+            INFO( "moving by " << dx << "," << dy );
+            const veh_collision expected = first_part_collision( veh, dp );
+            std::vector<veh_collision> colls;
+            CHECK( veh.collision( colls, dp, true ) == ( expected.type != veh_coll_nothing ) );
+            if( !colls.empty() ) {
+                CHECK( colls.front().type == expected.type );
+                CHECK( colls.front().part == expected.part );
+                CHECK( colls.front().target == expected.target );
+            }
+        }
+    }
+}
+
+TEST_CASE( "vehicle_collision_finds_the_first_obstacle", "[vehicle]" )
+{
+    const tripoint origin( 60, 60, 0 );
+    for( int x = -10; x <= 10; x++ ) {
+        for( int y = -10; y <= 10; y++ ) {
+            g->m.furn_set( origin + tripoint( x, y, 0 ), f_null );
+            g->m.ter_set( origin + tripoint( x, y, 0 ), t_pavement );
+        }
+    }
+    vehicle *veh = g->m.add_vehicle( vproto_id( "car" ), origin.x, origin.y, 0, 0, 0 );
+    REQUIRE( veh != nullptr );
+    // Where the parts end up when the car keeps its direction, as when it drives
+    veh->precalc_mounts( 1, veh->face.dir(), veh->pivot_point() );
+    // Just beyond the part furthest east
+    tripoint front = veh->global_pos3();
+    for( const vehicle_part &part : veh->parts ) {
+        front.x = std::max( front.x, veh->global_part_pos3( part ).x + 1 );
+    }
+
+    SECTION( "open ground" ) {
+        check_collisions_in_all_directions( *veh );
+    }
+    SECTION( "a wall" ) {
+        g->m.ter_set( front, t_wall );
+        CHECK( first_part_collision( *veh, tripoint( 1, 0, 0 ) ).type == veh_coll_bashable );
+        check_collisions_in_all_directions( *veh );
+    }
+    SECTION( "a monster" ) {
+        monster zombie( mtype_id( "mon_zombie" ), front );
+        REQUIRE( g->add_zombie( zombie ) );
+        CHECK( first_part_collision( *veh, tripoint( 1, 0, 0 ) ).type == veh_coll_body );
+        check_collisions_in_all_directions( *veh );
+        g->remove_zombie( g->mon_at( front ) );
+    }
+
+    g->m.destroy_vehicle( veh );
+    g->m.ter_set( front, t_pavement );
+}
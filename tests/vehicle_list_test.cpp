@@ -0,0 +1,51 @@
+#include "catch/catch.hpp"
+
+#include "game.h"
+#include "map.h"
+#include "vehicle.h"
+
+static const wrapped_vehicle *find_in_list( const vehicle *veh )
+{
+    for( const auto &w : g->m.get_vehicles() ) {
+        if( w.v == veh ) {
+            return &w;
+        }
+    }
+    return nullptr;
+}
+
+static void check_listed( const vehicle &veh )
+{
+    const wrapped_vehicle *w = find_in_list( &veh );
+    REQUIRE( w != nullptr );
+    CHECK( tripoint( w->x, w->y, w->z ) == veh.global_pos3() );
+    CHECK( w->i == veh.smx );
+    CHECK( w->j == veh.smy );
+    const tripoint part_pos = veh.global_part_pos3( veh.parts[0] );
+    CHECK( g->m.veh_at( part_pos ) == &veh );
+}
+
+TEST_CASE( "vehicle_list_follows_added_moved_and_removed_vehicles", "[vehicle]" )
+{
+    const size_t before = g->m.get_vehicles().size();
+    // The car needs a spot without water or other vehicles, try a few.
+    vehicle *veh = nullptr;
+    for( int i = 0; i < 100 && veh == nullptr; i++ ) {
+        veh = g->m.add_vehicle( vproto_id( "car" ), 30 + ( i % 10 ) * 6, 30 + ( i / 10 ) * 6, 270, 0,
+                                0 );
+    }
+    REQUIRE( veh != nullptr );
+    CHECK( g->m.get_vehicles().size() == before + 1 );
+    check_listed( *veh );
+
+    tripoint pos = veh->global_pos3();
+    // One step stays on the same submap, the second one moves to the next.
+    g->m.displace_vehicle( pos, tripoint( 1, 0, 0 ) );
+    check_listed( *veh );
+    g->m.displace_vehicle( pos, tripoint( 0, SEEY, 0 ) );
+    check_listed( *veh );
+    CHECK( g->m.get_vehicles().size() == before + 1 );
+
+    g->m.destroy_vehicle( veh );
+    CHECK( g->m.get_vehicles().size() == before );
+}
@@ -0,0 +1,78 @@
+#include "catch/catch.hpp"
+
+#include "game.h"
+#include "map.h"
+#include "vehicle.h"
+#include "veh_type.h"
+
+#include <string>
+#include <vector>
+
+static int scan_part_at( const vehicle &veh, const point &p )
+{
+    for( size_t i = 0; i < veh.parts.size(); i++ ) {
+        if( !veh.parts[i].removed && veh.parts[i].precalc[0] == p ) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void check_index( const vehicle &veh )
+{
+    for( const vehicle_part &vp : veh.parts ) {
+        const point &p = vp.precalc[0];
+        CHECK( veh.part_at( p.x, p.y ) == scan_part_at( veh, p ) );
+    }
+    for( const vpart_bitflags f : { VPFLAG_WHEEL, VPFLAG_ENGINE, VPFLAG_FUEL_TANK, VPFLAG_SEATBELT } ) {
+        std::vector<int> all;
+        std::vector<int> unbroken;
+        for( size_t i = 0; i < veh.parts.size(); i++ ) {
+            if( !veh.parts[i].removed && veh.part_info( i ).has_flag( f ) ) {
+                all.push_back( i );
+                if( !veh.parts[i].is_broken() ) {
+                    unbroken.push_back( i );
+                }
+            }
+        }
+        CHECK( veh.all_parts_with_feature( f, false ) == all );
+        CHECK( veh.all_parts_with_feature( f ) == unbroken );
+    }
+    for( const std::string location : {
+             "", "structure", "engine_block", "fuel_source"
+         } ) {
+        std::vector<int> at_location;
+        for( size_t i = 0; i < veh.parts.size(); i++ ) {
+            if( !veh.parts[i].removed && veh.part_info( i ).location == location ) {
+                at_location.push_back( i );
+            }
+        }
+        CHECK( veh.all_parts_at_location( location ) == at_location );
+    }
+}
+
+TEST_CASE( "vehicle_part_index_matches_a_scan_of_the_parts", "[vehicle]" )
+{
+    vehicle *veh = nullptr;
+    for( int i = 0; i < 100 && veh == nullptr; i++ ) {
+        veh = g->m.add_vehicle( vproto_id( "car" ), 30 + ( i % 10 ) * 6, 30 + ( i / 10 ) * 6, 270, 0,
+                                0 );
+    }
+    REQUIRE( veh != nullptr );
+    check_index( *veh );
+
+    // A seat takes its seatbelt with it, a wheel leaves the rest of its square.
+    const std::vector<int> seats = veh->all_parts_with_feature( "SEAT", false );
+    REQUIRE_FALSE( seats.empty() );
+    veh->remove_part( seats.front() );
+    const std::vector<int> wheels = veh->all_parts_with_feature( VPFLAG_WHEEL, false );
+    REQUIRE_FALSE( wheels.empty() );
+    veh->remove_part( wheels.front() );
+    check_index( *veh );
+
+    tripoint pos = veh->global_pos3();
+    g->m.displace_vehicle( pos, tripoint( 1, 1, 0 ) );
+    check_index( *veh );
+
+    g->m.destroy_vehicle( veh );
+}
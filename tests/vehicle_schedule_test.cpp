@@ -0,0 +1,47 @@
+#include "catch/catch.hpp"
+
+#include "game.h"
+#include "map.h"
+#include "mapdata.h"
+#include "vehicle.h"
+
+static vehicle *add_moving_car( const tripoint &pos )
+{
+    vehicle *veh = g->m.add_vehicle( vproto_id( "car" ), pos.x, pos.y, 0, 0, 0 );
+    REQUIRE( veh != nullptr );
+    veh->velocity = 1000;
+    veh->of_turn = 3;
+    return veh;
+}
+
+TEST_CASE( "vehicles_destroyed_during_the_turn_leave_the_schedule", "[vehicle]" )
+{
+    const tripoint origin( 60, 60, 0 );
+    for( int x = -10; x <= 30; x++ ) {
+        for( int y = -10; y <= 30; y++ ) {
+            g->m.furn_set( origin + tripoint( x, y, 0 ), f_null );
+            g->m.ter_set( origin + tripoint( x, y, 0 ), t_pavement );
+        }
+    }
+    vehicle *first = add_moving_car( origin );
+    vehicle *second = add_moving_car( origin + tripoint( 0, 12, 0 ) );
+
+    REQUIRE( g->m.vehproceed() );
+    g->m.destroy_vehicle( second );
+    // Likely gets the address of the destroyed car, it must not inherit its schedule.
+    vehicle *added = add_moving_car( origin + tripoint( 0, 12, 0 ) );
+    const tripoint added_pos = added->global_pos3();
+    for( int count = 0; count < 100; count++ ) {
+        if( !g->m.vehproceed() ) {
+            break;
+        }
+    }
+    CHECK( added->global_pos3() == added_pos );
+    CHECK( added->of_turn == 3 );
+    CHECK( first->global_pos3() != origin );
+
+    g->m.destroy_vehicle( first );
+    g->m.destroy_vehicle( added );
+    // Drops the schedule, as the end of a turn does.
+    g->m.vehmove();
+}
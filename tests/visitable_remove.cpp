@@ -57,7 +57,15 @@ TEST_CASE( "visitable_remove", "[visitable]" ) {
     auto tiles = closest_tripoints_first( 1, p.pos() );
     tiles.erase( tiles.begin() ); // player tile
     tripoint veh = random_entry( tiles );
-    REQUIRE( g->m.add_vehicle( vproto_id( "shopping_cart" ), veh, 0 ) );
+    // Undamaged, so its cargo part always works
+    vehicle *cart = g->m.add_vehicle( vproto_id( "shopping_cart" ), veh, 0, 0, 0 );
+    REQUIRE( cart != nullptr );
+    // Without the trash it sometimes spawns with, which can include bottles
+    for( size_t part = 0; part < cart->parts.size(); part++ ) {
+        while( !cart->get_items( part ).empty() ) {
+            cart->remove_item( part, 0 );
+        }
+    }
 
     item temp_liquid( liquid_id );
     item obj = temp_liquid.in_container( temp_liquid.type->default_container );